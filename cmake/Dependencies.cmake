@@ -12,6 +12,10 @@ if (NOT TARGET raylib)
 			GIT_SHALLOW 1
 	)
 	FetchContent_MakeAvailable(raylib)
+
+	# The main loop swaps and polls input itself, so input can be sampled after the frame pacer's wait instead of at the previous present
+	target_compile_definitions(raylib PRIVATE SUPPORT_CUSTOM_FRAME_CONTROL=1)
+	set(MISTRAL_CUSTOM_FRAME_CONTROL ON)
 endif ()
 
 # imgui
@@ -50,6 +54,9 @@ add_library(raylib_imgui STATIC ${raylib_imgui_SOURCE_DIR}/rlImGui.cpp)
 target_include_directories(raylib_imgui PUBLIC ${raylib_imgui_SOURCE_DIR})
 target_link_libraries(raylib_imgui PUBLIC imgui raylib)
 
+# Threads for the job system
+find_package(Threads REQUIRED)
+
 # Get .clang-format from Coding-Style repo
 set(STYLE_URL "https://raw.githubusercontent.com/WindmillStudios/Coding-Style/refs/heads/main/.clang-format")
 set(LOCAL_STYLE_FILE "${CMAKE_CURRENT_LIST_DIR}/../.clang-format") # Find an alternative for relative path
@@ -58,8 +65,14 @@ message_color(${BoldYellow} "Downloading .clang-format")
 
 # Link the libraries into the engine
 message_color(${BoldYellow} "Linking libraries intro ${PROJECT_NAME}")
-target_link_libraries(${PROJECT_NAME} PUBLIC raylib raylib_imgui)
+target_link_libraries(${PROJECT_NAME} PUBLIC raylib raylib_imgui Threads::Threads)
 target_compile_definitions(${PROJECT_NAME} PRIVATE IMGUI_USER_CONFIG="ImGuiConfigCustom.h")
+if (MISTRAL_CUSTOM_FRAME_CONTROL)
+	target_compile_definitions(${PROJECT_NAME} PRIVATE MISTRAL_CUSTOM_FRAME_CONTROL)
+endif ()
+
+# raylib sources for external/glad.h, used by the GPU timer queries
+target_include_directories(${PROJECT_NAME} PRIVATE $<TARGET_PROPERTY:raylib,SOURCE_DIR>)
 
 # Hide external dependencies
 set_target_properties(raylib PROPERTIES FOLDER "Dependencies")
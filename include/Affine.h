@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ostream>
+
+#include "raylib.h"
+
+struct Vec3;
+struct Quat;
+struct Matrix4x4;
+
+// Affine transform stored as the top three rows of a column-major Matrix4x4, the implied last row being (0, 0, 0, 1). Fields keep the
+// Matrix4x4 names so code reading them works with either type, m12, m13 and m14 being the translation.
+struct Affine3x4
+{
+	float m0 = 0.f;
+	float m1 = 0.f;
+	float m2 = 0.f;
+	float m4 = 0.f;
+	float m5 = 0.f;
+	float m6 = 0.f;
+	float m8 = 0.f;
+	float m9 = 0.f;
+	float m10 = 0.f;
+	float m12 = 0.f;
+	float m13 = 0.f;
+	float m14 = 0.f;
+
+	static const Affine3x4 Identity;
+
+	// Default and parametrized constructors
+	Affine3x4() = default;
+
+	Affine3x4(float m0, float m1, float m2, float m4, float m5, float m6, float m8, float m9, float m10, float m12, float m13, float m14);
+
+	// Copy constructors
+	Affine3x4(const Affine3x4& affine) = default;
+
+	explicit Affine3x4(const Matrix4x4& matrix); // Drops the last row
+
+	explicit Affine3x4(const Matrix& matrix); // Raylib's Matrix, drops the last row
+
+	// Conversion operators
+	[[nodiscard]] operator Matrix4x4() const;
+
+	[[nodiscard]] operator Matrix() const; // Raylib's Matrix
+
+	// Binary operators
+	[[nodiscard]] friend constexpr bool operator==(const Affine3x4& leftOperand, const Affine3x4& rightOperand) noexcept = default;
+
+	friend std::ostream& operator<<(std::ostream& stream, const Affine3x4& affine)
+	{
+		stream << "Affine3x4(\n";
+		stream << "  " << affine.m0 << ", " << affine.m1 << ", " << affine.m2 << ",\n";
+		stream << "  " << affine.m4 << ", " << affine.m5 << ", " << affine.m6 << ",\n";
+		stream << "  " << affine.m8 << ", " << affine.m9 << ", " << affine.m10 << ",\n";
+		stream << "  " << affine.m12 << ", " << affine.m13 << ", " << affine.m14 << "\n";
+		stream << ")";
+		return stream;
+	}
+
+	// Compound assignment operators
+	Affine3x4& operator*=(const Affine3x4& affine) noexcept;
+
+	// Functionalities
+	[[nodiscard]] Affine3x4 Inverted() const;
+
+	[[nodiscard]] float Determinant() const;
+
+	[[nodiscard]] Vec3 TransformPoint(const Vec3& point) const;
+
+	[[nodiscard]] Vec3 TransformVector(const Vec3& vector) const;
+
+	[[nodiscard]] Vec3 GetPosition() const;
+
+	[[nodiscard]] Quat GetRotation() const;
+
+	[[nodiscard]] Vec3 GetScale() const;
+
+	// Rows as three vec4, the layout shaders expect for a float3x4 or mat4x3 uniform
+	void ToRows(float rows[12]) const;
+
+	// Static constructors
+	[[nodiscard]] static Affine3x4 FromPRS(const Vec3& position, const Quat& rotation, const Vec3& scale);
+};
+
+// Arithmetic operators, 36 multiplications instead of the 64 of Matrix4x4
+[[nodiscard]] Affine3x4 operator*(const Affine3x4& leftOperand, const Affine3x4& rightOperand) noexcept;
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ranges>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Affine.h"
+#include "Packed.h"
+#include "Quaternion.h"
+#include "raylib.h"
+#include "Vector.h"
+
+namespace Mistral
+{
+	// Bone hierarchy of a model, parents come before their children as raylib's loaders guarantee
+	struct Skeleton
+	{
+		std::vector<int32_t> parents;
+		std::vector<Vec3> bindPositions; // Local bind pose
+		std::vector<Quat> bindRotations;
+		std::vector<Vec3> bindScales;
+		std::vector<Affine3x4> inverseBindTransforms; // Model space to bone space
+
+		[[nodiscard]] uint32_t GetBoneCount() const;
+	};
+
+	[[nodiscard]] Skeleton LoadSkeleton(const Model& model);
+
+	// Local bone transforms stored as structure of arrays, blending goes through 4 bones per instruction
+	struct Pose
+	{
+		std::vector<float> positionX;
+		std::vector<float> positionY;
+		std::vector<float> positionZ;
+		std::vector<float> rotationX;
+		std::vector<float> rotationY;
+		std::vector<float> rotationZ;
+		std::vector<float> rotationW;
+		std::vector<float> scaleX;
+		std::vector<float> scaleY;
+		std::vector<float> scaleZ;
+
+		void Resize(uint32_t boneCount);
+
+		void SetBindPose(const Skeleton& skeleton);
+
+		void SetBone(uint32_t bone, const Vec3& position, const Quat& rotation, const Vec3& scale);
+
+		[[nodiscard]] Vec3 GetPosition(uint32_t bone) const;
+
+		[[nodiscard]] Quat GetRotation(uint32_t bone) const;
+
+		[[nodiscard]] Vec3 GetScale(uint32_t bone) const;
+
+		[[nodiscard]] uint32_t GetBoneCount() const;
+	};
+
+	// Largest error allowed when dropping keyframes that interpolating their neighbours reproduces
+	struct AnimationCompression
+	{
+		float rotationTolerance = .001f; // Radians
+		float positionTolerance = .0005f;
+		float scaleTolerance = .0005f;
+	};
+
+	// Keyframes are reduced per bone and channel then quantized, rotations to 48 bits on their three smallest components, positions and
+	// scales to 16 bits within the range of their track
+	class AnimationClip
+	{
+	  public:
+
+		AnimationClip() = default;
+
+		// Raylib's animation frames are in model space, they're brought back to local space with the skeleton hierarchy
+		AnimationClip(const ModelAnimation& animation, const Skeleton& skeleton, float frameRate = 60.f, const AnimationCompression& compression = {});
+
+		// Getters
+		[[nodiscard]] const std::string& GetName() const;
+
+		[[nodiscard]] float GetDuration() const;
+
+		[[nodiscard]] float GetFrameRate() const;
+
+		[[nodiscard]] uint32_t GetFrameCount() const;
+
+		[[nodiscard]] uint32_t GetBoneCount() const;
+
+		[[nodiscard]] size_t GetKeyCount() const;
+
+		[[nodiscard]] size_t GetMemorySize() const;
+
+		// Functionalities
+		void Sample(float time, Pose& pose, bool loop = true) const;
+
+	  private:
+
+		struct RotationKey
+		{
+			uint16_t frame;
+			PackedQuat48 rotation;
+		};
+
+		struct VectorKey
+		{
+			uint16_t frame;
+			uint16_t values[3];
+		};
+
+		struct Track
+		{
+			uint32_t firstKey = 0;
+			uint32_t keyCount = 0;
+			Vec3 minimum = Vec3::Zero; // Quantization range, unused by rotations
+			Vec3 extent = Vec3::Zero;
+		};
+
+		std::string mName;
+		float mFrameRate = 60.f;
+		uint32_t mFrameCount = 0;
+		uint32_t mBoneCount = 0;
+		std::vector<Track> mPositionTracks;
+		std::vector<Track> mRotationTracks;
+		std::vector<Track> mScaleTracks;
+		std::vector<VectorKey> mPositionKeys;
+		std::vector<RotationKey> mRotationKeys;
+		std::vector<VectorKey> mScaleKeys;
+	};
+
+	// Positions and scales are interpolated linearly, rotations take the shortest path and are renormalized. Result may alias either input.
+	void BlendPoses(const Pose& from, const Pose& to, float weight, Pose& result);
+
+	// One weight per bone, for masked layers
+	void BlendPoses(const Pose& from, const Pose& to, std::span<const float> weights, Pose& result);
+
+	// Local to model space, parents first
+	void ComputeModelTransforms(const Skeleton& skeleton, const Pose& pose, std::span<Affine3x4> modelTransforms);
+
+	// Model transforms relative to the bind pose, what raylib expects in Mesh::boneMatrices
+	void ComputeSkinningMatrices(const Skeleton& skeleton, std::span<const Affine3x4> modelTransforms, std::span<Matrix> skinningMatrices);
+
+	// Clips placed along a parameter, the two around it are blended and play in sync on normalized time
+	struct AnimationBlend1D
+	{
+		std::vector<const AnimationClip*> clips;
+		std::vector<float> thresholds; // Increasing, one per clip
+		float parameter = 0.f;
+	};
+
+	struct AnimationLayer
+	{
+		AnimationBlend1D blend;
+		float weight = 1.f;
+		float speed = 1.f;
+		float phase = 0.f; // Normalized playback time
+		bool loop = true;
+		std::vector<float> boneMask; // Weight multiplier per bone, empty to affect every bone
+	};
+
+	// Layers are applied in order over the bind pose, each one overriding the result below it by its weight
+	struct Animator
+	{
+		const Skeleton* skeleton = nullptr;
+		std::vector<AnimationLayer> layers;
+		Model* model = nullptr; // Receives the skinning matrices after every update, optional
+
+		// Results of the last update
+		Pose pose;
+		std::vector<Affine3x4> modelTransforms;
+		std::vector<Matrix> skinningMatrices;
+	};
+
+	uint32_t AddAnimator(const Animator& animator);
+
+	void RemoveAnimator(uint32_t animatorId);
+
+	[[nodiscard]] Animator& GetAnimator(uint32_t animatorId);
+
+	std::ranges::values_view<std::ranges::ref_view<std::map<uint32_t, Animator>>> GetAnimatorsView();
+
+	[[nodiscard]] uint32_t GetAnimatorsCount();
+
+	// Advances and evaluates every animator, spread across the workers. Runs once per frame after the update.
+	void UpdateAnimators(float deltaTime);
+
+	// Copies the skinning matrices to the meshes of the model, call it right before drawing when several animators share a model
+	void ApplyAnimator(const Animator& animator, Model& model);
+} // namespace Mistral
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ranges>
+#include <vector>
+
+#include "raylib.h"
+
+namespace Mistral
+{
+	class Component;
+
+	struct CameraView
+	{
+		Camera3D camera = {};
+		Rectangle viewport = {0.f, 0.f, 1.f, 1.f}; // Normalized to the target, origin at the top left
+		RenderTexture* target = nullptr;		   // Renders to the screen when null
+		int32_t priority = 0;					   // Higher priorities render later, on top of the lower ones
+		uint32_t cullingMask = 0xFFFFFFFF;		   // Components are drawn when their layer mask shares a bit with it
+		bool clear = true;						   // Otherwise only depth is cleared, for overlays like picture-in-picture
+		Color clearColor = RAYWHITE;
+		bool enabled = true;
+	};
+
+	// Where RenderCameras draws the cameras without a render target, the screen by default. Pipelines rendering the scene offscreen pass
+	// their target and the area of it standing for the screen, which starts at its bottom left texel.
+	struct CameraOutput
+	{
+		RenderTexture* target = nullptr;
+		int width = 0; // Whole target when zero
+		int height = 0;
+		std::function<void(const Camera3D& camera, const Rectangle& viewport)> beginCamera; // Viewport in framebuffer pixels, origin at the bottom left
+	};
+
+	uint32_t AddCamera(const CameraView& view);
+
+	void RemoveCamera(uint32_t cameraId);
+
+	[[nodiscard]] CameraView& GetCamera(uint32_t cameraId);
+
+	std::ranges::values_view<std::ranges::ref_view<std::map<uint32_t, CameraView>>> GetCamerasView();
+
+	[[nodiscard]] uint32_t GetCamerasCount();
+
+	// Renders every enabled camera, cameras with a render target first, then by priority. The components and their bounds are gathered
+	// once per frame and cameras sharing the same view and mask reuse one visible list. Without registered cameras the active camera is
+	// rendered over the whole output like before.
+	void RenderCameras(const CameraOutput& output = {});
+
+	// Enabled camera drawing to the screen with the lowest priority, the one overlays are drawn over. Falls back to any enabled camera and
+	// returns 0 without one, the active camera standing for the scene then.
+	[[nodiscard]] uint32_t GetPrimaryCamera();
+
+	// Camera being rendered by RenderCameras, null outside of it
+	[[nodiscard]] Camera3D* GetRenderingCamera();
+
+	// Components visible from the camera being rendered, null outside of RenderCameras
+	[[nodiscard]] const std::vector<Component*>* GetRenderingCameraComponents();
+} // namespace Mistral
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "IRenderPipeline.h"
+#include "raylib.h"
+
+namespace Mistral
+{
+	// Renders the 3D and 2D passes into a render texture and captures it without stalling: pixels are copied into a ring of pixel buffers
+	// and only read back frames later once their fence signaled, then handed to a worker thread to be written or streamed. ImGui is drawn
+	// on top of the presented image and is never captured. Only core GL 3.3 features are used, so it runs on software drivers like llvmpipe.
+	class CaptureRenderPipeline final : public IRenderPipeline
+	{
+	  public:
+
+		// Called on the worker thread, the image is only valid during the call
+		using FrameCallback = std::function<void(const Image& image, uint64_t frame)>;
+
+		explicit CaptureRenderPipeline(std::filesystem::path outputDirectory = {}, uint32_t readbackBuffers = 3, uint32_t maxQueuedFrames = 8);
+
+		~CaptureRenderPipeline() override;
+
+		void Initialize() override;
+
+		void RenderEvent() override;
+
+		// Setters
+		// Replaces writing PNG files to the output directory
+		void SetFrameCallback(FrameCallback callback);
+
+		void SetContinuousCapture(bool enabled);
+
+		void RequestCapture(uint32_t frameCount = 1);
+
+		// Getters
+		[[nodiscard]] bool IsContinuousCapture() const;
+
+		[[nodiscard]] uint64_t GetCapturedFrameCount() const;
+
+		// Frames skipped because every pixel buffer was in flight or the worker fell behind
+		[[nodiscard]] uint64_t GetDroppedFrameCount() const;
+
+		[[nodiscard]] const RenderTexture& GetRenderTarget() const;
+
+	  private:
+
+		struct Readback
+		{
+			unsigned int buffer = 0;
+			void* fence = nullptr;
+			uint64_t frame = 0;
+			int width = 0;
+			int height = 0;
+		};
+
+		struct CapturedFrame
+		{
+			std::vector<unsigned char> pixels;
+			int width = 0;
+			int height = 0;
+			uint64_t frame = 0;
+		};
+
+		void UpdateTarget();
+
+		void IssueReadback();
+
+		// Collects the readbacks whose fence signaled, or all of them when wait is true
+		void CollectReadbacks(bool wait);
+
+		void ReleaseReadbacks();
+
+		void WorkerLoop();
+
+		void WriteFrame(CapturedFrame& capturedFrame);
+
+		std::filesystem::path mOutputDirectory;
+		uint32_t mMaxQueuedFrames;
+		RenderTexture mTarget = {};
+		std::vector<Readback> mReadbacks;
+		uint32_t mNextReadback = 0;
+		uint64_t mFrame = 0;
+		bool mContinuousCapture = false;
+		uint32_t mRequestedFrames = 0;
+
+		std::thread mWorker;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::deque<CapturedFrame> mQueue;
+		std::vector<std::vector<unsigned char>> mFreePixels;
+		FrameCallback mCallback;
+		bool mStopping = false;
+
+		std::atomic<uint64_t> mCapturedFrames = 0;
+		std::atomic<uint64_t> mDroppedFrames = 0;
+	};
+} // namespace Mistral
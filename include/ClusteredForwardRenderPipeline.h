@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "IRenderPipeline.h"
+#include "raylib.h"
+#include "Vector.h"
+
+namespace Mistral
+{
+	// Forward pipeline that bins the registered point lights into a view-space froxel grid every frame. Lit shaders call
+	// BindLightingUniforms and include GetLightingShaderCode() so every fragment only loops over the lights of its own cluster.
+	class ClusteredForwardRenderPipeline final : public IRenderPipeline
+	{
+	  public:
+
+		explicit ClusteredForwardRenderPipeline(uint32_t clustersX = 16, uint32_t clustersY = 9, uint32_t clustersZ = 24, float nearPlane = .1f,
+												float farPlane = 1000.f, uint32_t maxLights = 1024, uint32_t maxLightsPerCluster = 128);
+
+		~ClusteredForwardRenderPipeline() override;
+
+		void Initialize() override;
+
+		void RenderEvent() override;
+
+		// Getters
+		[[nodiscard]] uint32_t GetClusterCount() const;
+
+		[[nodiscard]] uint32_t GetVisibleLightCount() const;
+
+		[[nodiscard]] uint32_t GetLightIndexCount() const;
+
+		[[nodiscard]] const Texture& GetClusterTexture() const;
+
+		[[nodiscard]] const Texture& GetLightIndexTexture() const;
+
+		[[nodiscard]] const Texture& GetLightDataTexture() const;
+
+		// Functionalities
+		// Viewport in framebuffer pixels with the origin at the bottom left, the clusters tile it instead of the whole screen
+		void BuildLightGrid(const Camera3D& camera, const Rectangle& viewport);
+
+		void BindLightingUniforms(const Shader& shader) const;
+
+		[[nodiscard]] static const char* GetLightingShaderCode();
+
+	  private:
+
+		void BuildClusterBounds(const Camera3D& camera, float aspect);
+
+		void UploadBuffers();
+
+		uint32_t mClustersX;
+		uint32_t mClustersY;
+		uint32_t mClustersZ;
+		float mNearPlane;
+		float mFarPlane;
+		uint32_t mMaxLights;
+		uint32_t mMaxLightsPerCluster;
+
+		// Cluster bounds in view space, rebuilt when the projection changes
+		std::vector<Vec3> mClusterMin;
+		std::vector<Vec3> mClusterMax;
+		std::vector<float> mSliceDepths;
+		float mBoundsFovY = 0.f;
+		float mBoundsAspect = 0.f;
+		int mBoundsProjection = -1;
+		Rectangle mViewport = {};
+
+		// Per frame light data, view-space positions stored as SoA for the intersection tests
+		std::vector<float> mLightX;
+		std::vector<float> mLightY;
+		std::vector<float> mLightZ;
+		std::vector<float> mLightRange;
+		std::vector<float> mLightData;
+		uint32_t mLightCount = 0;
+
+		std::vector<uint32_t> mClusterCounts;
+		std::vector<uint16_t> mClusterLights;
+		std::vector<float> mClusterGrid;
+		std::vector<float> mLightIndices;
+		uint32_t mLightIndexCount = 0;
+
+		Texture mClusterTexture = {};
+		Texture mLightIndexTexture = {};
+		Texture mLightDataTexture = {};
+	};
+} // namespace Mistral
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <ostream>
+#include <span>
+#include <vector>
 
 #include "raylib.h"
 
@@ -12,9 +16,17 @@ struct Color4;
 
 struct Color3
 {
-	float r = 0.0f;
-	float g = 0.0f;
-	float b = 0.0f;
+	// Named channels alias an array, indexing compiles to a plain offset
+	union
+	{
+		struct
+		{
+			float r;
+			float g;
+			float b;
+		};
+		float components[3] = {};
+	};
 
 	// Default and parametrized constructors
 	Color3() = default;
@@ -38,12 +50,23 @@ struct Color3
 	[[nodiscard]] operator Color() const;
 
 	// Access operators
-	float& operator[](std::size_t index);
+	float& operator[](const std::size_t index)
+	{
+		assert(index < 3);
+		return components[index];
+	}
 
-	float operator[](std::size_t index) const;
+	float operator[](const std::size_t index) const
+	{
+		assert(index < 3);
+		return components[index];
+	}
 
 	// Binary operators
-	[[nodiscard]] friend constexpr bool operator==(const Color3& leftOperand, const Color3& rightOperand) noexcept = default;
+	[[nodiscard]] friend bool operator==(const Color3& leftOperand, const Color3& rightOperand) noexcept
+	{
+		return leftOperand.r == rightOperand.r && leftOperand.g == rightOperand.g && leftOperand.b == rightOperand.b;
+	}
 
 	friend std::ostream& operator<<(std::ostream& stream, const Color3& color)
 	{
@@ -82,6 +105,9 @@ struct Color3
 	[[nodiscard]] Color3 Lerp(const Color3& target, float amount) const;
 
 	// Color functionalities
+	[[nodiscard]] Color3 ToHSV() const; // Hue, saturation and value in r, g and b, hue in [0, 1)
+
+	// Hue wraps around, 0 and 1 are both red
 	[[nodiscard]] static Color3 HSV(float h, float s, float v);
 
 	[[nodiscard]] static Color3 HSV(uint32_t h, uint32_t s, uint32_t v);
@@ -118,12 +144,19 @@ struct Color3
 
 [[nodiscard]] Color3 operator^(float leftOperand, const Color3& rightOperand) noexcept;
 
-struct Color4
+struct alignas(16) Color4
 {
-	float r = 0.0f;
-	float g = 0.0f;
-	float b = 0.0f;
-	float a = 0.0f;
+	union
+	{
+		struct
+		{
+			float r;
+			float g;
+			float b;
+			float a;
+		};
+		float components[4] = {};
+	};
 
 	static const Color4 White;
 	static const Color4 Black;
@@ -172,12 +205,24 @@ struct Color4
 	[[nodiscard]] operator Color() const;
 
 	// Access operators
-	float& operator[](std::size_t index);
+	float& operator[](const std::size_t index)
+	{
+		assert(index < 4);
+		return components[index];
+	}
 
-	float operator[](std::size_t index) const;
+	float operator[](const std::size_t index) const
+	{
+		assert(index < 4);
+		return components[index];
+	}
 
 	// Binary operators
-	[[nodiscard]] friend constexpr bool operator==(const Color4& leftOperand, const Color4& rightOperand) noexcept = default;
+	[[nodiscard]] friend bool operator==(const Color4& leftOperand, const Color4& rightOperand) noexcept
+	{
+		return leftOperand.r == rightOperand.r && leftOperand.g == rightOperand.g && leftOperand.b == rightOperand.b &&
+			   leftOperand.a == rightOperand.a;
+	}
 
 	friend std::ostream& operator<<(std::ostream& stream, const Color4& color)
 	{
@@ -217,6 +262,8 @@ struct Color4
 
 	[[nodiscard]] uint32_t ToUInt32() const;
 
+	[[nodiscard]] Color4 ToHSVA() const;
+
 	// Static constructors
 	[[nodiscard]] static Color4 Grey(float value, float alpha = 1.0f);
 
@@ -256,4 +303,41 @@ struct Color4
 
 [[nodiscard]] Color4 operator/(float leftOperand, const Color4& rightOperand);
 
-[[nodiscard]] Color4 operator^(float leftOperand, const Color4& rightOperand) noexcept;
\ No newline at end of file
+[[nodiscard]] Color4 operator^(float leftOperand, const Color4& rightOperand) noexcept;
+
+// sRGB transfer function on a single channel
+[[nodiscard]] float SRGBToLinear(float value);
+
+[[nodiscard]] float LinearToSRGB(float value);
+
+// Bulk conversions, the shorter span sets the count and alpha is carried over untouched. HSV conversions and sRGB encoding go 4 colors
+// at a time with SSE2. Hue, saturation and value are stored in r, g and b.
+void ConvertHSVToRGB(std::span<const Color3> hsv, std::span<Color3> rgb);
+
+void ConvertHSVToRGB(std::span<const Color4> hsv, std::span<Color4> rgb);
+
+void ConvertRGBToHSV(std::span<const Color3> rgb, std::span<Color3> hsv);
+
+void ConvertRGBToHSV(std::span<const Color4> rgb, std::span<Color4> hsv);
+
+// 8 bits sRGB to linear through a 256 entries table, alpha is only rescaled
+void DecodeSRGB(std::span<const Color> srgb, std::span<Color4> linear);
+
+// Linear to 8 bits sRGB through a piecewise linear table, clamped and within .55 of the exact value before rounding
+void EncodeSRGB(std::span<const Color4> linear, std::span<Color> srgb);
+
+void PremultiplyAlpha(std::span<Color4> colors);
+
+// Colors with no alpha become black
+void UnpremultiplyAlpha(std::span<Color4> colors);
+
+// Rounded to the nearest 8 bits value
+void PremultiplyAlpha(std::span<Color> colors);
+
+// Whole images as loaded by raylib, converted to 8 bits RGBA first when stored in another format. Only the first mipmap level is read or
+// written, float pixels are linear when srgb is set.
+[[nodiscard]] std::vector<Color4> DecodeImage(const Image& image, bool srgb = true);
+
+void EncodeImage(std::span<const Color4> pixels, Image& image, bool srgb = true);
+
+void PremultiplyImageAlpha(Image& image);
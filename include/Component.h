@@ -80,11 +80,22 @@ namespace Mistral
 
 		[[nodiscard]] bool HasChildren() const;
 
+		[[nodiscard]] uint32_t GetLayerMask() const;
+
+		// World-space bounds used for culling, components without bounds are never culled
+		[[nodiscard]] virtual bool GetBounds([[maybe_unused]] BoundingBox& bounds)
+		{
+			return false;
+		}
+
 		// Setters
 		void SetName(const std::string& name);
 
 		void SetParent(Component* parent);
 
+		// Cameras only draw the components sharing a bit with their culling mask
+		void SetLayerMask(uint32_t layerMask);
+
 		template <typename T, typename... Args>
 		T* CreateChild(Args&&... args)
 		{
@@ -139,5 +150,6 @@ namespace Mistral
 		Component* mParent;
 		std::vector<Component*> mChildren;
 		Spatial mSpatial;
+		uint32_t mLayerMask = 1;
 	};
 } // namespace Mistral
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Matrix.h"
+#include "raylib.h"
+#include "Vector.h"
+
+namespace Mistral
+{
+	// Debug primitives are accumulated as lines and drawn at the end of every 3D pass through one dedicated vertex buffer, depth tested
+	// lines first and lines drawn on top second. A duration of zero keeps the primitive for the current frame only. Without
+	// MISTRAL_DEBUG_DRAW, set by the MISTRAL_ENABLE_DEBUG_DRAW CMake option outside of release builds, every function compiles to nothing.
+#if defined(MISTRAL_DEBUG_DRAW)
+	void DebugDrawLine(const Vec3& start, const Vec3& end, Color color, float duration = 0.f, bool depthTest = true);
+
+	// Basis vectors of the transform, scale included, as red, green and blue arrows
+	void DebugDrawAxes(const Matrix4x4& transform, float size = 1.f, float duration = 0.f, bool depthTest = true);
+
+	void DebugDrawBox(const BoundingBox& box, Color color, float duration = 0.f, bool depthTest = true);
+
+	// Unit box from -1 to 1 transformed by the matrix
+	void DebugDrawBox(const Matrix4x4& transform, Color color, float duration = 0.f, bool depthTest = true);
+
+	void DebugDrawSphere(const Vec3& center, float radius, Color color, float duration = 0.f, bool depthTest = true);
+
+	// Draws every pending primitive, called by the engine at the end of each 3D pass
+	void DebugDrawRender();
+
+	// Ages the primitives and removes the expired ones, called by the engine once per frame
+	void DebugDrawEndFrame(float deltaTime);
+
+	void DebugDrawClear();
+
+	void UnloadDebugDraw();
+
+	[[nodiscard]] uint32_t GetDebugDrawLineCount();
+#else
+	inline void DebugDrawLine(const Vec3&, const Vec3&, Color, float = 0.f, bool = true)
+	{
+	}
+
+	inline void DebugDrawAxes(const Matrix4x4&, float = 1.f, float = 0.f, bool = true)
+	{
+	}
+
+	inline void DebugDrawBox(const BoundingBox&, Color, float = 0.f, bool = true)
+	{
+	}
+
+	inline void DebugDrawBox(const Matrix4x4&, Color, float = 0.f, bool = true)
+	{
+	}
+
+	inline void DebugDrawSphere(const Vec3&, float, Color, float = 0.f, bool = true)
+	{
+	}
+
+	inline void DebugDrawRender()
+	{
+	}
+
+	inline void DebugDrawEndFrame(float)
+	{
+	}
+
+	inline void DebugDrawClear()
+	{
+	}
+
+	inline void UnloadDebugDraw()
+	{
+	}
+
+	[[nodiscard]] inline uint32_t GetDebugDrawLineCount()
+	{
+		return 0;
+	}
+#endif
+} // namespace Mistral
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IRenderPipeline.h"
+#include "RenderGraph.h"
 
 namespace Mistral
 {
@@ -13,5 +14,12 @@ namespace Mistral
 		void Initialize() override;
 
 		void RenderEvent() override;
+
+		// Getters
+		[[nodiscard]] const RenderGraph& GetRenderGraph() const;
+
+	  private:
+
+		RenderGraph mRenderGraph;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "raylib.h"
+#include "Vector.h"
+
+namespace Mistral
+{
+	class Component;
+
+	inline constexpr uint32_t BvhNullProxy = std::numeric_limits<uint32_t>::max();
+
+	struct BvhRayHit
+	{
+		uint32_t proxy = BvhNullProxy;
+		void* userData = nullptr;
+		float distance = 0.f;
+	};
+
+	// Incremental AABB tree. Leaves keep the exact bounds for queries and a box fattened by a margin for the tree, so objects moving
+	// inside their fat box don't touch the tree. Insertion descends along the cheapest surface area cost and every modified branch is
+	// then rotated wherever swapping a child with a grandchild shrinks the surface area. Queries are const and may run concurrently.
+	class DynamicBvh
+	{
+	  public:
+
+		explicit DynamicBvh(float margin = .1f);
+
+		// Proxies
+		uint32_t CreateProxy(const BoundingBox& bounds, void* userData);
+
+		void DestroyProxy(uint32_t proxy);
+
+		// Updates the exact bounds, returns true when the leaf left its fat box and was reinserted
+		bool MoveProxy(uint32_t proxy, const BoundingBox& bounds);
+
+		void Clear();
+
+		// Getters
+		[[nodiscard]] void* GetUserData(uint32_t proxy) const;
+
+		[[nodiscard]] const BoundingBox& GetBounds(uint32_t proxy) const;
+
+		[[nodiscard]] const BoundingBox& GetFatBounds(uint32_t proxy) const;
+
+		[[nodiscard]] uint32_t GetProxyCount() const;
+
+		[[nodiscard]] uint32_t GetHeight() const;
+
+		// Sum of the internal node areas over the root area, lower is better
+		[[nodiscard]] float GetAreaRatio() const;
+
+		// Queries, results are appended to the output
+		void QueryBox(const BoundingBox& box, std::vector<void*>& results) const;
+
+		void QuerySphere(const Vec3& center, float radius, std::vector<void*>& results) const;
+
+		// Closest hit against the exact bounds, distances are along the ray direction which doesn't need to be normalized
+		[[nodiscard]] bool Raycast(const Ray& ray, float maxDistance, BvhRayHit& hit) const;
+
+		// Closest proxy to the point, measured to the exact bounds
+		[[nodiscard]] bool FindNearest(const Vec3& point, float maxDistance, BvhRayHit& hit) const;
+
+		// Batch queries, split across the worker threads
+		void RaycastBatch(std::span<const Ray> rays, float maxDistance, std::span<BvhRayHit> hits) const;
+
+		void QuerySphereBatch(std::span<const Vec3> centers, float radius, std::span<std::vector<void*>> results) const;
+
+	  private:
+
+		struct Node
+		{
+			BoundingBox box;   // Fattened for leaves
+			BoundingBox exact; // Leaves only
+			void* userData;
+			uint32_t parent; // Next free node once released
+			uint32_t child1;
+			uint32_t child2;
+			int32_t height; // Zero for leaves, negative for free nodes
+		};
+
+		[[nodiscard]] bool IsLeaf(uint32_t node) const;
+
+		uint32_t AllocateNode();
+
+		void FreeNode(uint32_t node);
+
+		void InsertLeaf(uint32_t leaf);
+
+		void RemoveLeaf(uint32_t leaf);
+
+		// Refits and rotates every node from the given one up to the root
+		void RefitAncestors(uint32_t node);
+
+		void Rotate(uint32_t node);
+
+		float mMargin;
+		uint32_t mRoot = BvhNullProxy;
+		uint32_t mFreeList = BvhNullProxy;
+		uint32_t mProxyCount = 0;
+		std::vector<Node> mNodes;
+	};
+
+	// Engine integration, the index over every component is refreshed by the main loop once per frame, after the transforms are flushed.
+	// Components without bounds are indexed as a point at their world position. Queries only read the index, so they are safe from any
+	// thread between two refreshes; it is empty until the first one and misses components created since the last one.
+	void UpdateComponentBvh();
+
+	// Called as components get destroyed so queries made later in the same frame can't return them
+	void RemoveComponentFromBvh(const Component* component);
+
+	[[nodiscard]] DynamicBvh& GetComponentBvh();
+
+	[[nodiscard]] Component* RaycastComponents(const Ray& ray, float maxDistance, float* distance = nullptr);
+
+	void RaycastComponents(std::span<const Ray> rays, float maxDistance, std::span<Component*> hits);
+
+	void QueryComponents(const BoundingBox& box, std::vector<Component*>& components);
+
+	void QueryComponents(const Vec3& center, float radius, std::vector<Component*>& components);
+
+	[[nodiscard]] Component* FindNearestComponent(const Vec3& point, float maxDistance = std::numeric_limits<float>::max());
+} // namespace Mistral
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "GpuTimer.h"
+#include "IRenderPipeline.h"
+#include "raylib.h"
+
+namespace Mistral
+{
+	// Renders the 3D scene into an offscreen target at a fraction of the window resolution and upscales it before the 2D and ImGui passes.
+	// The fraction is driven by a controller that compares the measured GPU frame time against a budget, so heavy scenes lose sharpness
+	// before they lose frames. CPU time is only reported, lowering the resolution doesn't reduce it.
+	class DynamicResolutionRenderPipeline final : public IRenderPipeline
+	{
+	  public:
+
+		explicit DynamicResolutionRenderPipeline(float targetFrameTime = 1000.f / 60.f, float minScale = .5f, float maxScale = 1.f);
+
+		~DynamicResolutionRenderPipeline() override;
+
+		void Initialize() override;
+
+		void RenderEvent() override;
+
+		// Setters
+		void SetTargetFrameTime(float milliseconds);
+
+		void SetScaleLimits(float minScale, float maxScale);
+
+		void SetDynamicScaling(bool enabled);
+
+		// Only used when dynamic scaling is disabled
+		void SetResolutionScale(float scale);
+
+		// Getters
+		[[nodiscard]] float GetTargetFrameTime() const;
+
+		[[nodiscard]] float GetResolutionScale() const;
+
+		[[nodiscard]] bool IsDynamicScaling() const;
+
+		[[nodiscard]] int GetSceneWidth() const;
+
+		[[nodiscard]] int GetSceneHeight() const;
+
+		// Timings in milliseconds, GPU timings are a few frames old. The CPU time is a statistic, it doesn't drive the scale
+		[[nodiscard]] double GetCpuTime() const;
+
+		[[nodiscard]] double GetGpuTime() const;
+
+		[[nodiscard]] double GetSceneGpuTime() const;
+
+	  private:
+
+		void UpdateTarget();
+
+		void UpdateScale();
+
+		float mTargetFrameTime;
+		float mMinScale;
+		float mMaxScale;
+		float mScale;
+		bool mDynamicScaling = true;
+
+		RenderTexture mTarget = {};
+		int mSceneWidth = 0;
+		int mSceneHeight = 0;
+
+		GpuTimer mFrameTimer;
+		GpuTimer mSceneTimer;
+		double mCpuTime = 0.0;
+		double mSmoothedFrameTime = 0.0;
+	};
+} // namespace Mistral
@@ -0,0 +1,15 @@
+#pragma once
+
+// Approximations for hot loops where the last bits of the exact functions don't matter. The bounds are the largest errors measured
+// against the standard library over the stated input ranges.
+
+// Relative error below 4e-7 with SSE, below 5e-6 otherwise, for any positive normal value
+[[nodiscard]] float FastRsqrt(float value);
+
+// Absolute error below 1e-6 for any angle below 1e9. The reduction loses bits past it, larger angles go through std::sin and std::cos
+[[nodiscard]] float FastSin(float angle);
+
+[[nodiscard]] float FastCos(float angle);
+
+// Absolute error below 3e-6 radians, returns 0 when both arguments are 0
+[[nodiscard]] float FastAtan2(float y, float x);
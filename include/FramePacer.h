@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace Mistral
+{
+	enum class FramePacingMode
+	{
+		Uncapped,	// No vsync and no wait
+		Fixed,		// No vsync, frames start at a fixed rate
+		DisplayRate // Vsync paces the frames at the monitor refresh rate
+	};
+
+	struct FramePacingStats
+	{
+		double frameTime = 0.0;		   // Milliseconds between the last two presents
+		double averageFrameTime = 0.0; // Milliseconds, over the last frames
+		double jitter = 0.0;		   // Standard deviation of the frame time over the last frames, in milliseconds
+		double workTime = 0.0;		   // Milliseconds from the start of the frame to its present
+		double waitTime = 0.0;		   // Milliseconds spent waiting before the frame started
+		uint64_t missedDeadlines = 0;  // Frames presented more than a fifth of a period late
+		uint64_t frames = 0;
+	};
+
+	// Paces the main loop instead of raylib's SetTargetFPS. Waits sleep while the deadline is far and spin for the last fraction of a
+	// millisecond, with the margin adapted to how much the OS oversleeps. In low latency mode the frame start is delayed so the work ends
+	// right before the next present, and as raylib is built with SUPPORT_CUSTOM_FRAME_CONTROL the main loop polls input once that wait is
+	// over. Input is then only as old as the work of the frame. A raylib provided by a parent project without the flag keeps polling at the
+	// previous present, low latency mode only delays the update then.
+	class FramePacer
+	{
+	  public:
+
+		// Setters
+		void SetMode(FramePacingMode mode, float targetFps = 60.f);
+
+		void SetLowLatency(bool enabled);
+
+		// Getters
+		[[nodiscard]] FramePacingMode GetMode() const;
+
+		[[nodiscard]] float GetTargetFps() const;
+
+		[[nodiscard]] bool IsLowLatency() const;
+
+		// Seconds, zero when uncapped
+		[[nodiscard]] double GetTargetPeriod() const;
+
+		[[nodiscard]] const FramePacingStats& GetStats() const;
+
+		// Seconds between the starts of the last two frames. Use it instead of raylib's GetFrameTime, which stays at zero when the main loop
+		// controls the frame
+		[[nodiscard]] float GetFrameTime() const;
+
+		// Functionalities, called by the main loop around every frame
+		void BeginFrame();
+
+		void EndFrame();
+
+	  private:
+
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr uint32_t HistorySize = 120;
+
+		void ApplyVsync();
+
+		void WaitUntil(Clock::time_point deadline);
+
+		[[nodiscard]] double GetPredictedWork() const;
+
+		FramePacingMode mMode = FramePacingMode::DisplayRate;
+		float mTargetFps = 60.f;
+		bool mLowLatency = false;
+		std::optional<bool> mVsync;
+
+		Clock::time_point mFrameStart = {};
+		Clock::time_point mLastFrameStart = {};
+		Clock::time_point mLastPresent = {};
+		float mFrameTime = 0.f; // Seconds
+
+		double mSleepOvershoot = .001; // Seconds
+		double mWorkAverage = 0.0;	   // Seconds
+		double mWorkDeviation = 0.0;   // Seconds
+
+		double mHistory[HistorySize] = {};
+		uint32_t mHistoryCount = 0;
+		uint32_t mHistoryNext = 0;
+		FramePacingStats mStats;
+	};
+
+	[[nodiscard]] FramePacer& GetFramePacer();
+} // namespace Mistral
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "Matrix.h"
+#include "raylib.h"
+#include "Vector.h"
+
+struct Aabb;
+struct Sphere;
+struct Plane;
+struct Ray3;
+struct Obb;
+struct Capsule;
+
+struct Aabb
+{
+	Vec3 min;
+	Vec3 max;
+
+	// Default and parametrized constructors
+	Aabb() = default;
+
+	Aabb(const Vec3& min, const Vec3& max);
+
+	// Copy constructors
+	Aabb(const Aabb& aabb) = default;
+
+	Aabb(const BoundingBox& box); // Raylib's BoundingBox
+
+	// Conversion operators
+	[[nodiscard]] operator BoundingBox() const; // Raylib's BoundingBox
+
+	// Binary operators
+	[[nodiscard]] friend constexpr bool operator==(const Aabb& leftOperand, const Aabb& rightOperand) noexcept = default;
+
+	// Functionalities
+	[[nodiscard]] Vec3 GetCenter() const;
+
+	[[nodiscard]] Vec3 GetExtents() const;
+
+	[[nodiscard]] float GetSurfaceArea() const;
+
+	[[nodiscard]] Aabb Merged(const Aabb& aabb) const;
+
+	[[nodiscard]] Aabb Merged(const Vec3& point) const;
+
+	[[nodiscard]] Vec3 ClosestPoint(const Vec3& point) const;
+
+	[[nodiscard]] bool Contains(const Vec3& point) const;
+
+	[[nodiscard]] bool Intersects(const Aabb& aabb) const;
+
+	[[nodiscard]] bool Intersects(const Sphere& sphere) const;
+
+	// Bounds of the transformed box, built from the extents projected on every axis
+	[[nodiscard]] Aabb Transformed(const Matrix4x4& matrix) const;
+
+	// Static constructors
+	[[nodiscard]] static Aabb FromCenterExtents(const Vec3& center, const Vec3& extents);
+};
+
+struct Sphere
+{
+	Vec3 center;
+	float radius = 0.f;
+
+	// Default and parametrized constructors
+	Sphere() = default;
+
+	Sphere(const Vec3& center, float radius);
+
+	// Functionalities
+	[[nodiscard]] bool Contains(const Vec3& point) const;
+
+	[[nodiscard]] bool Intersects(const Sphere& sphere) const;
+
+	[[nodiscard]] bool Intersects(const Aabb& aabb) const;
+
+	// The radius grows with the largest axis scale, so non-uniform scales give a conservative sphere
+	[[nodiscard]] Sphere Transformed(const Matrix4x4& matrix) const;
+};
+
+// Points p with normal.Dot(p) + distance == 0, the normal points to the positive side
+struct Plane
+{
+	Vec3 normal = Vec3::Up;
+	float distance = 0.f;
+
+	// Default and parametrized constructors
+	Plane() = default;
+
+	Plane(const Vec3& normal, float distance);
+
+	// Functionalities
+	[[nodiscard]] float SignedDistance(const Vec3& point) const;
+
+	[[nodiscard]] Plane Normalized() const;
+
+	// Normals go through the inverse transpose, so the plane stays correct under non-uniform scales
+	[[nodiscard]] Plane Transformed(const Matrix4x4& matrix) const;
+
+	// Static constructors
+	[[nodiscard]] static Plane FromPointNormal(const Vec3& point, const Vec3& normal);
+
+	// Counter clockwise points seen from the positive side
+	[[nodiscard]] static Plane FromPoints(const Vec3& a, const Vec3& b, const Vec3& c);
+};
+
+struct Ray3
+{
+	Vec3 origin;
+	Vec3 direction = Vec3::Forward;
+
+	// Default and parametrized constructors
+	Ray3() = default;
+
+	Ray3(const Vec3& origin, const Vec3& direction);
+
+	// Copy constructors
+	Ray3(const Ray3& ray) = default;
+
+	Ray3(const Ray& ray); // Raylib's Ray
+
+	// Conversion operators
+	[[nodiscard]] operator Ray() const; // Raylib's Ray
+
+	// Functionalities
+	[[nodiscard]] Vec3 GetPoint(float distance) const;
+
+	// Distances are in units of the direction length, the origin inside a volume hits at zero
+	[[nodiscard]] bool Intersects(const Aabb& aabb, float& distance) const;
+
+	[[nodiscard]] bool Intersects(const Sphere& sphere, float& distance) const;
+
+	[[nodiscard]] bool Intersects(const Plane& plane, float& distance) const;
+
+	[[nodiscard]] bool Intersects(const Obb& obb, float& distance) const;
+
+	[[nodiscard]] Ray3 Transformed(const Matrix4x4& matrix) const;
+};
+
+struct Obb
+{
+	Vec3 center;
+	Vec3 extents;
+	Vec3 axes[3] = {Vec3::Right, Vec3::Up, Vec3::Forward}; // Orthonormal
+
+	// Default and parametrized constructors
+	Obb() = default;
+
+	Obb(const Vec3& center, const Vec3& extents, const Vec3& axisX, const Vec3& axisY, const Vec3& axisZ);
+
+	explicit Obb(const Aabb& aabb);
+
+	// Functionalities
+	[[nodiscard]] Vec3 ClosestPoint(const Vec3& point) const;
+
+	[[nodiscard]] bool Contains(const Vec3& point) const;
+
+	[[nodiscard]] bool Intersects(const Obb& obb) const;
+
+	[[nodiscard]] bool Intersects(const Sphere& sphere) const;
+
+	[[nodiscard]] Aabb GetBounds() const;
+
+	// Shears can't be represented, the axes are renormalized
+	[[nodiscard]] Obb Transformed(const Matrix4x4& matrix) const;
+};
+
+// Segment from a to b swept by a sphere
+struct Capsule
+{
+	Vec3 a;
+	Vec3 b;
+	float radius = 0.f;
+
+	// Default and parametrized constructors
+	Capsule() = default;
+
+	Capsule(const Vec3& a, const Vec3& b, float radius);
+
+	// Functionalities
+	[[nodiscard]] Vec3 ClosestPoint(const Vec3& point) const; // On the segment
+
+	[[nodiscard]] bool Contains(const Vec3& point) const;
+
+	[[nodiscard]] bool Intersects(const Sphere& sphere) const;
+
+	[[nodiscard]] bool Intersects(const Capsule& capsule) const;
+
+	[[nodiscard]] Aabb GetBounds() const;
+
+	[[nodiscard]] Capsule Transformed(const Matrix4x4& matrix) const;
+};
+
+// Six inward facing planes: left, right, bottom, top, near and far
+struct Frustum
+{
+	Plane planes[6];
+
+	// Functionalities
+	[[nodiscard]] bool Contains(const Vec3& point) const;
+
+	[[nodiscard]] bool Intersects(const Sphere& sphere) const;
+
+	// Conservative, only tests the corner farthest along each plane normal
+	[[nodiscard]] bool Intersects(const Aabb& aabb) const;
+
+	[[nodiscard]] Frustum Transformed(const Matrix4x4& matrix) const;
+
+	// Static constructors, extracts the normalized planes of a view projection matrix
+	[[nodiscard]] static Frustum FromMatrix(const Matrix4x4& viewProjection);
+};
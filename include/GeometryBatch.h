@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Geometry.h"
+
+// Structure of arrays storage for the batch tests, every component is contiguous so 4 or 8 primitives load in one instruction
+struct AabbBatch
+{
+	std::vector<float> minX;
+	std::vector<float> minY;
+	std::vector<float> minZ;
+	std::vector<float> maxX;
+	std::vector<float> maxY;
+	std::vector<float> maxZ;
+
+	void Add(const Aabb& aabb);
+
+	void Clear();
+
+	void Reserve(std::size_t count);
+
+	[[nodiscard]] std::size_t Size() const;
+};
+
+struct SphereBatch
+{
+	std::vector<float> centerX;
+	std::vector<float> centerY;
+	std::vector<float> centerZ;
+	std::vector<float> radius;
+
+	void Add(const Sphere& sphere);
+
+	void Clear();
+
+	void Reserve(std::size_t count);
+
+	[[nodiscard]] std::size_t Size() const;
+};
+
+// Batch tests, 8 wide with AVX, 4 wide with SSE and scalar otherwise. Culling appends the indices of the visible primitives in increasing
+// order, with the same conservative box test as Frustum::Intersects.
+void CullSpheres(const Frustum& frustum, const SphereBatch& spheres, std::vector<uint32_t>& visible);
+
+void CullAabbs(const Frustum& frustum, const AabbBatch& aabbs, std::vector<uint32_t>& visible);
+
+// Entry distance of the ray in every box, negative when it misses within maxDistance
+void IntersectRay(const Ray3& ray, const AabbBatch& aabbs, float maxDistance, std::span<float> distances);
+
+// Index of the closest box hit within maxDistance, -1 when nothing is hit
+[[nodiscard]] int32_t RaycastClosest(const Ray3& ray, const AabbBatch& aabbs, float maxDistance, float* distance = nullptr);
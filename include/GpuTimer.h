@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Mistral
+{
+	// Measures the GPU time spent between Begin and End with timestamp queries. Results are read back a few frames later so the CPU never
+	// waits on the GPU, the value returned by GetMilliseconds therefore lags the frame it was measured on.
+	class GpuTimer
+	{
+	  public:
+
+		GpuTimer() = default;
+
+		~GpuTimer();
+
+		GpuTimer(const GpuTimer&) = delete;
+
+		GpuTimer& operator=(const GpuTimer&) = delete;
+
+		// Both flush the pending rlgl batch so the queries bracket the draws issued in between
+		void Begin();
+
+		void End();
+
+		// Getters
+		[[nodiscard]] double GetMilliseconds() const;
+
+	  private:
+
+		static constexpr uint32_t FramesInFlight = 4;
+
+		unsigned int mQueries[FramesInFlight][2] = {};
+		bool mPending[FramesInFlight] = {};
+		uint32_t mFrame = 0;
+		bool mCreated = false;
+		double mMilliseconds = 0.0;
+	};
+} // namespace Mistral
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Mistral
+{
+	// Splits [0, count) in chunks of chunkSize and runs them on the worker threads. The calling thread also takes chunks and the function
+	// returns once every chunk has finished. Calls made from inside a job run serially on the current thread.
+	void ParallelFor(uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t begin, uint32_t end)>& job);
+
+	// Number of threads taking part in a ParallelFor, the calling thread included
+	[[nodiscard]] uint32_t GetWorkerCount();
+
+	void SetWorkerCount(uint32_t count);
+} // namespace Mistral
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ranges>
+
+#include "Color.h"
+#include "Vector.h"
+
+namespace Mistral
+{
+	struct PointLight
+	{
+		Vec3 position = Vec3::Zero;
+		float range = 10.f;
+		Color3 color = Color3(1.f);
+		float intensity = 1.f;
+	};
+
+	uint32_t AddPointLight(const PointLight& light);
+
+	void RemovePointLight(uint32_t lightId);
+
+	[[nodiscard]] PointLight& GetPointLight(uint32_t lightId);
+
+	std::ranges::values_view<std::ranges::ref_view<std::map<uint32_t, PointLight>>> GetPointLightsView();
+
+	[[nodiscard]] uint32_t GetPointLightsCount();
+} // namespace Mistral
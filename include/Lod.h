@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include "raylib.h"
+#include "Vector.h"
+
+class Spatial;
+
+namespace Mistral
+{
+	inline constexpr uint32_t LodMaxLevels = 4;
+
+	struct LodModel
+	{
+		Model levels[LodMaxLevels];
+		float screenSizes[LodMaxLevels]; // Minimum projected height, as a fraction of the screen, to use each level
+		bool generated[LodMaxLevels];	 // Generated levels share their materials with the first level
+		uint32_t levelCount;
+		Vector3 boundsCenter;
+		float boundsRadius;
+	};
+
+	// Loading
+	[[nodiscard]] LodModel LoadLodModel(const std::filesystem::path& path, uint32_t generatedLevels = LodMaxLevels - 1);
+
+	void UnloadLodModel(const LodModel& lodModel);
+
+	// Vertex clustering simplifier, keeps roughly ratio of the triangles of the source mesh
+	[[nodiscard]] Mesh SimplifyMesh(const Mesh& mesh, float ratio);
+
+	// Selection
+	[[nodiscard]] float GetProjectedScreenSize(const Vec3& center, float radius, const Camera3D& camera);
+
+	[[nodiscard]] uint32_t SelectLodLevel(const LodModel& lodModel, const Spatial& spatial, const Camera3D& camera, uint32_t currentLevel);
+
+	void DrawLodModel(const LodModel& lodModel, const Spatial& spatial, uint32_t& currentLevel, Color tint = WHITE);
+
+	// Settings
+	void SetLodBias(float bias);
+
+	[[nodiscard]] float GetLodBias();
+
+	void SetLodHysteresis(float hysteresis);
+
+	[[nodiscard]] float GetLodHysteresis();
+} // namespace Mistral
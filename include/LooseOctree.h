@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Vector.h"
+
+namespace Mistral
+{
+	// Octree whose nodes accept any object centered inside them and no larger than their half size, so their bounds are loosened to twice
+	// their size. An object moving inside its node only has its position updated, and the root grows outwards when something leaves it,
+	// so the world doesn't need bounds. Objects are spheres, a radius of zero stores points.
+	class LooseOctree
+	{
+	  public:
+
+		explicit LooseOctree(float minNodeSize = 1.f);
+
+		// Objects
+		uint32_t Insert(const Vec3& position, float radius = 0.f, void* userData = nullptr);
+
+		void Remove(uint32_t object);
+
+		void Move(uint32_t object, const Vec3& position);
+
+		void Clear();
+
+		// Queries, objects count as soon as their sphere reaches the query
+		void QueryRadius(const Vec3& center, float radius, std::vector<uint32_t>& results) const;
+
+		// Replaces the results with the count closest objects, nearest first
+		void FindNearest(const Vec3& point, uint32_t count, std::vector<uint32_t>& results,
+						 float maxDistance = std::numeric_limits<float>::max()) const;
+
+		// Getters
+		[[nodiscard]] const Vec3& GetPosition(uint32_t object) const;
+
+		[[nodiscard]] void* GetUserData(uint32_t object) const;
+
+		[[nodiscard]] uint32_t GetCount() const;
+
+		[[nodiscard]] uint32_t GetNodeCount() const;
+
+	  private:
+
+		static constexpr uint32_t NullIndex = std::numeric_limits<uint32_t>::max();
+
+		struct Node
+		{
+			Vec3 center;
+			float halfSize;
+			uint32_t parent;
+			uint32_t children[8];
+			uint32_t childCount;
+			std::vector<uint32_t> objects;
+		};
+
+		struct Object
+		{
+			Vec3 position;
+			float radius;
+			void* userData;
+			uint32_t node; // Next free object once removed
+			uint32_t slot;
+		};
+
+		[[nodiscard]] bool Contains(uint32_t node, const Vec3& position) const;
+
+		// Distance from the point to the loose bounds of the node
+		[[nodiscard]] float GetDistance(uint32_t node, const Vec3& point) const;
+
+		uint32_t AllocateNode(const Vec3& center, float halfSize, uint32_t parent);
+
+		void GrowRoot(const Vec3& position, float radius);
+
+		void Link(uint32_t object);
+
+		void Unlink(uint32_t object);
+
+		float mMinHalfSize;
+		uint32_t mRoot = NullIndex;
+		uint32_t mFreeNodes = NullIndex;
+		uint32_t mFreeObjects = NullIndex;
+		uint32_t mCount = 0;
+		uint32_t mNodeCount = 0;
+		std::vector<Node> mNodes;
+		std::vector<Object> mObjects;
+	};
+} // namespace Mistral
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <ostream>
 
 #include "raylib.h"
@@ -8,24 +10,33 @@ struct Vec3;
 struct Vec4;
 struct Quat;
 
-struct Matrix4x4
+struct alignas(16) Matrix4x4
 {
-	float m0 = 0.f;
-	float m1 = 0.f;
-	float m2 = 0.f;
-	float m3 = 0.f;
-	float m4 = 0.f;
-	float m5 = 0.f;
-	float m6 = 0.f;
-	float m7 = 0.f;
-	float m8 = 0.f;
-	float m9 = 0.f;
-	float m10 = 0.f;
-	float m11 = 0.f;
-	float m12 = 0.f;
-	float m13 = 0.f;
-	float m14 = 0.f;
-	float m15 = 0.f;
+	// Named elements alias a column major array so indexed loops compile to straight vector code. Raylib's Matrix names its fields the same
+	// but declares them row by row, so the two only convert field by field and never share memory
+	union
+	{
+		struct
+		{
+			float m0;
+			float m1;
+			float m2;
+			float m3;
+			float m4;
+			float m5;
+			float m6;
+			float m7;
+			float m8;
+			float m9;
+			float m10;
+			float m11;
+			float m12;
+			float m13;
+			float m14;
+			float m15;
+		};
+		float elements[16] = {};
+	};
 
 	static const Matrix4x4 Identity;
 
@@ -46,12 +57,30 @@ struct Matrix4x4
 	[[nodiscard]] operator Matrix() const; // Raylib's Matrix
 
 	// Access operators
-	[[nodiscard]] float& operator[](std::size_t index);
+	[[nodiscard]] float& operator[](const std::size_t index)
+	{
+		assert(index < 16);
+		return elements[index];
+	}
 
-	[[nodiscard]] float operator[](std::size_t index) const;
+	[[nodiscard]] float operator[](const std::size_t index) const
+	{
+		assert(index < 16);
+		return elements[index];
+	}
 
 	// Binary operators
-	[[nodiscard]] friend constexpr bool operator==(const Matrix4x4& leftOperand, const Matrix4x4& rightOperand) noexcept = default;
+	[[nodiscard]] friend bool operator==(const Matrix4x4& leftOperand, const Matrix4x4& rightOperand) noexcept
+	{
+		for (std::size_t index = 0; index < 16; index++)
+		{
+			if (leftOperand.elements[index] != rightOperand.elements[index])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
 
 	friend std::ostream& operator<<(std::ostream& stream, const Matrix4x4& matrix)
 	{
@@ -76,6 +105,9 @@ struct Matrix4x4
 
 	[[nodiscard]] Matrix4x4 Inverted() const;
 
+	// Inverse of a matrix whose last row is (0, 0, 0, 1), only the 3x3 part goes through cofactors
+	[[nodiscard]] Matrix4x4 AffineInverted() const;
+
 	[[nodiscard]] float Determinant() const;
 
 	[[nodiscard]] Vec3 GetPosition() const;
@@ -84,11 +116,19 @@ struct Matrix4x4
 
 	[[nodiscard]] Vec3 GetScale() const;
 
+	// Affine transforms, points are translated and vectors aren't
+	[[nodiscard]] Vec3 TransformPoint(const Vec3& point) const;
+
+	[[nodiscard]] Vec3 TransformVector(const Vec3& vector) const;
+
 	// Static constructors
 	[[nodiscard]] static Matrix4x4 FromPosition(const Vec3& position);
 
 	[[nodiscard]] static Matrix4x4 FromRotation(const Quat& rotation);
 
+	// Skips the normalization, for rotations known to be unit length already
+	[[nodiscard]] static Matrix4x4 FromNormalizedRotation(const Quat& rotation);
+
 	[[nodiscard]] static Matrix4x4 FromScale(const Vec3& scale);
 
 	[[nodiscard]] static Matrix4x4 FromPRS(const Vec3& position, const Quat& rotation, const Vec3& scale);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "raylib.h"
+
+namespace Mistral
+{
+	struct MeshOptimizationStats
+	{
+		int verticesBefore = 0;
+		int verticesAfter = 0;
+		float acmrBefore = 0.f; // Average cache miss ratio, transformed vertices per triangle
+		float acmrAfter = 0.f;
+	};
+
+	// Welds identical vertices, reorders triangles for the post-transform vertex cache and then for overdraw, and finally orders
+	// vertices by first use for fetch locality. Works on the CPU arrays only, meshes with more than 65535 unique vertices are left as is.
+	MeshOptimizationStats OptimizeMesh(Mesh& mesh);
+
+	// Optimizes every mesh of the model and uploads again the ones that were already on the GPU
+	void OptimizeModel(Model& model);
+
+	[[nodiscard]] std::vector<uint32_t> OptimizeVertexCache(std::span<const uint32_t> indices, uint32_t vertexCount);
+
+	[[nodiscard]] float ComputeAcmr(std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+	[[nodiscard]] float ComputeAcmr(const Mesh& mesh, uint32_t cacheSize = 16);
+
+	// Applied to the models loaded through ResourceLoad and to every level of LoadLodModel, enabled by default
+	void SetMeshOptimization(bool enabled);
+
+	[[nodiscard]] bool IsMeshOptimizationEnabled();
+} // namespace Mistral
@@ -13,6 +13,9 @@ namespace Mistral
 {
 	void StartApplication(const std::string& applicationName, std::unique_ptr<IRenderPipeline> renderPipeline = nullptr);
 
+	IRenderPipeline* GetRenderPipeline();
+
+	// Camera being rendered while cameras render, the camera set with SetActiveCamera otherwise
 	Camera3D* GetActiveCamera();
 
 	void SetActiveCamera(Camera3D* camera);
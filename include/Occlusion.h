@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Matrix.h"
+#include "raylib.h"
+#include "Vector.h"
+
+namespace Mistral
+{
+	// Low resolution software depth buffer. Occluders are rasterized on the CPU in screen tiles and occludee boxes are tested against a
+	// pyramid keeping the farthest depth of every region. Nothing here touches the GPU, so results are identical with or without a window.
+	class OcclusionBuffer
+	{
+	  public:
+
+		explicit OcclusionBuffer(uint32_t width = 256, uint32_t height = 128);
+
+		// Clears the occluders and depth of the previous frame
+		void BeginFrame(const Matrix4x4& viewProjection);
+
+		void AddOccluder(std::span<const Vec3> vertices, std::span<const uint32_t> indices, const Matrix4x4& transform);
+
+		void AddOccluder(const Mesh& mesh, const Matrix4x4& transform);
+
+		// Rasterizes every occluder added since BeginFrame and builds the depth pyramid
+		void Rasterize();
+
+		[[nodiscard]] bool IsVisible(const BoundingBox& bounds) const;
+
+		// Getters
+		[[nodiscard]] uint32_t GetWidth() const;
+
+		[[nodiscard]] uint32_t GetHeight() const;
+
+		[[nodiscard]] float GetDepth(uint32_t x, uint32_t y) const;
+
+		[[nodiscard]] uint32_t GetOccluderTriangleCount() const;
+
+	  private:
+
+		struct ScreenTriangle
+		{
+			Vec3 vertices[3]; // Pixel x, pixel y and depth in [0, 1]
+		};
+
+		void AddClipTriangle(const Vec4& a, const Vec4& b, const Vec4& c);
+
+		void RasterizeTile(uint32_t tile);
+
+		void BuildPyramid();
+
+		uint32_t mWidth;
+		uint32_t mHeight;
+		uint32_t mTilesX;
+		uint32_t mTilesY;
+		Matrix4x4 mViewProjection = Matrix4x4::Identity;
+
+		std::vector<ScreenTriangle> mTriangles;
+		std::vector<std::vector<uint32_t>> mTileTriangles;
+		std::vector<std::vector<float>> mPyramid; // Level 0 is the depth buffer, every other level keeps the farthest depth of 2x2 texels
+	};
+
+	// Engine integration, occluders are submitted every frame from UpdateEvent
+	void SetOcclusionCulling(bool enabled);
+
+	[[nodiscard]] bool IsOcclusionCullingEnabled();
+
+	[[nodiscard]] OcclusionBuffer& GetOcclusionBuffer();
+
+	void SubmitOccluder(const Mesh& mesh, const Matrix4x4& transform);
+
+	void UpdateOcclusionCulling();
+
+	[[nodiscard]] bool IsOccluded(const BoundingBox& bounds);
+
+	// Id of the camera the current occlusion buffer was rasterized from, 0 for the active camera and empty when nothing was rasterized.
+	// Its results don't apply to other cameras.
+	[[nodiscard]] std::optional<uint32_t> GetOcclusionCamera();
+
+	[[nodiscard]] uint32_t GetOccludedCount();
+} // namespace Mistral
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "raylib.h"
+
+struct Vec3;
+struct Quat;
+struct Color4;
+
+// IEEE half precision, rounded to nearest even, infinities and NaN preserved
+[[nodiscard]] uint16_t FloatToHalf(float value);
+
+[[nodiscard]] float HalfToFloat(uint16_t half);
+
+struct Half3
+{
+	uint16_t x = 0;
+	uint16_t y = 0;
+	uint16_t z = 0;
+
+	Half3() = default;
+
+	explicit Half3(const Vec3& vector);
+
+	[[nodiscard]] operator Vec3() const;
+
+	[[nodiscard]] friend constexpr bool operator==(const Half3& leftOperand, const Half3& rightOperand) noexcept = default;
+};
+
+// Smallest three, the index of the dropped component on 2 bits and the others on 10 bits, about 0.002 of error per component
+struct PackedQuat32
+{
+	uint32_t bits = 0;
+
+	PackedQuat32() = default;
+
+	explicit PackedQuat32(const Quat& rotation);
+
+	[[nodiscard]] operator Quat() const;
+
+	[[nodiscard]] friend constexpr bool operator==(const PackedQuat32& leftOperand, const PackedQuat32& rightOperand) noexcept = default;
+};
+
+// Smallest three with the other components on 15 bits, about 5e-5 of error per component
+struct PackedQuat48
+{
+	uint16_t values[3] = {};
+
+	PackedQuat48() = default;
+
+	explicit PackedQuat48(const Quat& rotation);
+
+	[[nodiscard]] operator Quat() const;
+
+	[[nodiscard]] friend constexpr bool operator==(const PackedQuat48& leftOperand, const PackedQuat48& rightOperand) noexcept = default;
+};
+
+// Unit vector projected on an octahedron unfolded over the square, both coordinates as 16 bits signed normalized
+struct OctNormal
+{
+	int16_t x = 0;
+	int16_t y = 0;
+
+	OctNormal() = default;
+
+	explicit OctNormal(const Vec3& normal);
+
+	[[nodiscard]] operator Vec3() const;
+
+	[[nodiscard]] friend constexpr bool operator==(const OctNormal& leftOperand, const OctNormal& rightOperand) noexcept = default;
+};
+
+// Offset from a cell origin in steps of precision, reaching 32767 steps on each side, values beyond are clamped
+struct FixedPosition
+{
+	int16_t x = 0;
+	int16_t y = 0;
+	int16_t z = 0;
+
+	FixedPosition() = default;
+
+	FixedPosition(int16_t x, int16_t y, int16_t z);
+
+	[[nodiscard]] Vec3 ToPosition(const Vec3& origin, float precision) const;
+
+	[[nodiscard]] static FixedPosition FromPosition(const Vec3& position, const Vec3& origin, float precision);
+
+	[[nodiscard]] friend constexpr bool operator==(const FixedPosition& leftOperand, const FixedPosition& rightOperand) noexcept = default;
+};
+
+struct ColorRGBA8
+{
+	uint8_t r = 0;
+	uint8_t g = 0;
+	uint8_t b = 0;
+	uint8_t a = 0;
+
+	ColorRGBA8() = default;
+
+	ColorRGBA8(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+	explicit ColorRGBA8(const Color4& color); // Clamped and rounded
+
+	explicit ColorRGBA8(const Color& color); // Raylib's Color
+
+	[[nodiscard]] operator Color4() const;
+
+	[[nodiscard]] operator Color() const; // Raylib's Color
+
+	[[nodiscard]] friend constexpr bool operator==(const ColorRGBA8& leftOperand, const ColorRGBA8& rightOperand) noexcept = default;
+};
+
+// Red in the lowest 10 bits then green, blue and 2 bits of alpha, the layout of GL_UNSIGNED_INT_2_10_10_10_REV
+struct ColorRGB10A2
+{
+	uint32_t bits = 0;
+
+	ColorRGB10A2() = default;
+
+	explicit ColorRGB10A2(const Color4& color); // Clamped and rounded
+
+	[[nodiscard]] operator Color4() const;
+
+	[[nodiscard]] friend constexpr bool operator==(const ColorRGB10A2& leftOperand, const ColorRGB10A2& rightOperand) noexcept = default;
+};
+
+// Bulk conversions, the shorter span sets the count. Halves, normals, positions and colors go 4 at a time with SSE2, halves 8 at a time
+// when F16C is enabled, rotations are converted one by one.
+void EncodeHalves(std::span<const float> values, std::span<uint16_t> halves);
+
+void DecodeHalves(std::span<const uint16_t> halves, std::span<float> values);
+
+void EncodeHalf3s(std::span<const Vec3> vectors, std::span<Half3> halves);
+
+void DecodeHalf3s(std::span<const Half3> halves, std::span<Vec3> vectors);
+
+void EncodeNormals(std::span<const Vec3> normals, std::span<OctNormal> packed);
+
+void DecodeNormals(std::span<const OctNormal> packed, std::span<Vec3> normals);
+
+void EncodePositions(std::span<const Vec3> positions, const Vec3& origin, float precision, std::span<FixedPosition> packed);
+
+void DecodePositions(std::span<const FixedPosition> packed, const Vec3& origin, float precision, std::span<Vec3> positions);
+
+void EncodeRotations(std::span<const Quat> rotations, std::span<PackedQuat32> packed);
+
+void EncodeRotations(std::span<const Quat> rotations, std::span<PackedQuat48> packed);
+
+void DecodeRotations(std::span<const PackedQuat32> packed, std::span<Quat> rotations);
+
+void DecodeRotations(std::span<const PackedQuat48> packed, std::span<Quat> rotations);
+
+void EncodeColors(std::span<const Color4> colors, std::span<ColorRGBA8> packed);
+
+void DecodeColors(std::span<const ColorRGBA8> packed, std::span<Color4> colors);
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <ostream>
 
 #include "raylib.h"
@@ -8,12 +10,20 @@
 struct Vec3;
 struct Vec4;
 
-struct Quat
+struct alignas(16) Quat
 {
-	float x = 0.0f;
-	float y = 0.0f;
-	float z = 0.0f;
-	float w = 1.0f;
+	// Named components alias an array, indexing compiles to a plain offset
+	union
+	{
+		struct
+		{
+			float x;
+			float y;
+			float z;
+			float w;
+		};
+		float components[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+	};
 
 	static const Quat Identity;
 
@@ -35,12 +45,24 @@ struct Quat
 	[[nodiscard]] operator Quaternion() const; // Raylib's Quaternion
 
 	// Access operators
-	[[nodiscard]] float& operator[](std::size_t index);
+	[[nodiscard]] float& operator[](const std::size_t index)
+	{
+		assert(index < 4);
+		return components[index];
+	}
 
-	[[nodiscard]] float operator[](std::size_t index) const;
+	[[nodiscard]] float operator[](const std::size_t index) const
+	{
+		assert(index < 4);
+		return components[index];
+	}
 
 	// Binary operators
-	[[nodiscard]] friend constexpr bool operator==(const Quat& leftOperand, const Quat& rightOperand) noexcept = default;
+	[[nodiscard]] friend bool operator==(const Quat& leftOperand, const Quat& rightOperand) noexcept
+	{
+		return leftOperand.x == rightOperand.x && leftOperand.y == rightOperand.y && leftOperand.z == rightOperand.z &&
+			   leftOperand.w == rightOperand.w;
+	}
 
 	friend std::ostream& operator<<(std::ostream& stream, const Quat& quat)
 	{
@@ -70,6 +92,9 @@ struct Quat
 
 	[[nodiscard]] Quat Normalized() const;
 
+	// Through FastRsqrt, relative error below 4e-7 with SSE
+	[[nodiscard]] Quat NormalizedFast() const;
+
 	[[nodiscard]] Quat Conjugate() const;
 
 	[[nodiscard]] Quat Inverse() const;
@@ -80,6 +105,12 @@ struct Quat
 
 	[[nodiscard]] Quat Slerp(const Quat& target, float amount) const;
 
+	// Normalized linear interpolation along the shortest path, constant direction but not constant angular speed
+	[[nodiscard]] Quat Nlerp(const Quat& target, float amount) const;
+
+	// Nlerp with the amount corrected to follow Slerp, within 8e-4 radians of it, no trigonometry involved
+	[[nodiscard]] Quat SlerpFast(const Quat& target, float amount) const;
+
 	// Static constructors
 	[[nodiscard]] static Quat FromAxisAngle(const Vec3& axis, float angle);
 
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "GpuTimer.h"
+#include "raylib.h"
+
+namespace Mistral
+{
+	using RenderGraphResource = uint32_t;
+
+	// Zero sizes follow the screen, both are multiplied by scale
+	struct RenderTargetDesc
+	{
+		int width = 0;
+		int height = 0;
+		float scale = 1.f;
+	};
+
+	class RenderGraph;
+
+	// Handed to the setup of a pass to declare what it reads and writes
+	class RenderGraphBuilder
+	{
+	  public:
+
+		// Transient targets only live between their first and last use, their contents are undefined until the pass writing them clears
+		RenderGraphResource CreateTarget(const std::string& name, const RenderTargetDesc& desc = {});
+
+		void Read(RenderGraphResource resource);
+
+		// A pass writes at most one render target, which is bound while it executes
+		void Write(RenderGraphResource resource);
+
+		// Keeps the pass even when nothing reads its outputs
+		void SetSideEffect();
+
+	  private:
+
+		friend class RenderGraph;
+
+		RenderGraphBuilder(RenderGraph& graph, uint32_t pass);
+
+		RenderGraph& mGraph;
+		uint32_t mPass;
+	};
+
+	// Passes are declared once with the resources they use. Compiling culls the passes whose outputs never reach the backbuffer, orders
+	// the rest by their dependencies and lets transient targets with disjoint lifetimes share the same render texture.
+	class RenderGraph
+	{
+	  public:
+
+		using SetupFunction = std::function<void(RenderGraphBuilder& builder)>;
+		using ExecuteFunction = std::function<void(const RenderGraph& graph)>;
+
+		struct PassStats
+		{
+			std::string name;
+			bool culled = false;
+			double cpuTime = 0.0; // Milliseconds
+			double gpuTime = 0.0; // Milliseconds, a few frames old
+		};
+
+		RenderGraph();
+
+		~RenderGraph();
+
+		RenderGraph(const RenderGraph&) = delete;
+
+		RenderGraph& operator=(const RenderGraph&) = delete;
+
+		void AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+		// Removes every pass and resource
+		void Clear();
+
+		void Compile();
+
+		// Compiles first when passes changed or the screen was resized. Expected between BeginDrawing and EndDrawing.
+		void Execute();
+
+		// Getters
+		[[nodiscard]] RenderGraphResource GetBackbuffer() const;
+
+		[[nodiscard]] const Texture& GetTexture(RenderGraphResource resource) const;
+
+		[[nodiscard]] std::span<const PassStats> GetPassStats() const;
+
+		[[nodiscard]] uint32_t GetTransientTargetCount() const;
+
+		[[nodiscard]] uint32_t GetPhysicalTargetCount() const;
+
+	  private:
+
+		friend class RenderGraphBuilder;
+
+		struct Resource
+		{
+			std::string name;
+			RenderTargetDesc desc;
+			bool imported = false;
+			int32_t physical = -1;
+		};
+
+		struct Pass
+		{
+			ExecuteFunction execute;
+			std::vector<RenderGraphResource> reads;
+			std::vector<RenderGraphResource> writes;
+			bool sideEffect = false;
+			std::unique_ptr<GpuTimer> timer;
+		};
+
+		struct PhysicalTarget
+		{
+			RenderTexture target;
+			int width;
+			int height;
+			uint32_t lastUse;
+		};
+
+		void ResolveSize(const RenderTargetDesc& desc, int& width, int& height) const;
+
+		void ReleaseTargets();
+
+		std::vector<Resource> mResources;
+		std::vector<Pass> mPasses;
+		std::vector<PassStats> mStats;
+		std::vector<uint32_t> mOrder;
+		std::vector<PhysicalTarget> mTargets;
+		bool mDirty = true;
+		int mScreenWidth = 0;
+		int mScreenHeight = 0;
+	};
+} // namespace Mistral
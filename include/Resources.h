@@ -1,8 +1,11 @@
 #pragma once
 
 #include <filesystem>
+#include <span>
 
+#include "Lod.h"
 #include "Mistral.h"
+#include "TextureAtlas.h"
 
 namespace Mistral
 {
@@ -10,8 +13,10 @@ namespace Mistral
 	{
 		None,
 		Texture,
+		AtlasRegion,
 		Sound,
 		Model,
+		LodModel,
 		Font
 	};
 
@@ -22,24 +27,39 @@ namespace Mistral
 		union
 		{
 			Texture texture;
+			TextureRegion region;
 			Sound sound;
 			Model model;
+			LodModel lodModel;
 			Font font;
 		};
 	};
 
 	bool ResourceLoad(const std::filesystem::path& path);
 
+	bool ResourceLoadLod(const std::filesystem::path& path);
+
+	// Packs the images into shared atlas pages, images that can't be packed are loaded as standalone textures
+	bool ResourceLoadAtlas(std::span<const std::filesystem::path> paths, const std::filesystem::path& cacheDirectory = {});
+
 	bool ResourceUnload(const std::filesystem::path& path);
 
+	// Unloads every resource along with the atlas pages, called by StartApplication while the window is still open
+	void UnloadResources();
+
 	Resource& ResourceGet(const std::filesystem::path& path);
 
+	// Atlas images return their whole page, use GetTextureRegion to draw only the image
 	Texture& GetTexture(const std::filesystem::path& path);
 
+	[[nodiscard]] TextureRegion GetTextureRegion(const std::filesystem::path& path);
+
 	Sound& GetSound(const std::filesystem::path& path);
 
 	Model& GetModel(const std::filesystem::path& path);
 
+	LodModel& GetLodModel(const std::filesystem::path& path);
+
 	Font& GetFont(const std::filesystem::path& path);
 
 	const std::filesystem::path& GetExecutablePath();
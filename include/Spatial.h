@@ -1,11 +1,22 @@
 #pragma once
 
+#include <Affine.h>
 #include <Matrix.h>
 #include <Quaternion.h>
 #include <Vector.h>
 
 #include <vector>
 
+// World and local transforms are stored as full 4x4 matrices unless MISTRAL_SPATIAL_AFFINE is defined, in which case they're kept as 3x4
+// affine matrices, a quarter less memory and a cheaper hierarchy multiply, at the cost of a conversion in the matrix getters
+#if defined(MISTRAL_SPATIAL_AFFINE)
+using SpatialTransform = Affine3x4;
+using SpatialMatrix = Matrix4x4;
+#else
+using SpatialTransform = Matrix4x4;
+using SpatialMatrix = const Matrix4x4&;
+#endif
+
 class Spatial
 {
   public:
@@ -28,6 +39,11 @@ class Spatial
 
 	void SetScale(const Vec3& scale);
 
+	// World setters convert through the parent, a parent with non-uniform scale can't reproduce every world rotation exactly
+	void SetWorldPosition(const Vec3& position);
+
+	void SetWorldRotation(const Quat& rotation);
+
 	void SetParent(Spatial* parent);
 
 	void AddChild(Spatial* child);
@@ -41,11 +57,12 @@ class Spatial
 
 	[[nodiscard]] const Vec3& GetLocalScale() const;
 
-	[[nodiscard]] Vec3 GetPosition() const;
+	// World values are decomposed once whenever the world matrix is refreshed
+	[[nodiscard]] const Vec3& GetPosition() const;
 
-	[[nodiscard]] Quat GetRotation() const;
+	[[nodiscard]] const Quat& GetRotation() const;
 
-	[[nodiscard]] Vec3 GetScale() const;
+	[[nodiscard]] const Vec3& GetScale() const;
 
 	[[nodiscard]] Spatial* GetParent();
 
@@ -62,11 +79,39 @@ class Spatial
 
 	void Scale(const Vec3& amount);
 
+	// Rotates so Forward points at the target, keeping Up as close to up as possible. Up is picked arbitrarily when looking along it, and
+	// nothing changes when the target is the position
+	void LookAt(const Vec3& target, const Vec3& up = Vec3::Up);
+
 	// Functionalities
-	[[nodiscard]] const Matrix4x4& GetLocalMatrix() const;
+	[[nodiscard]] SpatialMatrix GetLocalMatrix() const;
+
+	[[nodiscard]] SpatialMatrix GetMatrix() const;
+
+	// Computed on first use after the world matrix changed
+	[[nodiscard]] SpatialMatrix GetInverseMatrix() const;
+
+	// World matrix and its inverse in their stored form, no conversion involved
+	[[nodiscard]] const SpatialTransform& GetWorldTransform() const;
+
+	[[nodiscard]] const SpatialTransform& GetInverseWorldTransform() const;
 
-	[[nodiscard]] const Matrix4x4& GetMatrix() const;
+	// Local to world and back, directions are rotated only while vectors are also scaled
+	[[nodiscard]] Vec3 TransformPoint(const Vec3& point) const;
 
+	[[nodiscard]] Vec3 TransformVector(const Vec3& vector) const;
+
+	[[nodiscard]] Vec3 TransformDirection(const Vec3& direction) const;
+
+	[[nodiscard]] Vec3 InverseTransformPoint(const Vec3& point) const;
+
+	[[nodiscard]] Vec3 InverseTransformVector(const Vec3& vector) const;
+
+	[[nodiscard]] Vec3 InverseTransformDirection(const Vec3& direction) const;
+
+	// World basis vectors, read from the normalized world matrix columns. A negative scale mirrors its axis, so Right points the other way
+	// under a scale of (-1, 1, 1) while GetRotation() * Vec3::Right, a rotation being unable to mirror, doesn't. An axis flattened by a
+	// zero scale is rebuilt from the two others.
 	[[nodiscard]] Vec3 Forward() const;
 
 	[[nodiscard]] Vec3 Right() const;
@@ -81,9 +126,15 @@ class Spatial
 
   private:
 
-	void MarkDirty() const;
+	friend void FlushTransforms();
+
+	// Queues the subtree for the next transform flush, its descendants are refreshed along with it
+	void MarkDirty();
 
-	void UpdateMatrices() const;
+	// Refreshes the world matrix of this node alone, the parent world matrix must be up to date
+	void UpdateWorldMatrix() const;
+
+	void DecomposeWorldMatrix() const;
 
 	void SetParentInternal(Spatial* parent);
 
@@ -98,9 +149,20 @@ class Spatial
 	Spatial* mParent = nullptr;
 	std::vector<Spatial*> mChildren;
 
-	mutable Matrix4x4 mWorldMatrix = Matrix4x4::Identity;
-	mutable Matrix4x4 mLocalMatrix = Matrix4x4::Identity;
-	mutable bool mIsDirty = true;
+	mutable SpatialTransform mWorldMatrix = SpatialTransform::Identity;
+	mutable SpatialTransform mLocalMatrix = SpatialTransform::Identity;
+	mutable SpatialTransform mInverseWorldMatrix = SpatialTransform::Identity;
+	mutable Vec3 mWorldPosition = Vec3::Zero;
+	mutable Quat mWorldRotation = Quat::Identity;
+	mutable Vec3 mWorldScale = Vec3::One;
+	mutable bool mIsDirty = false;
+	mutable bool mIsInverseDirty = false;
+	bool mIsQueued = false;
 };
 
+// Refreshes the world matrices of every subtree changed since the last flush. Runs once per frame after the update, getters of world
+// values flush on their own when something is pending, so calling this explicitly only batches the work up front.
+void FlushTransforms();
+
+// Queued through the debug draw module, compiled out with it
 void DrawSpatial(const Spatial& spatial, float size = 1.f);
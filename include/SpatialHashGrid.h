@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Vector.h"
+
+class Spatial;
+
+namespace Mistral
+{
+	// Uniform grid over points, hashed into a table so the world doesn't need bounds. Meant to be rebuilt from scratch every frame: a
+	// counting sort over the cell hashes lays the points out contiguously per cell, with the hashing and scattering split across the
+	// worker threads. Queries return indices into the span the grid was built from.
+	class SpatialHashGrid
+	{
+	  public:
+
+		explicit SpatialHashGrid(float cellSize = 1.f);
+
+		// Setters, the cell size should be about the usual query radius and applies from the next build
+		void SetCellSize(float cellSize);
+
+		// Functionalities
+		void Build(std::span<const Vec3> positions);
+
+		// Reads the world position of every spatial, transforms are flushed first
+		void Build(std::span<const Spatial* const> spatials);
+
+		void Clear();
+
+		// Appends the indices of the points within radius of the center
+		void QueryRadius(const Vec3& center, float radius, std::vector<uint32_t>& results) const;
+
+		// Replaces the results with the indices of the count closest points, nearest first
+		void FindNearest(const Vec3& point, uint32_t count, std::vector<uint32_t>& results,
+						 float maxDistance = std::numeric_limits<float>::max()) const;
+
+		// Getters
+		[[nodiscard]] float GetCellSize() const;
+
+		[[nodiscard]] uint32_t GetCount() const;
+
+		[[nodiscard]] uint32_t GetTableSize() const;
+
+	  private:
+
+		struct Entry
+		{
+			Vec3 position;
+			uint32_t index;
+		};
+
+		[[nodiscard]] uint32_t GetBucket(int32_t x, int32_t y, int32_t z) const;
+
+		// Calls the function with every entry within radius, each bucket visited once even when several cells share it
+		template <typename Function>
+		void ForEachInRadius(const Vec3& center, float radius, Function&& function) const;
+
+		float mCellSize;
+		float mInverseCellSize;
+		uint32_t mTableMask = 0;
+
+		std::vector<uint32_t> mCellStart; // Offsets into the entries, one per bucket plus the end
+		std::vector<Entry> mEntries;	  // Sorted by bucket
+		std::vector<uint32_t> mBuckets;
+		std::vector<uint32_t> mHistograms;
+		std::vector<Vec3> mPositions;
+	};
+} // namespace Mistral
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+#include "raylib.h"
+#include "TextureAtlas.h"
+
+namespace Mistral
+{
+	struct SpriteBatchStats
+	{
+		uint32_t sprites = 0;
+		uint32_t drawCalls = 0; // Texture changes, plus the extra draws rlgl issues when the vertex buffer fills up
+	};
+
+	// Sprites submitted from Render2DEvent are queued and drawn after every component rendered, sorted by layer then texture. Draw order
+	// is only guaranteed between layers and between sprites sharing a texture, sprites of a layer using different textures may interleave.
+	// The modelview matrix current at submission, the one BeginMode2D sets, is applied to the corners right away so world space sprites
+	// keep their camera. Transforms pushed with rlPushMatrix are not captured.
+	void SubmitSprite(const Texture& texture, const Rectangle& source, const Rectangle& destination, Vector2 origin = {0.f, 0.f},
+					  float rotation = 0.f, Color tint = WHITE, int32_t layer = 0);
+
+	void SubmitSprite(const Texture& texture, Vector2 position, Color tint = WHITE, int32_t layer = 0);
+
+	void SubmitSprite(const TextureRegion& region, const Rectangle& destination, Vector2 origin = {0.f, 0.f}, float rotation = 0.f,
+					  Color tint = WHITE, int32_t layer = 0);
+
+	void SubmitSprite(const TextureRegion& region, Vector2 position, Color tint = WHITE, int32_t layer = 0);
+
+	// Draws the queued sprites now, lets immediate raylib calls issued afterward appear on top of them
+	void FlushSprites();
+
+	// Counters since the last reset, the engine resets them at the start of every 2D pass
+	[[nodiscard]] SpriteBatchStats GetSpriteBatchStats();
+
+	void ResetSpriteBatchStats();
+
+	void UnloadSpriteBatch();
+} // namespace Mistral
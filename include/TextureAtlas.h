@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <vector>
+
+#include "raylib.h"
+
+namespace Mistral
+{
+	// Part of a texture, either a whole standalone texture or an image packed into an atlas page
+	struct TextureRegion
+	{
+		Texture texture;
+		Rectangle source;
+	};
+
+	// Packs small images into shared pages with a skyline packer so sprites drawn from them share a texture and batch together. Image
+	// edges are extruded into the padding so filtering never samples a neighbour.
+	class TextureAtlas
+	{
+	  public:
+
+		explicit TextureAtlas(int pageSize = 2048, int padding = 2);
+
+		~TextureAtlas();
+
+		TextureAtlas(const TextureAtlas&) = delete;
+
+		TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+		// Packs the images and uploads the pages. With a cache directory the layout and the pages are written there and loaded back by the
+		// next build, as long as the list of images and their modification times did not change. Images larger than a page are skipped.
+		bool Build(std::span<const std::filesystem::path> paths, const std::filesystem::path& cacheDirectory = {});
+
+		void Unload();
+
+		// Getters
+		[[nodiscard]] bool Contains(const std::filesystem::path& path) const;
+
+		[[nodiscard]] const TextureRegion& GetRegion(const std::filesystem::path& path) const;
+
+		[[nodiscard]] uint32_t GetPageCount() const;
+
+		[[nodiscard]] const Texture& GetPage(uint32_t page) const;
+
+		[[nodiscard]] bool IsLoadedFromCache() const;
+
+	  private:
+
+		struct Entry
+		{
+			std::filesystem::path path;
+			int64_t writeTime;
+			int32_t page; // -1 when the image could not be packed
+			Rectangle source;
+		};
+
+		bool LoadCache(std::span<const std::filesystem::path> paths, const std::filesystem::path& cacheDirectory);
+
+		void SaveCache(const std::filesystem::path& cacheDirectory, std::span<const Image> pages) const;
+
+		void CreateRegions();
+
+		int mPageSize;
+		int mPadding;
+		std::vector<Texture> mPages;
+		std::vector<Entry> mEntries;
+		std::map<std::filesystem::path, TextureRegion, std::less<>> mRegions;
+		bool mLoadedFromCache = false;
+	};
+} // namespace Mistral
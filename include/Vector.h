@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
 #include <ostream>
 
 #include "raylib.h"
@@ -14,8 +16,16 @@ struct ImVec4;
 
 struct Vec2
 {
-	float x = 0.0f;
-	float y = 0.0f;
+	// Named components alias an array, indexing compiles to a plain offset
+	union
+	{
+		struct
+		{
+			float x;
+			float y;
+		};
+		float components[2] = {};
+	};
 
 	static const Vec2 Zero;
 	static const Vec2 One;
@@ -48,12 +58,23 @@ struct Vec2
 	[[nodiscard]] operator ImVec2() const;
 
 	// Access operators
-	[[nodiscard]] float& operator[](std::size_t index);
+	[[nodiscard]] float& operator[](const std::size_t index)
+	{
+		assert(index < 2);
+		return components[index];
+	}
 
-	[[nodiscard]] float operator[](std::size_t index) const;
+	[[nodiscard]] float operator[](const std::size_t index) const
+	{
+		assert(index < 2);
+		return components[index];
+	}
 
 	// Binary operators
-	[[nodiscard]] friend constexpr bool operator==(const Vec2& leftOperand, const Vec2& rightOperand) noexcept = default;
+	[[nodiscard]] friend bool operator==(const Vec2& leftOperand, const Vec2& rightOperand) noexcept
+	{
+		return leftOperand.x == rightOperand.x && leftOperand.y == rightOperand.y;
+	}
 
 	friend std::ostream& operator<<(std::ostream& stream, const Vec2& vector)
 	{
@@ -125,9 +146,16 @@ struct Vec2
 
 struct Vec3
 {
-	float x = 0.0f;
-	float y = 0.0f;
-	float z = 0.0f;
+	union
+	{
+		struct
+		{
+			float x;
+			float y;
+			float z;
+		};
+		float components[3] = {};
+	};
 
 	static const Vec3 Zero;
 	static const Vec3 One;
@@ -160,12 +188,23 @@ struct Vec3
 	[[nodiscard]] operator Vector3() const;
 
 	// Access operators
-	float& operator[](std::size_t index);
+	float& operator[](const std::size_t index)
+	{
+		assert(index < 3);
+		return components[index];
+	}
 
-	float operator[](std::size_t index) const;
+	float operator[](const std::size_t index) const
+	{
+		assert(index < 3);
+		return components[index];
+	}
 
 	// Binary operators
-	[[nodiscard]] friend constexpr bool operator==(const Vec3& leftOperand, const Vec3& rightOperand) noexcept = default;
+	[[nodiscard]] friend bool operator==(const Vec3& leftOperand, const Vec3& rightOperand) noexcept
+	{
+		return leftOperand.x == rightOperand.x && leftOperand.y == rightOperand.y && leftOperand.z == rightOperand.z;
+	}
 
 	friend std::ostream& operator<<(std::ostream& stream, const Vec3& vector)
 	{
@@ -201,6 +240,9 @@ struct Vec3
 
 	[[nodiscard]] Vec3 Normalized() const;
 
+	// Through FastRsqrt, relative error below 4e-7 with SSE
+	[[nodiscard]] Vec3 NormalizedFast() const;
+
 	[[nodiscard]] Vec3 Lerp(const Vec3& target, float amount) const;
 
 	[[nodiscard]] Vec3 Clamp(float min, float max) const;
@@ -249,12 +291,19 @@ struct Vec3
 
 [[nodiscard]] Vec3 operator^(float leftOperand, const Vec3& rightOperand) noexcept;
 
-struct Vec4
+struct alignas(16) Vec4
 {
-	float x = 0.0f;
-	float y = 0.0f;
-	float z = 0.0f;
-	float w = 0.0f;
+	union
+	{
+		struct
+		{
+			float x;
+			float y;
+			float z;
+			float w;
+		};
+		float components[4] = {};
+	};
 
 	static const Vec4 Zero;
 	static const Vec4 One;
@@ -283,12 +332,24 @@ struct Vec4
 	[[nodiscard]] operator ImVec4() const;
 
 	// Access operators
-	float& operator[](std::size_t index);
+	float& operator[](const std::size_t index)
+	{
+		assert(index < 4);
+		return components[index];
+	}
 
-	float operator[](std::size_t index) const;
+	float operator[](const std::size_t index) const
+	{
+		assert(index < 4);
+		return components[index];
+	}
 
 	// Binary operators
-	[[nodiscard]] friend constexpr bool operator==(const Vec4& leftOperand, const Vec4& rightOperand) noexcept = default;
+	[[nodiscard]] friend bool operator==(const Vec4& leftOperand, const Vec4& rightOperand) noexcept
+	{
+		return leftOperand.x == rightOperand.x && leftOperand.y == rightOperand.y && leftOperand.z == rightOperand.z &&
+			   leftOperand.w == rightOperand.w;
+	}
 
 	friend std::ostream& operator<<(std::ostream& stream, const Vec4& vector)
 	{
@@ -0,0 +1,203 @@
+#include "Affine.h"
+
+#include <cmath>
+
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "Vector.h"
+
+const Affine3x4 Affine3x4::Identity = {1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f};
+
+// Parametrized constructors
+Affine3x4::Affine3x4(const float m0, const float m1, const float m2, const float m4, const float m5, const float m6, const float m8, const float m9,
+					 const float m10, const float m12, const float m13, const float m14):
+	m0(m0),
+	m1(m1),
+	m2(m2),
+	m4(m4),
+	m5(m5),
+	m6(m6),
+	m8(m8),
+	m9(m9),
+	m10(m10),
+	m12(m12),
+	m13(m13),
+	m14(m14)
+{
+}
+
+// Copy constructors
+Affine3x4::Affine3x4(const Matrix4x4& matrix):
+	m0(matrix.m0),
+	m1(matrix.m1),
+	m2(matrix.m2),
+	m4(matrix.m4),
+	m5(matrix.m5),
+	m6(matrix.m6),
+	m8(matrix.m8),
+	m9(matrix.m9),
+	m10(matrix.m10),
+	m12(matrix.m12),
+	m13(matrix.m13),
+	m14(matrix.m14)
+{
+}
+
+Affine3x4::Affine3x4(const Matrix& matrix):
+	m0(matrix.m0),
+	m1(matrix.m1),
+	m2(matrix.m2),
+	m4(matrix.m4),
+	m5(matrix.m5),
+	m6(matrix.m6),
+	m8(matrix.m8),
+	m9(matrix.m9),
+	m10(matrix.m10),
+	m12(matrix.m12),
+	m13(matrix.m13),
+	m14(matrix.m14)
+{
+}
+
+// Conversion operators
+Affine3x4::operator Matrix4x4() const
+{
+	return {m0, m1, m2, 0.f, m4, m5, m6, 0.f, m8, m9, m10, 0.f, m12, m13, m14, 1.f};
+}
+
+Affine3x4::operator Matrix() const
+{
+	return {m0, m4, m8, m12, m1, m5, m9, m13, m2, m6, m10, m14, 0.f, 0.f, 0.f, 1.f};
+}
+
+// Compound assignment operators
+Affine3x4& Affine3x4::operator*=(const Affine3x4& affine) noexcept
+{
+	*this = *this * affine;
+	return *this;
+}
+
+// Functionalities
+Affine3x4 Affine3x4::Inverted() const
+{
+	// Cofactors of the 3x3 part, the inverse translation is the inverse 3x3 applied to the negated translation
+	const float c0 = m5 * m10 - m6 * m9;
+	const float c1 = m2 * m9 - m1 * m10;
+	const float c2 = m1 * m6 - m2 * m5;
+
+	const float det = m0 * c0 + m4 * c1 + m8 * c2;
+
+	if (fabsf(det) < 1e-6f)
+	{
+		return Affine3x4::Identity;
+	}
+
+	const float invDet = 1.f / det;
+
+	Affine3x4 result;
+	result.m0 = c0 * invDet;
+	result.m1 = c1 * invDet;
+	result.m2 = c2 * invDet;
+	result.m4 = (m6 * m8 - m4 * m10) * invDet;
+	result.m5 = (m0 * m10 - m2 * m8) * invDet;
+	result.m6 = (m2 * m4 - m0 * m6) * invDet;
+	result.m8 = (m4 * m9 - m5 * m8) * invDet;
+	result.m9 = (m1 * m8 - m0 * m9) * invDet;
+	result.m10 = (m0 * m5 - m1 * m4) * invDet;
+	result.m12 = -(result.m0 * m12 + result.m4 * m13 + result.m8 * m14);
+	result.m13 = -(result.m1 * m12 + result.m5 * m13 + result.m9 * m14);
+	result.m14 = -(result.m2 * m12 + result.m6 * m13 + result.m10 * m14);
+
+	return result;
+}
+
+float Affine3x4::Determinant() const
+{
+	return m0 * (m5 * m10 - m6 * m9) + m4 * (m2 * m9 - m1 * m10) + m8 * (m1 * m6 - m2 * m5);
+}
+
+Vec3 Affine3x4::TransformPoint(const Vec3& point) const
+{
+	return {m0 * point.x + m4 * point.y + m8 * point.z + m12, m1 * point.x + m5 * point.y + m9 * point.z + m13,
+			m2 * point.x + m6 * point.y + m10 * point.z + m14};
+}
+
+Vec3 Affine3x4::TransformVector(const Vec3& vector) const
+{
+	return {m0 * vector.x + m4 * vector.y + m8 * vector.z, m1 * vector.x + m5 * vector.y + m9 * vector.z,
+			m2 * vector.x + m6 * vector.y + m10 * vector.z};
+}
+
+Vec3 Affine3x4::GetPosition() const
+{
+	return {m12, m13, m14};
+}
+
+Quat Affine3x4::GetRotation() const
+{
+	return static_cast<Matrix4x4>(*this).GetRotation();
+}
+
+Vec3 Affine3x4::GetScale() const
+{
+	return {Vec3(m0, m1, m2).Length(), Vec3(m4, m5, m6).Length(), Vec3(m8, m9, m10).Length()};
+}
+
+void Affine3x4::ToRows(float rows[12]) const
+{
+	const float values[12] = {m0, m4, m8, m12, m1, m5, m9, m13, m2, m6, m10, m14};
+	for (int index = 0; index < 12; index++)
+	{
+		rows[index] = values[index];
+	}
+}
+
+// Static constructors
+Affine3x4 Affine3x4::FromPRS(const Vec3& position, const Quat& rotation, const Vec3& scale)
+{
+	// Rotation columns scaled in place, no matrix product needed
+	const Quat q = rotation.Normalized();
+
+	const float xx = q.x * q.x;
+	const float yy = q.y * q.y;
+	const float zz = q.z * q.z;
+	const float xy = q.x * q.y;
+	const float xz = q.x * q.z;
+	const float yz = q.y * q.z;
+	const float wx = q.w * q.x;
+	const float wy = q.w * q.y;
+	const float wz = q.w * q.z;
+
+	return {(1.f - 2.f * (yy + zz)) * scale.x,
+			2.f * (xy + wz) * scale.x,
+			2.f * (xz - wy) * scale.x,
+			2.f * (xy - wz) * scale.y,
+			(1.f - 2.f * (xx + zz)) * scale.y,
+			2.f * (yz + wx) * scale.y,
+			2.f * (xz + wy) * scale.z,
+			2.f * (yz - wx) * scale.z,
+			(1.f - 2.f * (xx + yy)) * scale.z,
+			position.x,
+			position.y,
+			position.z};
+}
+
+// Arithmetic operators
+Affine3x4 operator*(const Affine3x4& leftOperand, const Affine3x4& rightOperand) noexcept
+{
+	const Affine3x4& l = leftOperand;
+	const Affine3x4& r = rightOperand;
+
+	return {l.m0 * r.m0 + l.m4 * r.m1 + l.m8 * r.m2,
+			l.m1 * r.m0 + l.m5 * r.m1 + l.m9 * r.m2,
+			l.m2 * r.m0 + l.m6 * r.m1 + l.m10 * r.m2,
+			l.m0 * r.m4 + l.m4 * r.m5 + l.m8 * r.m6,
+			l.m1 * r.m4 + l.m5 * r.m5 + l.m9 * r.m6,
+			l.m2 * r.m4 + l.m6 * r.m5 + l.m10 * r.m6,
+			l.m0 * r.m8 + l.m4 * r.m9 + l.m8 * r.m10,
+			l.m1 * r.m8 + l.m5 * r.m9 + l.m9 * r.m10,
+			l.m2 * r.m8 + l.m6 * r.m9 + l.m10 * r.m10,
+			l.m0 * r.m12 + l.m4 * r.m13 + l.m8 * r.m14 + l.m12,
+			l.m1 * r.m12 + l.m5 * r.m13 + l.m9 * r.m14 + l.m13,
+			l.m2 * r.m12 + l.m6 * r.m13 + l.m10 * r.m14 + l.m14};
+}
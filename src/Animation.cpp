@@ -0,0 +1,777 @@
+#include "Animation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include "JobSystem.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define MISTRAL_ANIMATION_SSE
+#endif
+
+namespace
+{
+	std::map<uint32_t, Mistral::Animator> animators;
+	uint32_t nextAnimatorId = 1;
+
+	// Reused between frames to avoid reallocating
+	std::vector<Mistral::Animator*> evaluatedAnimators;
+
+	constexpr float quantizedMaximum = 65535.f;
+
+	template <typename T>
+	struct PoseChannels
+	{
+		T* position[3];
+		T* rotation[4];
+		T* scale[3];
+	};
+
+	PoseChannels<const float> GetChannels(const Mistral::Pose& pose)
+	{
+		return {{pose.positionX.data(), pose.positionY.data(), pose.positionZ.data()},
+				{pose.rotationX.data(), pose.rotationY.data(), pose.rotationZ.data(), pose.rotationW.data()},
+				{pose.scaleX.data(), pose.scaleY.data(), pose.scaleZ.data()}};
+	}
+
+	PoseChannels<float> GetChannels(Mistral::Pose& pose)
+	{
+		return {{pose.positionX.data(), pose.positionY.data(), pose.positionZ.data()},
+				{pose.rotationX.data(), pose.rotationY.data(), pose.rotationZ.data(), pose.rotationW.data()},
+				{pose.scaleX.data(), pose.scaleY.data(), pose.scaleZ.data()}};
+	}
+
+	// Weights holds one value per bone, or a single one for every bone when uniform
+	void LerpVectors(const float* const from[3], const float* const to[3], const float* weights, const bool uniform, float* const result[3],
+					 const uint32_t count)
+	{
+		uint32_t index = 0;
+
+#if defined(MISTRAL_ANIMATION_SSE)
+		for (; index + 4 <= count; index += 4)
+		{
+			const __m128 weight = uniform ? _mm_set1_ps(weights[0]) : _mm_loadu_ps(weights + index);
+			for (uint32_t axis = 0; axis < 3; axis++)
+			{
+				const __m128 a = _mm_loadu_ps(from[axis] + index);
+				const __m128 b = _mm_loadu_ps(to[axis] + index);
+				_mm_storeu_ps(result[axis] + index, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), weight)));
+			}
+		}
+#endif
+
+		for (; index < count; index++)
+		{
+			const float weight = uniform ? weights[0] : weights[index];
+			for (uint32_t axis = 0; axis < 3; axis++)
+			{
+				result[axis][index] = from[axis][index] + (to[axis][index] - from[axis][index]) * weight;
+			}
+		}
+	}
+
+	// Normalized linear interpolation, the target is negated when it's on the other hemisphere so the shortest path is taken
+	void NlerpRotations(const float* const from[4], const float* const to[4], const float* weights, const bool uniform, float* const result[4],
+						const uint32_t count)
+	{
+		uint32_t index = 0;
+
+#if defined(MISTRAL_ANIMATION_SSE)
+		const __m128 signMask = _mm_set1_ps(-0.f);
+		const __m128 one = _mm_set1_ps(1.f);
+
+		for (; index + 4 <= count; index += 4)
+		{
+			const __m128 weight = uniform ? _mm_set1_ps(weights[0]) : _mm_loadu_ps(weights + index);
+
+			__m128 a[4];
+			__m128 b[4];
+			for (uint32_t component = 0; component < 4; component++)
+			{
+				a[component] = _mm_loadu_ps(from[component] + index);
+				b[component] = _mm_loadu_ps(to[component] + index);
+			}
+
+			const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])),
+										  _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+			const __m128 sign = _mm_and_ps(dot, signMask);
+
+			__m128 blended[4];
+			__m128 lengthSqr = _mm_setzero_ps();
+			for (uint32_t component = 0; component < 4; component++)
+			{
+				const __m128 target = _mm_xor_ps(b[component], sign);
+				blended[component] = _mm_add_ps(a[component], _mm_mul_ps(_mm_sub_ps(target, a[component]), weight));
+				lengthSqr = _mm_add_ps(lengthSqr, _mm_mul_ps(blended[component], blended[component]));
+			}
+
+			const __m128 inverseLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSqr));
+			for (uint32_t component = 0; component < 4; component++)
+			{
+				_mm_storeu_ps(result[component] + index, _mm_mul_ps(blended[component], inverseLength));
+			}
+		}
+#endif
+
+		for (; index < count; index++)
+		{
+			const float weight = uniform ? weights[0] : weights[index];
+
+			float dot = 0.f;
+			for (uint32_t component = 0; component < 4; component++)
+			{
+				dot += from[component][index] * to[component][index];
+			}
+
+			const float sign = dot < 0.f ? -1.f : 1.f;
+
+			float blended[4];
+			float lengthSqr = 0.f;
+			for (uint32_t component = 0; component < 4; component++)
+			{
+				blended[component] = from[component][index] + (to[component][index] * sign - from[component][index]) * weight;
+				lengthSqr += blended[component] * blended[component];
+			}
+
+			const float inverseLength = 1.f / sqrtf(lengthSqr);
+			for (uint32_t component = 0; component < 4; component++)
+			{
+				result[component][index] = blended[component] * inverseLength;
+			}
+		}
+	}
+
+	void BlendChannels(const Mistral::Pose& from, const Mistral::Pose& to, const float* positionWeights, const float* rotationWeights,
+					   const float* scaleWeights, const bool uniform, Mistral::Pose& result)
+	{
+		const uint32_t count = std::min(from.GetBoneCount(), to.GetBoneCount());
+		result.Resize(count);
+
+		const PoseChannels<const float> fromChannels = GetChannels(from);
+		const PoseChannels<const float> toChannels = GetChannels(to);
+		const PoseChannels<float> resultChannels = GetChannels(result);
+
+		LerpVectors(fromChannels.position, toChannels.position, positionWeights, uniform, resultChannels.position, count);
+		NlerpRotations(fromChannels.rotation, toChannels.rotation, rotationWeights, uniform, resultChannels.rotation, count);
+		LerpVectors(fromChannels.scale, toChannels.scale, scaleWeights, uniform, resultChannels.scale, count);
+	}
+
+	// Inverse of raylib's parent composition, where position = parentRotation * (parentScale * localPosition) + parentPosition
+	void ToLocal(const Transform& transform, const Transform& parent, Vec3& position, Quat& rotation, Vec3& scale)
+	{
+		const Quat parentInverse = Quat(parent.rotation).Conjugate();
+		position = (parentInverse * (Vec3(transform.translation) - Vec3(parent.translation))) / Vec3(parent.scale);
+		rotation = (parentInverse * Quat(transform.rotation)).Normalized();
+		scale = Vec3(transform.scale) / Vec3(parent.scale);
+	}
+
+	uint16_t Quantize(const float value)
+	{
+		return static_cast<uint16_t>(std::lround(std::clamp(value, 0.f, 1.f) * quantizedMaximum));
+	}
+
+	float Dequantize(const uint16_t value)
+	{
+		return static_cast<float>(value) / quantizedMaximum;
+	}
+
+	Vec3 DecodeVector(const uint16_t values[3], const Vec3& minimum, const Vec3& extent)
+	{
+		return {minimum.x + Dequantize(values[0]) * extent.x, minimum.y + Dequantize(values[1]) * extent.y,
+				minimum.z + Dequantize(values[2]) * extent.z};
+	}
+
+	// Greedily extends every segment while interpolating its ends reproduces the frames in between within tolerance
+	template <typename T, typename Interpolate, typename Distance>
+	std::vector<uint32_t> ReduceKeys(const std::vector<T>& values, const float tolerance, Interpolate interpolate, Distance distance)
+	{
+		const uint32_t last = static_cast<uint32_t>(values.size()) - 1;
+
+		auto isReproduced = [&](const uint32_t start, const uint32_t end) {
+			for (uint32_t frame = start + 1; frame < end; frame++)
+			{
+				const float amount = static_cast<float>(frame - start) / static_cast<float>(end - start);
+				if (distance(interpolate(values[start], values[end], amount), values[frame]) > tolerance)
+				{
+					return false;
+				}
+			}
+			return true;
+		};
+
+		std::vector<uint32_t> keys = {0};
+		uint32_t start = 0;
+		while (start < last)
+		{
+			uint32_t end = start + 1;
+			while (end < last && isReproduced(start, end + 1))
+			{
+				end++;
+			}
+
+			keys.push_back(end);
+			start = end;
+		}
+
+		// A track that doesn't move keeps its first key only
+		if (keys.size() == 2 && distance(values[0], values[last]) <= tolerance)
+		{
+			keys.pop_back();
+		}
+
+		return keys;
+	}
+
+	// Pair of keys around the frame and the amount between them
+	template <typename Key>
+	void FindKeys(const Key* keys, const uint32_t keyCount, const float frame, const Key*& from, const Key*& to, float& amount)
+	{
+		const Key* next = std::upper_bound(keys, keys + keyCount, frame, [](const float value, const Key& key) { return value < key.frame; });
+		if (next == keys)
+		{
+			from = to = keys;
+			amount = 0.f;
+			return;
+		}
+
+		from = next - 1;
+		if (next == keys + keyCount)
+		{
+			to = from;
+			amount = 0.f;
+			return;
+		}
+
+		to = next;
+		amount = (frame - static_cast<float>(from->frame)) / static_cast<float>(to->frame - from->frame);
+	}
+
+	// Clip pair around the parameter and the amount between them, a single clip is returned twice
+	bool FindBlendClips(const Mistral::AnimationBlend1D& blend, const Mistral::AnimationClip*& from, const Mistral::AnimationClip*& to, float& amount)
+	{
+		const size_t count = blend.clips.size();
+		if (count == 0)
+		{
+			return false;
+		}
+
+		amount = 0.f;
+		if (count == 1 || blend.thresholds.size() < count || blend.parameter <= blend.thresholds[0])
+		{
+			from = to = blend.clips[0];
+			return from != nullptr;
+		}
+
+		if (blend.parameter >= blend.thresholds[count - 1])
+		{
+			from = to = blend.clips[count - 1];
+			return from != nullptr;
+		}
+
+		const size_t upper = std::upper_bound(blend.thresholds.cbegin(), blend.thresholds.cbegin() + count, blend.parameter) - blend.thresholds.cbegin();
+		from = blend.clips[upper - 1];
+		to = blend.clips[upper];
+
+		const float range = blend.thresholds[upper] - blend.thresholds[upper - 1];
+		amount = range > 0.f ? (blend.parameter - blend.thresholds[upper - 1]) / range : 0.f;
+		return from && to;
+	}
+
+	// Blended clips share one normalized time so their cycles stay aligned, the layer advances at the blended duration
+	void AdvanceLayer(Mistral::AnimationLayer& layer, const float deltaTime)
+	{
+		const Mistral::AnimationClip* from;
+		const Mistral::AnimationClip* to;
+		float amount;
+		if (!FindBlendClips(layer.blend, from, to, amount))
+		{
+			return;
+		}
+
+		const float duration = from->GetDuration() + (to->GetDuration() - from->GetDuration()) * amount;
+		if (duration <= 0.f)
+		{
+			return;
+		}
+
+		layer.phase += deltaTime * layer.speed / duration;
+		layer.phase = layer.loop ? layer.phase - floorf(layer.phase) : std::clamp(layer.phase, 0.f, 1.f);
+	}
+
+	void EvaluateAnimator(Mistral::Animator& animator)
+	{
+		if (!animator.skeleton)
+		{
+			return;
+		}
+
+		const Mistral::Skeleton& skeleton = *animator.skeleton;
+		const uint32_t boneCount = skeleton.GetBoneCount();
+
+		// Per worker scratch, evaluation runs on whichever thread picked the animator
+		thread_local Mistral::Pose layerPose;
+		thread_local Mistral::Pose blendPose;
+		thread_local std::vector<float> weights;
+
+		animator.pose.SetBindPose(skeleton);
+
+		for (const Mistral::AnimationLayer& layer : animator.layers)
+		{
+			const Mistral::AnimationClip* from;
+			const Mistral::AnimationClip* to;
+			float amount;
+			if (layer.weight <= 0.f || !FindBlendClips(layer.blend, from, to, amount) || from->GetBoneCount() != boneCount ||
+				to->GetBoneCount() != boneCount)
+			{
+				continue;
+			}
+
+			from->Sample(layer.phase * from->GetDuration(), layerPose, layer.loop);
+			if (to != from && amount > 0.f)
+			{
+				to->Sample(layer.phase * to->GetDuration(), blendPose, layer.loop);
+				Mistral::BlendPoses(layerPose, blendPose, amount, layerPose);
+			}
+
+			if (!layer.boneMask.empty())
+			{
+				weights.resize(boneCount);
+				for (uint32_t bone = 0; bone < boneCount; bone++)
+				{
+					weights[bone] = bone < layer.boneMask.size() ? layer.weight * layer.boneMask[bone] : 0.f;
+				}
+
+				Mistral::BlendPoses(animator.pose, layerPose, weights, animator.pose);
+			}
+			else if (layer.weight >= 1.f)
+			{
+				std::swap(animator.pose, layerPose);
+			}
+			else
+			{
+				Mistral::BlendPoses(animator.pose, layerPose, layer.weight, animator.pose);
+			}
+		}
+
+		animator.modelTransforms.resize(boneCount);
+		animator.skinningMatrices.resize(boneCount);
+		Mistral::ComputeModelTransforms(skeleton, animator.pose, animator.modelTransforms);
+		Mistral::ComputeSkinningMatrices(skeleton, animator.modelTransforms, animator.skinningMatrices);
+	}
+} // namespace
+
+// Skeleton
+uint32_t Mistral::Skeleton::GetBoneCount() const
+{
+	return parents.size();
+}
+
+Mistral::Skeleton Mistral::LoadSkeleton(const Model& model)
+{
+	Skeleton skeleton;
+	const uint32_t boneCount = std::max(model.boneCount, 0);
+
+	skeleton.parents.resize(boneCount);
+	skeleton.bindPositions.resize(boneCount);
+	skeleton.bindRotations.resize(boneCount);
+	skeleton.bindScales.resize(boneCount);
+	skeleton.inverseBindTransforms.resize(boneCount);
+
+	for (uint32_t bone = 0; bone < boneCount; bone++)
+	{
+		int32_t parent = model.bones[bone].parent;
+		if (parent >= static_cast<int32_t>(bone))
+		{
+			std::cerr << "[Error] Bone " << model.bones[bone].name << " comes before its parent, it's treated as a root" << std::endl;
+			parent = -1;
+		}
+
+		const Transform& transform = model.bindPose[bone];
+		skeleton.parents[bone] = parent;
+		skeleton.inverseBindTransforms[bone] = Affine3x4::FromPRS(transform.translation, Quat(transform.rotation), transform.scale).Inverted();
+
+		if (parent >= 0)
+		{
+			ToLocal(transform, model.bindPose[parent], skeleton.bindPositions[bone], skeleton.bindRotations[bone], skeleton.bindScales[bone]);
+		}
+		else
+		{
+			skeleton.bindPositions[bone] = transform.translation;
+			skeleton.bindRotations[bone] = Quat(transform.rotation);
+			skeleton.bindScales[bone] = transform.scale;
+		}
+	}
+
+	return skeleton;
+}
+
+// Pose
+void Mistral::Pose::Resize(const uint32_t boneCount)
+{
+	positionX.resize(boneCount);
+	positionY.resize(boneCount);
+	positionZ.resize(boneCount);
+	rotationX.resize(boneCount);
+	rotationY.resize(boneCount);
+	rotationZ.resize(boneCount);
+	rotationW.resize(boneCount);
+	scaleX.resize(boneCount);
+	scaleY.resize(boneCount);
+	scaleZ.resize(boneCount);
+}
+
+void Mistral::Pose::SetBindPose(const Skeleton& skeleton)
+{
+	const uint32_t boneCount = skeleton.GetBoneCount();
+	Resize(boneCount);
+
+	for (uint32_t bone = 0; bone < boneCount; bone++)
+	{
+		SetBone(bone, skeleton.bindPositions[bone], skeleton.bindRotations[bone], skeleton.bindScales[bone]);
+	}
+}
+
+void Mistral::Pose::SetBone(const uint32_t bone, const Vec3& position, const Quat& rotation, const Vec3& scale)
+{
+	positionX[bone] = position.x;
+	positionY[bone] = position.y;
+	positionZ[bone] = position.z;
+	rotationX[bone] = rotation.x;
+	rotationY[bone] = rotation.y;
+	rotationZ[bone] = rotation.z;
+	rotationW[bone] = rotation.w;
+	scaleX[bone] = scale.x;
+	scaleY[bone] = scale.y;
+	scaleZ[bone] = scale.z;
+}
+
+Vec3 Mistral::Pose::GetPosition(const uint32_t bone) const
+{
+	return {positionX[bone], positionY[bone], positionZ[bone]};
+}
+
+Quat Mistral::Pose::GetRotation(const uint32_t bone) const
+{
+	return {rotationX[bone], rotationY[bone], rotationZ[bone], rotationW[bone]};
+}
+
+Vec3 Mistral::Pose::GetScale(const uint32_t bone) const
+{
+	return {scaleX[bone], scaleY[bone], scaleZ[bone]};
+}
+
+uint32_t Mistral::Pose::GetBoneCount() const
+{
+	return positionX.size();
+}
+
+// Animation clip
+Mistral::AnimationClip::AnimationClip(const ModelAnimation& animation, const Skeleton& skeleton, const float frameRate,
+									  const AnimationCompression& compression):
+	mName(animation.name),
+	mFrameRate(frameRate)
+{
+	if (animation.boneCount < 0 || static_cast<uint32_t>(animation.boneCount) != skeleton.GetBoneCount())
+	{
+		std::cerr << "[Error] Animation " << animation.name << " doesn't match the bones of the skeleton" << std::endl;
+		return;
+	}
+
+	// Key frames are stored on 16 bits
+	if (animation.frameCount <= 0 || animation.frameCount > 65536)
+	{
+		std::cerr << "[Error] Animation " << animation.name << " has an unsupported frame count: " << animation.frameCount << std::endl;
+		return;
+	}
+
+	mFrameCount = animation.frameCount;
+	mBoneCount = animation.boneCount;
+	mPositionTracks.resize(mBoneCount);
+	mRotationTracks.resize(mBoneCount);
+	mScaleTracks.resize(mBoneCount);
+
+	std::vector<Vec3> positions(mFrameCount);
+	std::vector<Quat> rotations(mFrameCount);
+	std::vector<Vec3> scales(mFrameCount);
+
+	auto lerp = [](const Vec3& from, const Vec3& to, const float amount) { return from + (to - from) * amount; };
+	auto nlerp = [](const Quat& from, const Quat& to, const float amount) { return (from * (1.f - amount) + to * amount).Normalized(); };
+	auto vectorDistance = [](const Vec3& from, const Vec3& to) { return (to - from).Length(); };
+	// From the chord between the quaternions, acos loses too much precision near identical rotations
+	auto angle = [](const Quat& from, const Quat& to) {
+		const Quat chord = from.Dot(to) < 0.f ? from + to : from - to;
+		return 4.f * asinf(std::min(chord.Length() * .5f, 1.f));
+	};
+
+	auto addVectorTrack = [this](const std::vector<Vec3>& values, const std::vector<uint32_t>& keys, Track& track, std::vector<VectorKey>& trackKeys) {
+		Vec3 maximum = values[0];
+		track.minimum = values[0];
+		for (const Vec3& value : values)
+		{
+			track.minimum = {std::min(track.minimum.x, value.x), std::min(track.minimum.y, value.y), std::min(track.minimum.z, value.z)};
+			maximum = {std::max(maximum.x, value.x), std::max(maximum.y, value.y), std::max(maximum.z, value.z)};
+		}
+
+		track.extent = maximum - track.minimum;
+		track.firstKey = trackKeys.size();
+		track.keyCount = keys.size();
+
+		for (const uint32_t frame : keys)
+		{
+			VectorKey& key = trackKeys.emplace_back();
+			key.frame = static_cast<uint16_t>(frame);
+			for (uint32_t axis = 0; axis < 3; axis++)
+			{
+				key.values[axis] = Quantize(track.extent[axis] > 0.f ? (values[frame][axis] - track.minimum[axis]) / track.extent[axis] : 0.f);
+			}
+		}
+	};
+
+	for (uint32_t bone = 0; bone < mBoneCount; bone++)
+	{
+		const int32_t parent = skeleton.parents[bone];
+
+		for (uint32_t frame = 0; frame < mFrameCount; frame++)
+		{
+			const Transform& transform = animation.framePoses[frame][bone];
+			if (parent >= 0)
+			{
+				ToLocal(transform, animation.framePoses[frame][parent], positions[frame], rotations[frame], scales[frame]);
+			}
+			else
+			{
+				positions[frame] = transform.translation;
+				rotations[frame] = Quat(transform.rotation).Normalized();
+				scales[frame] = transform.scale;
+			}
+
+			// Neighbouring rotations on the same hemisphere, so interpolating between the kept keys follows the source
+			if (frame > 0 && rotations[frame].Dot(rotations[frame - 1]) < 0.f)
+			{
+				rotations[frame] = rotations[frame] * -1.f;
+			}
+		}
+
+		addVectorTrack(positions, ReduceKeys(positions, compression.positionTolerance, lerp, vectorDistance), mPositionTracks[bone], mPositionKeys);
+		addVectorTrack(scales, ReduceKeys(scales, compression.scaleTolerance, lerp, vectorDistance), mScaleTracks[bone], mScaleKeys);
+
+		const std::vector<uint32_t> rotationKeys = ReduceKeys(rotations, compression.rotationTolerance, nlerp, angle);
+		mRotationTracks[bone].firstKey = mRotationKeys.size();
+		mRotationTracks[bone].keyCount = rotationKeys.size();
+		for (const uint32_t frame : rotationKeys)
+		{
+			RotationKey& key = mRotationKeys.emplace_back();
+			key.frame = static_cast<uint16_t>(frame);
+			key.rotation = PackedQuat48(rotations[frame]);
+		}
+	}
+}
+
+const std::string& Mistral::AnimationClip::GetName() const
+{
+	return mName;
+}
+
+float Mistral::AnimationClip::GetDuration() const
+{
+	return mFrameCount > 1 ? static_cast<float>(mFrameCount - 1) / mFrameRate : 0.f;
+}
+
+float Mistral::AnimationClip::GetFrameRate() const
+{
+	return mFrameRate;
+}
+
+uint32_t Mistral::AnimationClip::GetFrameCount() const
+{
+	return mFrameCount;
+}
+
+uint32_t Mistral::AnimationClip::GetBoneCount() const
+{
+	return mBoneCount;
+}
+
+size_t Mistral::AnimationClip::GetKeyCount() const
+{
+	return mPositionKeys.size() + mRotationKeys.size() + mScaleKeys.size();
+}
+
+size_t Mistral::AnimationClip::GetMemorySize() const
+{
+	return (mPositionTracks.size() + mRotationTracks.size() + mScaleTracks.size()) * sizeof(Track) +
+		   (mPositionKeys.size() + mScaleKeys.size()) * sizeof(VectorKey) + mRotationKeys.size() * sizeof(RotationKey);
+}
+
+void Mistral::AnimationClip::Sample(const float time, Pose& pose, const bool loop) const
+{
+	pose.Resize(mBoneCount);
+	if (mFrameCount == 0)
+	{
+		return;
+	}
+
+	const float duration = GetDuration();
+	float clipTime = time;
+	if (loop && duration > 0.f)
+	{
+		clipTime = fmodf(time, duration);
+		clipTime += clipTime < 0.f ? duration : 0.f;
+	}
+
+	const float frame = std::clamp(clipTime * mFrameRate, 0.f, static_cast<float>(mFrameCount - 1));
+
+	// Keys around the frame are decoded into two poses, then interpolated for every bone at once
+	thread_local Pose fromKeys;
+	thread_local Pose toKeys;
+	thread_local std::vector<float> amounts;
+	fromKeys.Resize(mBoneCount);
+	toKeys.Resize(mBoneCount);
+	amounts.resize(mBoneCount * 3);
+
+	float* positionAmounts = amounts.data();
+	float* rotationAmounts = positionAmounts + mBoneCount;
+	float* scaleAmounts = rotationAmounts + mBoneCount;
+
+	for (uint32_t bone = 0; bone < mBoneCount; bone++)
+	{
+		const Track& positionTrack = mPositionTracks[bone];
+		const VectorKey* fromPosition;
+		const VectorKey* toPosition;
+		FindKeys(mPositionKeys.data() + positionTrack.firstKey, positionTrack.keyCount, frame, fromPosition, toPosition, positionAmounts[bone]);
+
+		const Track& rotationTrack = mRotationTracks[bone];
+		const RotationKey* fromRotation;
+		const RotationKey* toRotation;
+		FindKeys(mRotationKeys.data() + rotationTrack.firstKey, rotationTrack.keyCount, frame, fromRotation, toRotation, rotationAmounts[bone]);
+
+		const Track& scaleTrack = mScaleTracks[bone];
+		const VectorKey* fromScale;
+		const VectorKey* toScale;
+		FindKeys(mScaleKeys.data() + scaleTrack.firstKey, scaleTrack.keyCount, frame, fromScale, toScale, scaleAmounts[bone]);
+
+		fromKeys.SetBone(bone, DecodeVector(fromPosition->values, positionTrack.minimum, positionTrack.extent), Quat(fromRotation->rotation),
+						 DecodeVector(fromScale->values, scaleTrack.minimum, scaleTrack.extent));
+		toKeys.SetBone(bone, DecodeVector(toPosition->values, positionTrack.minimum, positionTrack.extent), Quat(toRotation->rotation),
+					   DecodeVector(toScale->values, scaleTrack.minimum, scaleTrack.extent));
+	}
+
+	BlendChannels(fromKeys, toKeys, positionAmounts, rotationAmounts, scaleAmounts, false, pose);
+}
+
+// Blending
+void Mistral::BlendPoses(const Pose& from, const Pose& to, const float weight, Pose& result)
+{
+	BlendChannels(from, to, &weight, &weight, &weight, true, result);
+}
+
+void Mistral::BlendPoses(const Pose& from, const Pose& to, const std::span<const float> weights, Pose& result)
+{
+	if (weights.size() < std::min(from.GetBoneCount(), to.GetBoneCount()))
+	{
+		throw std::runtime_error("Not enough blend weights for the poses");
+	}
+
+	BlendChannels(from, to, weights.data(), weights.data(), weights.data(), false, result);
+}
+
+void Mistral::ComputeModelTransforms(const Skeleton& skeleton, const Pose& pose, const std::span<Affine3x4> modelTransforms)
+{
+	const uint32_t count = std::min({skeleton.GetBoneCount(), pose.GetBoneCount(), static_cast<uint32_t>(modelTransforms.size())});
+
+	for (uint32_t bone = 0; bone < count; bone++)
+	{
+		const Affine3x4 local = Affine3x4::FromPRS(pose.GetPosition(bone), pose.GetRotation(bone), pose.GetScale(bone));
+		const int32_t parent = skeleton.parents[bone];
+		modelTransforms[bone] = parent >= 0 ? modelTransforms[parent] * local : local;
+	}
+}
+
+void Mistral::ComputeSkinningMatrices(const Skeleton& skeleton, const std::span<const Affine3x4> modelTransforms,
+									  const std::span<Matrix> skinningMatrices)
+{
+	const size_t count = std::min({static_cast<size_t>(skeleton.GetBoneCount()), modelTransforms.size(), skinningMatrices.size()});
+
+	for (size_t bone = 0; bone < count; bone++)
+	{
+		skinningMatrices[bone] = modelTransforms[bone] * skeleton.inverseBindTransforms[bone];
+	}
+}
+
+// Animators
+uint32_t Mistral::AddAnimator(const Animator& animator)
+{
+	const uint32_t animatorId = nextAnimatorId++;
+	animators.emplace(animatorId, animator);
+	return animatorId;
+}
+
+void Mistral::RemoveAnimator(const uint32_t animatorId)
+{
+	animators.erase(animatorId);
+}
+
+Mistral::Animator& Mistral::GetAnimator(const uint32_t animatorId)
+{
+	if (!animators.contains(animatorId))
+	{
+		throw std::runtime_error("Animator not found");
+	}
+	return animators[animatorId];
+}
+
+std::ranges::values_view<std::ranges::ref_view<std::map<uint32_t, Mistral::Animator>>> Mistral::GetAnimatorsView()
+{
+	return animators | std::views::values;
+}
+
+uint32_t Mistral::GetAnimatorsCount()
+{
+	return animators.size();
+}
+
+void Mistral::UpdateAnimators(const float deltaTime)
+{
+	evaluatedAnimators.clear();
+	for (Animator& animator : animators | std::views::values)
+	{
+		for (AnimationLayer& layer : animator.layers)
+		{
+			AdvanceLayer(layer, deltaTime);
+		}
+
+		evaluatedAnimators.push_back(&animator);
+	}
+
+	ParallelFor(static_cast<uint32_t>(evaluatedAnimators.size()), 1, [](const uint32_t begin, const uint32_t end) {
+		for (uint32_t index = begin; index < end; index++)
+		{
+			EvaluateAnimator(*evaluatedAnimators[index]);
+		}
+	});
+
+	for (const Animator* animator : evaluatedAnimators)
+	{
+		if (animator->model)
+		{
+			ApplyAnimator(*animator, *animator->model);
+		}
+	}
+}
+
+void Mistral::ApplyAnimator(const Animator& animator, Model& model)
+{
+	for (int32_t mesh = 0; mesh < model.meshCount; mesh++)
+	{
+		if (!model.meshes[mesh].boneMatrices)
+		{
+			continue;
+		}
+
+		const size_t count = std::min(static_cast<size_t>(std::max(model.meshes[mesh].boneCount, 0)), animator.skinningMatrices.size());
+		std::copy_n(animator.skinningMatrices.cbegin(), count, model.meshes[mesh].boneMatrices);
+	}
+}
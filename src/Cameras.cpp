@@ -0,0 +1,306 @@
+#include "Cameras.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "Component.h"
+#include "external/glad.h"
+#include "GeometryBatch.h"
+#include "Matrix.h"
+#include "Mistral.h"
+#include "Occlusion.h"
+#include "rlgl.h"
+
+namespace
+{
+	struct RenderItem
+	{
+		Mistral::Component* component;
+		BoundingBox bounds;
+		uint32_t layerMask;
+		uint32_t boundsIndex; // Into the bounds batch
+		bool bounded;
+	};
+
+	struct VisibleList
+	{
+		Matrix4x4 viewProjection;
+		uint32_t cullingMask;
+		bool occlusion;
+		std::vector<Mistral::Component*> components;
+	};
+
+	std::map<uint32_t, Mistral::CameraView> cameras;
+	uint32_t nextCameraId = 1;
+
+	Camera3D* renderingCamera = nullptr;
+	const std::vector<Mistral::Component*>* renderingComponents = nullptr;
+
+	// Reused between frames to avoid reallocating
+	std::vector<RenderItem> renderQueue;
+	std::vector<VisibleList> visibleLists;
+	AabbBatch renderBounds;
+	std::vector<uint32_t> insideBounds;
+
+	Matrix4x4 GetProjection(const Camera3D& camera, const float aspect)
+	{
+		if (camera.projection == CAMERA_PERSPECTIVE)
+		{
+			return Matrix4x4::Perspective(camera.fovy, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+		}
+
+		const float top = camera.fovy * .5f;
+		const float right = top * aspect;
+		return Matrix4x4::Orthographic(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+	}
+
+	void BuildRenderQueue()
+	{
+		renderQueue.clear();
+		renderBounds.Clear();
+		for (const auto& component : Mistral::GetComponentsView())
+		{
+			RenderItem& item = renderQueue.emplace_back();
+			item.component = component.get();
+			item.layerMask = component->GetLayerMask();
+			item.bounded = component->GetBounds(item.bounds);
+			item.boundsIndex = static_cast<uint32_t>(renderBounds.Size());
+			if (item.bounded)
+			{
+				renderBounds.Add(item.bounds);
+			}
+		}
+	}
+
+	const std::vector<Mistral::Component*>& GetVisibleComponents(const uint32_t cameraId, const Matrix4x4& viewProjection, const uint32_t cullingMask)
+	{
+		// Occlusion results only hold for the camera they were rasterized from, so its list is never shared with another camera
+		const bool occlusion = Mistral::IsOcclusionCullingEnabled() && Mistral::GetOcclusionCamera() == cameraId;
+
+		for (const VisibleList& list : visibleLists)
+		{
+			if (list.viewProjection == viewProjection && list.cullingMask == cullingMask && list.occlusion == occlusion)
+			{
+				return list.components;
+			}
+		}
+
+		VisibleList& list = visibleLists.emplace_back();
+		list.viewProjection = viewProjection;
+		list.cullingMask = cullingMask;
+		list.occlusion = occlusion;
+
+		// Every bound is tested against the frustum in one batch, the indices come back sorted like the queue
+		insideBounds.clear();
+		CullAabbs(Frustum::FromMatrix(viewProjection), renderBounds, insideBounds);
+		auto nextInside = insideBounds.cbegin();
+
+		for (const RenderItem& item : renderQueue)
+		{
+			bool inside = true;
+			if (item.bounded)
+			{
+				inside = nextInside != insideBounds.cend() && *nextInside == item.boundsIndex;
+				nextInside += inside ? 1 : 0;
+			}
+
+			if ((item.layerMask & cullingMask) == 0)
+			{
+				continue;
+			}
+
+			if (!inside || (item.bounded && occlusion && Mistral::IsOccluded(item.bounds)))
+			{
+				continue;
+			}
+
+			list.components.push_back(item.component);
+		}
+		return list.components;
+	}
+
+	void RenderCamera(const uint32_t cameraId, Mistral::CameraView& view, const Mistral::CameraOutput& output)
+	{
+		RenderTexture* target = view.target ? view.target : output.target;
+		int targetWidth = view.target ? view.target->texture.width : GetRenderWidth();
+		int targetHeight = view.target ? view.target->texture.height : GetRenderHeight();
+		if (!view.target && output.target)
+		{
+			targetWidth = output.width > 0 ? output.width : output.target->texture.width;
+			targetHeight = output.height > 0 ? output.height : output.target->texture.height;
+		}
+
+		const int x = static_cast<int>(view.viewport.x * static_cast<float>(targetWidth));
+		const int width = static_cast<int>(view.viewport.width * static_cast<float>(targetWidth));
+		const int height = static_cast<int>(view.viewport.height * static_cast<float>(targetHeight));
+		const int y = targetHeight - static_cast<int>(view.viewport.y * static_cast<float>(targetHeight)) - height; // GL origin is bottom left
+		if (width <= 0 || height <= 0)
+		{
+			return;
+		}
+
+		if (output.beginCamera)
+		{
+			output.beginCamera(view.camera, {static_cast<float>(x), static_cast<float>(y), static_cast<float>(width), static_cast<float>(height)});
+		}
+
+		if (target)
+		{
+			BeginTextureMode(*target);
+		}
+		else
+		{
+			rlDrawRenderBatchActive();
+		}
+
+		rlViewport(x, y, width, height);
+
+		rlEnableScissorTest();
+		rlScissor(x, y, width, height);
+		if (view.clear)
+		{
+			ClearBackground(view.clearColor);
+		}
+		else
+		{
+			glClear(GL_DEPTH_BUFFER_BIT);
+		}
+		rlDisableScissorTest();
+
+		// Same as BeginMode3D, which takes the aspect from the whole framebuffer instead of the viewport
+		const Matrix4x4 projection = GetProjection(view.camera, static_cast<float>(width) / static_cast<float>(height));
+		const Matrix4x4 viewMatrix = Matrix4x4::LookAt(view.camera.position, view.camera.target, view.camera.up);
+
+		rlMatrixMode(RL_PROJECTION);
+		rlPushMatrix();
+		rlLoadIdentity();
+		rlMultMatrixf(&projection.m0);
+		rlMatrixMode(RL_MODELVIEW);
+		rlLoadIdentity();
+		rlMultMatrixf(&viewMatrix.m0);
+		rlEnableDepthTest();
+
+		renderingCamera = &view.camera;
+		renderingComponents = &GetVisibleComponents(cameraId, projection * viewMatrix, view.cullingMask);
+
+		Mistral::ComponentRender3DEventCallback();
+
+		renderingCamera = nullptr;
+		renderingComponents = nullptr;
+
+		EndMode3D();
+
+		if (target)
+		{
+			EndTextureMode();
+		}
+		else
+		{
+			rlViewport(0, 0, GetRenderWidth(), GetRenderHeight());
+		}
+	}
+} // namespace
+
+uint32_t Mistral::AddCamera(const CameraView& view)
+{
+	const uint32_t cameraId = nextCameraId++;
+	cameras.emplace(cameraId, view);
+	return cameraId;
+}
+
+void Mistral::RemoveCamera(const uint32_t cameraId)
+{
+	cameras.erase(cameraId);
+}
+
+Mistral::CameraView& Mistral::GetCamera(const uint32_t cameraId)
+{
+	if (!cameras.contains(cameraId))
+	{
+		throw std::runtime_error("Camera not found");
+	}
+	return cameras[cameraId];
+}
+
+std::ranges::values_view<std::ranges::ref_view<std::map<uint32_t, Mistral::CameraView>>> Mistral::GetCamerasView()
+{
+	return cameras | std::views::values;
+}
+
+uint32_t Mistral::GetCamerasCount()
+{
+	return cameras.size();
+}
+
+void Mistral::RenderCameras(const CameraOutput& output)
+{
+	BuildRenderQueue();
+	visibleLists.clear();
+
+	if (cameras.empty())
+	{
+		if (const auto camera = GetActiveCamera())
+		{
+			// Stands for the active camera with id 0, the output was already cleared by the pipeline
+			CameraView view;
+			view.camera = *camera;
+			view.clear = false;
+			RenderCamera(0, view, output);
+		}
+		return;
+	}
+
+	std::vector<std::pair<uint32_t, CameraView*>> order;
+	for (auto& [cameraId, view] : cameras)
+	{
+		if (view.enabled)
+		{
+			order.emplace_back(cameraId, &view);
+		}
+	}
+
+	// Offscreen cameras first so their targets are ready for the screen ones
+	std::ranges::stable_sort(order, [](const auto& a, const auto& b) {
+		if ((a.second->target == nullptr) != (b.second->target == nullptr))
+		{
+			return a.second->target != nullptr;
+		}
+		return a.second->priority < b.second->priority;
+	});
+
+	for (const auto& [cameraId, view] : order)
+	{
+		RenderCamera(cameraId, *view, output);
+	}
+}
+
+uint32_t Mistral::GetPrimaryCamera()
+{
+	uint32_t primaryId = 0;
+	const CameraView* primary = nullptr;
+	for (const auto& [cameraId, view] : cameras)
+	{
+		if (!view.enabled)
+		{
+			continue;
+		}
+
+		if (!primary || (!view.target && (primary->target || view.priority < primary->priority)))
+		{
+			primaryId = cameraId;
+			primary = &view;
+		}
+	}
+	return primaryId;
+}
+
+Camera3D* Mistral::GetRenderingCamera()
+{
+	return renderingCamera;
+}
+
+const std::vector<Mistral::Component*>* Mistral::GetRenderingCameraComponents()
+{
+	return renderingComponents;
+}
@@ -0,0 +1,356 @@
+#include "CaptureRenderPipeline.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Cameras.h"
+#include "external/glad.h"
+#include "Mistral.h"
+#include "rlgl.h"
+
+Mistral::CaptureRenderPipeline::CaptureRenderPipeline(std::filesystem::path outputDirectory, const uint32_t readbackBuffers,
+													   const uint32_t maxQueuedFrames):
+	mOutputDirectory(std::move(outputDirectory)),
+	mMaxQueuedFrames(maxQueuedFrames),
+	mReadbacks(std::max(readbackBuffers, 1u))
+{
+}
+
+Mistral::CaptureRenderPipeline::~CaptureRenderPipeline()
+{
+	// Frames already read back are still delivered, the ones in flight would need the GPU to finish
+	if (mTarget.id != 0)
+	{
+		CollectReadbacks(true);
+		ReleaseReadbacks();
+		UnloadRenderTexture(mTarget);
+	}
+
+	{
+		std::lock_guard lock(mMutex);
+		mStopping = true;
+	}
+	mCondition.notify_all();
+
+	if (mWorker.joinable())
+	{
+		mWorker.join();
+	}
+}
+
+void Mistral::CaptureRenderPipeline::Initialize()
+{
+	if (!mOutputDirectory.empty())
+	{
+		std::error_code error;
+		std::filesystem::create_directories(mOutputDirectory, error);
+	}
+
+	mWorker = std::thread(&CaptureRenderPipeline::WorkerLoop, this);
+	UpdateTarget();
+}
+
+void Mistral::CaptureRenderPipeline::RenderEvent()
+{
+	UpdateTarget();
+
+	CollectReadbacks(false);
+
+	BeginDrawing();
+
+	{ // Captured space
+		BeginTextureMode(mTarget);
+
+		ClearBackground(RAYWHITE);
+
+		EndTextureMode();
+
+		// Binds the target for every camera on its own, offscreen cameras switch framebuffers in between
+		CameraOutput output;
+		output.target = &mTarget;
+		RenderCameras(output);
+
+		BeginTextureMode(mTarget);
+
+		ComponentRender2DEventCallback();
+
+		EndTextureMode();
+	}
+
+	if (mContinuousCapture || mRequestedFrames > 0)
+	{
+		IssueReadback();
+		mRequestedFrames -= mRequestedFrames > 0 ? 1 : 0;
+	}
+
+	// Render textures are stored bottom up, hence the negative source height
+	const Rectangle source = {0.f, 0.f, static_cast<float>(mTarget.texture.width), -static_cast<float>(mTarget.texture.height)};
+	const Rectangle destination = {0.f, 0.f, static_cast<float>(GetScreenWidth()), static_cast<float>(GetScreenHeight())};
+	DrawTexturePro(mTarget.texture, source, destination, {0.f, 0.f}, 0.f, WHITE);
+
+	{ // ImGui space
+		rlImGuiBegin();
+
+		ComponentRenderGUIEventCallback();
+
+		rlImGuiEnd();
+	}
+
+	EndDrawing();
+
+	mFrame++;
+}
+
+// Setters
+void Mistral::CaptureRenderPipeline::SetFrameCallback(FrameCallback callback)
+{
+	std::lock_guard lock(mMutex);
+	mCallback = std::move(callback);
+}
+
+void Mistral::CaptureRenderPipeline::SetContinuousCapture(const bool enabled)
+{
+	mContinuousCapture = enabled;
+}
+
+void Mistral::CaptureRenderPipeline::RequestCapture(const uint32_t frameCount)
+{
+	mRequestedFrames += frameCount;
+}
+
+// Getters
+bool Mistral::CaptureRenderPipeline::IsContinuousCapture() const
+{
+	return mContinuousCapture;
+}
+
+uint64_t Mistral::CaptureRenderPipeline::GetCapturedFrameCount() const
+{
+	return mCapturedFrames;
+}
+
+uint64_t Mistral::CaptureRenderPipeline::GetDroppedFrameCount() const
+{
+	return mDroppedFrames;
+}
+
+const RenderTexture& Mistral::CaptureRenderPipeline::GetRenderTarget() const
+{
+	return mTarget;
+}
+
+// Internal
+void Mistral::CaptureRenderPipeline::UpdateTarget()
+{
+	// Screen size rather than render size so 2D coordinates match the presented image
+	const int width = GetScreenWidth();
+	const int height = GetScreenHeight();
+	if (mTarget.id != 0 && mTarget.texture.width == width && mTarget.texture.height == height)
+	{
+		return;
+	}
+
+	if (mTarget.id != 0)
+	{
+		CollectReadbacks(true);
+		ReleaseReadbacks();
+		UnloadRenderTexture(mTarget);
+	}
+
+	mTarget = LoadRenderTexture(width, height);
+
+	const auto size = static_cast<GLsizeiptr>(width) * height * 4;
+	for (Readback& readback : mReadbacks)
+	{
+		glGenBuffers(1, &readback.buffer);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+		glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void Mistral::CaptureRenderPipeline::IssueReadback()
+{
+	// Never wait for a buffer, a capture that can't be queued is dropped
+	Readback& readback = mReadbacks[mNextReadback];
+	if (readback.fence)
+	{
+		mDroppedFrames++;
+		return;
+	}
+
+	// The copy into the pixel buffer is queued on the GPU and returns immediately
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, mTarget.id);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, mTarget.texture.width, mTarget.texture.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+	readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	readback.frame = mFrame;
+	readback.width = mTarget.texture.width;
+	readback.height = mTarget.texture.height;
+
+	mNextReadback = (mNextReadback + 1) % static_cast<uint32_t>(mReadbacks.size());
+}
+
+void Mistral::CaptureRenderPipeline::CollectReadbacks(const bool wait)
+{
+	// Oldest first so frames reach the worker in order
+	for (uint32_t offset = 0; offset < mReadbacks.size(); offset++)
+	{
+		Readback& readback = mReadbacks[(mNextReadback + offset) % mReadbacks.size()];
+		if (!readback.fence)
+		{
+			continue;
+		}
+
+		const auto fence = static_cast<GLsync>(readback.fence);
+		const GLenum status = glClientWaitSync(fence, 0, wait ? 1'000'000'000ull : 0ull);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+		{
+			if (!wait)
+			{
+				break;
+			}
+			mDroppedFrames++;
+		}
+		else
+		{
+			CapturedFrame capturedFrame;
+			capturedFrame.width = readback.width;
+			capturedFrame.height = readback.height;
+			capturedFrame.frame = readback.frame;
+
+			{
+				std::lock_guard lock(mMutex);
+				if (!mFreePixels.empty())
+				{
+					capturedFrame.pixels = std::move(mFreePixels.back());
+					mFreePixels.pop_back();
+				}
+			}
+
+			const size_t size = static_cast<size_t>(readback.width) * readback.height * 4;
+			capturedFrame.pixels.resize(size);
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+			if (const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT))
+			{
+				std::memcpy(capturedFrame.pixels.data(), pixels, size);
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+				std::lock_guard lock(mMutex);
+				if (mQueue.size() < mMaxQueuedFrames)
+				{
+					mQueue.push_back(std::move(capturedFrame));
+					mCondition.notify_one();
+				}
+				else
+				{
+					mDroppedFrames++;
+				}
+			}
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		}
+
+		glDeleteSync(fence);
+		readback.fence = nullptr;
+	}
+}
+
+void Mistral::CaptureRenderPipeline::ReleaseReadbacks()
+{
+	for (Readback& readback : mReadbacks)
+	{
+		if (readback.fence)
+		{
+			glDeleteSync(static_cast<GLsync>(readback.fence));
+			readback.fence = nullptr;
+		}
+
+		if (readback.buffer != 0)
+		{
+			glDeleteBuffers(1, &readback.buffer);
+			readback.buffer = 0;
+		}
+	}
+	mNextReadback = 0;
+}
+
+void Mistral::CaptureRenderPipeline::WorkerLoop()
+{
+	while (true)
+	{
+		CapturedFrame capturedFrame;
+		{
+			std::unique_lock lock(mMutex);
+			mCondition.wait(lock, [this] { return mStopping || !mQueue.empty(); });
+			if (mQueue.empty())
+			{
+				return;
+			}
+
+			capturedFrame = std::move(mQueue.front());
+			mQueue.pop_front();
+		}
+
+		WriteFrame(capturedFrame);
+		mCapturedFrames++;
+
+		std::lock_guard lock(mMutex);
+		mFreePixels.push_back(std::move(capturedFrame.pixels));
+	}
+}
+
+void Mistral::CaptureRenderPipeline::WriteFrame(CapturedFrame& capturedFrame)
+{
+	// Read back bottom up, flipped here to keep it off the main thread
+	const size_t stride = static_cast<size_t>(capturedFrame.width) * 4;
+	std::vector<unsigned char> row(stride);
+	for (int y = 0; y < capturedFrame.height / 2; y++)
+	{
+		unsigned char* top = capturedFrame.pixels.data() + static_cast<size_t>(y) * stride;
+		unsigned char* bottom = capturedFrame.pixels.data() + static_cast<size_t>(capturedFrame.height - 1 - y) * stride;
+		std::memcpy(row.data(), top, stride);
+		std::memcpy(top, bottom, stride);
+		std::memcpy(bottom, row.data(), stride);
+	}
+
+	Image image = {};
+	image.data = capturedFrame.pixels.data();
+	image.width = capturedFrame.width;
+	image.height = capturedFrame.height;
+	image.mipmaps = 1;
+	image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+	FrameCallback callback;
+	{
+		std::lock_guard lock(mMutex);
+		callback = mCallback;
+	}
+
+	if (callback)
+	{
+		callback(image, capturedFrame.frame);
+		return;
+	}
+
+	if (mOutputDirectory.empty())
+	{
+		return;
+	}
+
+	// Zero padded so the files sort in capture order
+	std::string number = std::to_string(capturedFrame.frame);
+	number.insert(0, number.size() < 6 ? 6 - number.size() : 0, '0');
+
+	const std::string name = "frame_" + number + ".png";
+	if (!ExportImage(image, (mOutputDirectory / name).string().c_str()))
+	{
+		std::cerr << "[Error] Captured frame could not be written: " << name << std::endl;
+	}
+}
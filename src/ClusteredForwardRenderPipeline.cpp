@@ -0,0 +1,472 @@
+#include "ClusteredForwardRenderPipeline.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "Cameras.h"
+#include "external/glad.h"
+#include "JobSystem.h"
+#include "Lights.h"
+#include "Matrix.h"
+#include "Mistral.h"
+#include "rlgl.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <xmmintrin.h>
+	#define MISTRAL_CLUSTER_SSE
+#endif
+
+namespace
+{
+	constexpr uint32_t lightIndexTextureWidth = 1024;
+
+	// Texture units above the material maps so lit draws keep their own textures bound
+	constexpr int clusterTextureSlot = 13;
+	constexpr int lightIndexTextureSlot = 14;
+	constexpr int lightDataTextureSlot = 15;
+
+	constexpr float paddingLightPosition = 1e30f;
+
+	struct SliceLights
+	{
+		std::vector<uint16_t> indices;
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> z;
+		std::vector<float> rangeSqr;
+	};
+
+	Texture CreateDataTexture(const int width, const int height, const int format)
+	{
+		Texture texture = {};
+		texture.id = rlLoadTexture(nullptr, width, height, format, 1);
+		texture.width = width;
+		texture.height = height;
+		texture.mipmaps = 1;
+		texture.format = format;
+		SetTextureFilter(texture, TEXTURE_FILTER_POINT);
+		return texture;
+	}
+
+	void BindDataTexture(const Shader& shader, const char* uniformName, const Texture& texture, const int slot)
+	{
+		const int location = GetShaderLocation(shader, uniformName);
+		if (location < 0)
+		{
+			return;
+		}
+
+		rlActiveTextureSlot(slot);
+		rlEnableTexture(texture.id);
+		rlSetUniform(location, &slot, RL_SHADER_UNIFORM_SAMPLER2D, 1);
+	}
+
+	// Appends to out the lights of the slice whose sphere touches the cluster box
+	uint32_t IntersectClusterLights(const SliceLights& slice, const Vec3& boxMin, const Vec3& boxMax, uint16_t* out, const uint32_t capacity)
+	{
+		uint32_t count = 0;
+
+#if defined(MISTRAL_CLUSTER_SSE)
+		const __m128 minX = _mm_set1_ps(boxMin.x);
+		const __m128 minY = _mm_set1_ps(boxMin.y);
+		const __m128 minZ = _mm_set1_ps(boxMin.z);
+		const __m128 maxX = _mm_set1_ps(boxMax.x);
+		const __m128 maxY = _mm_set1_ps(boxMax.y);
+		const __m128 maxZ = _mm_set1_ps(boxMax.z);
+		const __m128 zero = _mm_setzero_ps();
+
+		// Slice arrays are padded to a multiple of four with lights that can't intersect anything
+		for (size_t index = 0; index < slice.x.size(); index += 4)
+		{
+			const __m128 x = _mm_loadu_ps(&slice.x[index]);
+			const __m128 y = _mm_loadu_ps(&slice.y[index]);
+			const __m128 z = _mm_loadu_ps(&slice.z[index]);
+
+			const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minX, x), _mm_sub_ps(x, maxX)), zero);
+			const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minY, y), _mm_sub_ps(y, maxY)), zero);
+			const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(minZ, z), _mm_sub_ps(z, maxZ)), zero);
+			const __m128 distanceSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+			auto mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(distanceSqr, _mm_loadu_ps(&slice.rangeSqr[index]))));
+			while (mask != 0 && count < capacity)
+			{
+				const auto lane = static_cast<size_t>(std::countr_zero(mask));
+				out[count++] = slice.indices[index + lane];
+				mask &= mask - 1;
+			}
+		}
+#else
+		for (size_t index = 0; index < slice.indices.size() && count < capacity; index++)
+		{
+			const float dx = std::max({boxMin.x - slice.x[index], slice.x[index] - boxMax.x, 0.f});
+			const float dy = std::max({boxMin.y - slice.y[index], slice.y[index] - boxMax.y, 0.f});
+			const float dz = std::max({boxMin.z - slice.z[index], slice.z[index] - boxMax.z, 0.f});
+
+			if (dx * dx + dy * dy + dz * dz <= slice.rangeSqr[index])
+			{
+				out[count++] = slice.indices[index];
+			}
+		}
+#endif
+		return count;
+	}
+} // namespace
+
+Mistral::ClusteredForwardRenderPipeline::ClusteredForwardRenderPipeline(const uint32_t clustersX, const uint32_t clustersY, const uint32_t clustersZ,
+																		 const float nearPlane, const float farPlane, const uint32_t maxLights,
+																		 const uint32_t maxLightsPerCluster):
+	mClustersX(std::max(clustersX, 1u)),
+	mClustersY(std::max(clustersY, 1u)),
+	mClustersZ(std::max(clustersZ, 1u)),
+	mNearPlane(nearPlane),
+	mFarPlane(farPlane),
+	mMaxLights(std::clamp(maxLights, 1u, 65535u)),
+	mMaxLightsPerCluster(std::max(maxLightsPerCluster, 1u))
+{
+}
+
+Mistral::ClusteredForwardRenderPipeline::~ClusteredForwardRenderPipeline()
+{
+	if (mClusterTexture.id != 0)
+	{
+		UnloadTexture(mClusterTexture);
+		UnloadTexture(mLightIndexTexture);
+		UnloadTexture(mLightDataTexture);
+	}
+}
+
+void Mistral::ClusteredForwardRenderPipeline::Initialize()
+{
+	// Lights are one row each of the light data texture and cluster lists fill rows of the index texture, neither can outgrow the
+	// texture size of the device
+	GLint maxTextureSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+	if (maxTextureSize > 0)
+	{
+		const auto maxRows = static_cast<uint32_t>(maxTextureSize);
+		mMaxLights = std::min(mMaxLights, maxRows);
+		const uint64_t maxIndices = static_cast<uint64_t>(maxRows) * lightIndexTextureWidth;
+		mMaxLightsPerCluster = static_cast<uint32_t>(std::clamp<uint64_t>(maxIndices / GetClusterCount(), 1, mMaxLightsPerCluster));
+	}
+
+	const uint32_t clusterCount = GetClusterCount();
+	const uint32_t indexCapacity = clusterCount * mMaxLightsPerCluster;
+	const uint32_t indexRows = (indexCapacity + lightIndexTextureWidth - 1) / lightIndexTextureWidth;
+
+	mClusterCounts.resize(clusterCount);
+	mClusterLights.resize(static_cast<size_t>(indexCapacity));
+	mClusterGrid.resize(static_cast<size_t>(clusterCount) * 4);
+	mLightIndices.resize(static_cast<size_t>(indexRows) * lightIndexTextureWidth);
+	mLightData.resize(static_cast<size_t>(mMaxLights) * 8);
+
+	mClusterTexture = CreateDataTexture(mClustersX * mClustersY, mClustersZ, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32);
+	mLightIndexTexture = CreateDataTexture(lightIndexTextureWidth, indexRows, PIXELFORMAT_UNCOMPRESSED_R32);
+	mLightDataTexture = CreateDataTexture(2, mMaxLights, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32);
+}
+
+void Mistral::ClusteredForwardRenderPipeline::RenderEvent()
+{
+	BeginDrawing();
+
+	ClearBackground(RAYWHITE);
+
+	// The grid is rebuilt for every camera since clusters are laid out over its own view and viewport
+	CameraOutput output;
+	output.beginCamera = [this](const Camera3D& camera, const Rectangle& viewport) { BuildLightGrid(camera, viewport); };
+	RenderCameras(output);
+
+	ComponentRender2DEventCallback();
+
+	{ // ImGui space
+		rlImGuiBegin();
+
+		ComponentRenderGUIEventCallback();
+
+		rlImGuiEnd();
+	}
+
+	EndDrawing();
+}
+
+// Getters
+uint32_t Mistral::ClusteredForwardRenderPipeline::GetClusterCount() const
+{
+	return mClustersX * mClustersY * mClustersZ;
+}
+
+uint32_t Mistral::ClusteredForwardRenderPipeline::GetVisibleLightCount() const
+{
+	return mLightCount;
+}
+
+uint32_t Mistral::ClusteredForwardRenderPipeline::GetLightIndexCount() const
+{
+	return mLightIndexCount;
+}
+
+const Texture& Mistral::ClusteredForwardRenderPipeline::GetClusterTexture() const
+{
+	return mClusterTexture;
+}
+
+const Texture& Mistral::ClusteredForwardRenderPipeline::GetLightIndexTexture() const
+{
+	return mLightIndexTexture;
+}
+
+const Texture& Mistral::ClusteredForwardRenderPipeline::GetLightDataTexture() const
+{
+	return mLightDataTexture;
+}
+
+// Functionalities
+void Mistral::ClusteredForwardRenderPipeline::BuildLightGrid(const Camera3D& camera, const Rectangle& viewport)
+{
+	mViewport = viewport;
+
+	const float aspect = viewport.width / std::max(viewport.height, 1.f);
+	BuildClusterBounds(camera, aspect);
+
+	const Matrix4x4 view = Matrix4x4::LookAt(camera.position, camera.target, camera.up);
+
+	// Gather the lights in front of the camera, the grid only needs view-space positions
+	mLightX.clear();
+	mLightY.clear();
+	mLightZ.clear();
+	mLightRange.clear();
+	mLightCount = 0;
+
+	for (const auto& light : GetPointLightsView())
+	{
+		if (mLightCount >= mMaxLights)
+		{
+			break;
+		}
+
+		const Vec4 viewPosition = view * Vec4(light.position, 1.f);
+		if (viewPosition.z - light.range > 0.f || -viewPosition.z - light.range > mFarPlane)
+		{
+			continue;
+		}
+
+		mLightX.push_back(viewPosition.x);
+		mLightY.push_back(viewPosition.y);
+		mLightZ.push_back(viewPosition.z);
+		mLightRange.push_back(light.range);
+
+		float* data = &mLightData[static_cast<size_t>(mLightCount) * 8];
+		data[0] = light.position.x;
+		data[1] = light.position.y;
+		data[2] = light.position.z;
+		data[3] = light.range;
+		data[4] = light.color.r * light.intensity;
+		data[5] = light.color.g * light.intensity;
+		data[6] = light.color.b * light.intensity;
+		data[7] = 0.f;
+		mLightCount++;
+	}
+
+	const uint32_t clustersPerSlice = mClustersX * mClustersY;
+
+	ParallelFor(mClustersZ, 1, [this, clustersPerSlice](const uint32_t begin, const uint32_t end) {
+		SliceLights slice;
+
+		for (uint32_t sliceIndex = begin; sliceIndex < end; sliceIndex++)
+		{
+			// Keep only the lights whose depth range overlaps the slice before testing its clusters
+			const float sliceNear = mSliceDepths[sliceIndex];
+			const float sliceFar = mSliceDepths[sliceIndex + 1];
+
+			slice.indices.clear();
+			slice.x.clear();
+			slice.y.clear();
+			slice.z.clear();
+			slice.rangeSqr.clear();
+
+			for (uint32_t light = 0; light < mLightCount; light++)
+			{
+				const float depth = -mLightZ[light];
+				if (depth + mLightRange[light] < sliceNear || depth - mLightRange[light] > sliceFar)
+				{
+					continue;
+				}
+
+				slice.indices.push_back(static_cast<uint16_t>(light));
+				slice.x.push_back(mLightX[light]);
+				slice.y.push_back(mLightY[light]);
+				slice.z.push_back(mLightZ[light]);
+				slice.rangeSqr.push_back(mLightRange[light] * mLightRange[light]);
+			}
+
+			while (slice.x.size() % 4 != 0)
+			{
+				slice.indices.push_back(0);
+				slice.x.push_back(paddingLightPosition);
+				slice.y.push_back(paddingLightPosition);
+				slice.z.push_back(paddingLightPosition);
+				slice.rangeSqr.push_back(0.f);
+			}
+
+			for (uint32_t tile = 0; tile < clustersPerSlice; tile++)
+			{
+				const uint32_t cluster = sliceIndex * clustersPerSlice + tile;
+				uint16_t* out = &mClusterLights[static_cast<size_t>(cluster) * mMaxLightsPerCluster];
+				mClusterCounts[cluster] = IntersectClusterLights(slice, mClusterMin[cluster], mClusterMax[cluster], out, mMaxLightsPerCluster);
+			}
+		}
+	});
+
+	// Compact the fixed size cluster lists into a single index list
+	mLightIndexCount = 0;
+	for (uint32_t cluster = 0; cluster < GetClusterCount(); cluster++)
+	{
+		const uint32_t count = mClusterCounts[cluster];
+		const uint16_t* lights = &mClusterLights[static_cast<size_t>(cluster) * mMaxLightsPerCluster];
+
+		mClusterGrid[cluster * 4 + 0] = static_cast<float>(mLightIndexCount);
+		mClusterGrid[cluster * 4 + 1] = static_cast<float>(count);
+
+		for (uint32_t index = 0; index < count; index++)
+		{
+			mLightIndices[mLightIndexCount++] = lights[index];
+		}
+	}
+
+	UploadBuffers();
+}
+
+void Mistral::ClusteredForwardRenderPipeline::BindLightingUniforms(const Shader& shader) const
+{
+	const int dimensions[3] = {static_cast<int>(mClustersX), static_cast<int>(mClustersY), static_cast<int>(mClustersZ)};
+	const float logDepthRatio = std::log(mFarPlane / mNearPlane);
+	const float depthParams[4] = {mNearPlane, mFarPlane, static_cast<float>(mClustersZ) / logDepthRatio,
+								  -static_cast<float>(mClustersZ) * std::log(mNearPlane) / logDepthRatio};
+	const float viewport[4] = {mViewport.x, mViewport.y, mViewport.width, mViewport.height};
+	const int indexTextureWidth = lightIndexTextureWidth;
+
+	SetShaderValue(shader, GetShaderLocation(shader, "clusterDimensions"), dimensions, SHADER_UNIFORM_IVEC3);
+	SetShaderValue(shader, GetShaderLocation(shader, "clusterDepthParams"), depthParams, SHADER_UNIFORM_VEC4);
+	SetShaderValue(shader, GetShaderLocation(shader, "clusterViewport"), viewport, SHADER_UNIFORM_VEC4);
+	SetShaderValue(shader, GetShaderLocation(shader, "clusterIndexTextureWidth"), &indexTextureWidth, SHADER_UNIFORM_INT);
+
+	rlEnableShader(shader.id);
+	BindDataTexture(shader, "clusterGrid", mClusterTexture, clusterTextureSlot);
+	BindDataTexture(shader, "clusterLightIndices", mLightIndexTexture, lightIndexTextureSlot);
+	BindDataTexture(shader, "clusterLightData", mLightDataTexture, lightDataTextureSlot);
+	rlActiveTextureSlot(0);
+}
+
+const char* Mistral::ClusteredForwardRenderPipeline::GetLightingShaderCode()
+{
+	return R"(
+uniform sampler2D clusterGrid;
+uniform sampler2D clusterLightIndices;
+uniform sampler2D clusterLightData;
+uniform ivec3 clusterDimensions;
+uniform vec4 clusterDepthParams; // near, far, slice scale, slice bias
+uniform vec4 clusterViewport; // x, y, width, height in framebuffer pixels
+uniform int clusterIndexTextureWidth;
+
+int GetClusterIndex(vec2 fragCoord, float viewDepth)
+{
+	ivec2 tile = clamp(ivec2((fragCoord - clusterViewport.xy) / clusterViewport.zw * vec2(clusterDimensions.xy)), ivec2(0), clusterDimensions.xy - 1);
+	int slice = clamp(int(log(max(viewDepth, 1e-4)) * clusterDepthParams.z + clusterDepthParams.w), 0, clusterDimensions.z - 1);
+	return tile.x + tile.y * clusterDimensions.x + slice * clusterDimensions.x * clusterDimensions.y;
+}
+
+vec3 ComputeClusteredLighting(vec3 worldPosition, vec3 normal, float viewDepth)
+{
+	int cluster = GetClusterIndex(gl_FragCoord.xy, viewDepth);
+	int clustersPerSlice = clusterDimensions.x * clusterDimensions.y;
+	vec2 grid = texelFetch(clusterGrid, ivec2(cluster % clustersPerSlice, cluster / clustersPerSlice), 0).xy;
+
+	vec3 result = vec3(0.0);
+	for (int index = int(grid.x); index < int(grid.x + grid.y); index++)
+	{
+		int light = int(texelFetch(clusterLightIndices, ivec2(index % clusterIndexTextureWidth, index / clusterIndexTextureWidth), 0).r);
+		vec4 positionRange = texelFetch(clusterLightData, ivec2(0, light), 0);
+		vec3 color = texelFetch(clusterLightData, ivec2(1, light), 0).rgb;
+
+		vec3 toLight = positionRange.xyz - worldPosition;
+		float distance = length(toLight);
+		float attenuation = clamp(1.0 - distance / positionRange.w, 0.0, 1.0);
+		result += color * max(dot(normal, toLight / max(distance, 1e-4)), 0.0) * attenuation * attenuation;
+	}
+	return result;
+}
+)";
+}
+
+// Internal
+void Mistral::ClusteredForwardRenderPipeline::BuildClusterBounds(const Camera3D& camera, const float aspect)
+{
+	if (mBoundsFovY == camera.fovy && mBoundsAspect == aspect && mBoundsProjection == camera.projection)
+	{
+		return;
+	}
+
+	mBoundsFovY = camera.fovy;
+	mBoundsAspect = aspect;
+	mBoundsProjection = camera.projection;
+
+	// Exponential depth slices, the first one also covers the space between the camera and the near plane
+	mSliceDepths.resize(mClustersZ + 1);
+	for (uint32_t slice = 0; slice <= mClustersZ; slice++)
+	{
+		mSliceDepths[slice] = mNearPlane * std::pow(mFarPlane / mNearPlane, static_cast<float>(slice) / static_cast<float>(mClustersZ));
+	}
+	mSliceDepths[0] = 0.f;
+
+	const bool perspective = camera.projection == CAMERA_PERSPECTIVE;
+	const float tanHalfFov = std::tan(camera.fovy * DEG2RAD * .5f);
+	const auto halfHeightAt = [perspective, tanHalfFov, &camera](const float depth) {
+		return perspective ? depth * tanHalfFov : camera.fovy * .5f;
+	};
+
+	mClusterMin.resize(GetClusterCount());
+	mClusterMax.resize(GetClusterCount());
+
+	for (uint32_t slice = 0; slice < mClustersZ; slice++)
+	{
+		const float depthNear = mSliceDepths[slice];
+		const float depthFar = mSliceDepths[slice + 1];
+		const float halfHeightNear = halfHeightAt(depthNear);
+		const float halfHeightFar = halfHeightAt(depthFar);
+
+		for (uint32_t tileY = 0; tileY < mClustersY; tileY++)
+		{
+			const float ndcMinY = -1.f + 2.f * static_cast<float>(tileY) / static_cast<float>(mClustersY);
+			const float ndcMaxY = -1.f + 2.f * static_cast<float>(tileY + 1) / static_cast<float>(mClustersY);
+
+			for (uint32_t tileX = 0; tileX < mClustersX; tileX++)
+			{
+				const float ndcMinX = -1.f + 2.f * static_cast<float>(tileX) / static_cast<float>(mClustersX);
+				const float ndcMaxX = -1.f + 2.f * static_cast<float>(tileX + 1) / static_cast<float>(mClustersX);
+
+				const uint32_t cluster = (slice * mClustersY + tileY) * mClustersX + tileX;
+				mClusterMin[cluster] = {std::min(ndcMinX * halfHeightNear * aspect, ndcMinX * halfHeightFar * aspect),
+										std::min(ndcMinY * halfHeightNear, ndcMinY * halfHeightFar), -depthFar};
+				mClusterMax[cluster] = {std::max(ndcMaxX * halfHeightNear * aspect, ndcMaxX * halfHeightFar * aspect),
+										std::max(ndcMaxY * halfHeightNear, ndcMaxY * halfHeightFar), -depthNear};
+			}
+		}
+	}
+}
+
+void Mistral::ClusteredForwardRenderPipeline::UploadBuffers()
+{
+	UpdateTexture(mClusterTexture, mClusterGrid.data());
+
+	if (const uint32_t indexRows = (mLightIndexCount + lightIndexTextureWidth - 1) / lightIndexTextureWidth; indexRows > 0)
+	{
+		const Rectangle rows = {0.f, 0.f, static_cast<float>(lightIndexTextureWidth), static_cast<float>(indexRows)};
+		UpdateTextureRec(mLightIndexTexture, rows, mLightIndices.data());
+	}
+
+	if (mLightCount > 0)
+	{
+		const Rectangle rows = {0.f, 0.f, 2.f, static_cast<float>(mLightCount)};
+		UpdateTextureRec(mLightDataTexture, rows, mLightData.data());
+	}
+}
@@ -1,11 +1,19 @@
 #include "Color.h"
 
 #include <algorithm>
-#include <cassert>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <iostream>
 
+#include "Packed.h"
 #include "Vector.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define MISTRAL_COLOR_SSE
+#endif
+
 const Color4 Color4::White = {1.f, 1.f, 1.f, 1.f};
 const Color4 Color4::Black = {0.f, 0.f, 0.f, 1.f};
 const Color4 Color4::Transparent = {0.f, 0.f, 0.f, 0.f};
@@ -29,91 +37,210 @@ const Color4 Color4::Pink = {1.f, .75f, .8f, 1.f};
 const Color4 Color4::Lime = {.75f, 1.0f, 0.f, 1.f};
 const Color4 Color4::SkyBlue = {.53f, .81f, .92f, 1.f};
 
+// Images are reinterpreted as arrays of raylib colors, themselves as packed colors
+static_assert(sizeof(Color) == 4 && sizeof(ColorRGBA8) == 4);
+static_assert(sizeof(Color4) == 4 * sizeof(float));
+
+namespace
+{
+	constexpr float hsvEpsilon = 1e-20f; // Keeps black and grays from dividing by zero
+
+	// sRGB encoding clamps to [2^-13, 1), each of the 104 table entries covers 8 steps of the top mantissa bits of one exponent
+	constexpr uint32_t encodeMinimumBits = (127u - 13u) << 23;
+	constexpr uint32_t encodeMaximumBits = 0x3f7fffffu;
+	constexpr uint32_t encodeTableSize = 104;
+
+	// Branchless, channel n is v - v * s * clamp(min(k, 4 - k), 0, 1) with k = (n + 6h) mod 6, n being 5, 3 and 1 for red, green and blue
+	float HSVChannel(const float n, const float h, const float s, const float v)
+	{
+		const float shifted = n + h * 6.f;
+		const float k = shifted - 6.f * std::floor(shifted * (1.f / 6.f));
+		return v - v * s * std::clamp(std::min(k, 4.f - k), 0.f, 1.f);
+	}
+
+	const std::array<float, 256>& GetDecodeTable()
+	{
+		static const std::array<float, 256> table = [] {
+			std::array<float, 256> values;
+			for (uint32_t value = 0; value < 256; value++)
+			{
+				values[value] = SRGBToLinear(static_cast<float>(value) / 255.f);
+			}
+			return values;
+		}();
+		return table;
+	}
+
+	// Each entry holds a bias on its high 16 bits and a slope on its low 16 bits, least squares fits of the rounded sRGB value against the
+	// next 8 mantissa bits. The result lies within .55 of the exact value.
+	const std::array<uint32_t, encodeTableSize>& GetEncodeTable()
+	{
+		static const std::array<uint32_t, encodeTableSize> table = [] {
+			std::array<uint32_t, encodeTableSize> entries;
+			for (uint32_t entry = 0; entry < encodeTableSize; entry++)
+			{
+				const int exponent = static_cast<int>(entry / 8) - 13;
+				const double start = std::ldexp(1.0 + (entry % 8) / 8.0, exponent);
+				const double step = std::ldexp(1.0 / 8.0, exponent) / 256.0;
+
+				double sumT = 0.0, sumY = 0.0, sumTT = 0.0, sumTY = 0.0;
+				constexpr uint32_t samplesPerStep = 8;
+				for (uint32_t t = 0; t < 256; t++)
+				{
+					for (uint32_t sample = 0; sample < samplesPerStep; sample++)
+					{
+						const double linear = start + (t + (sample + .5) / samplesPerStep) * step;
+						const double srgb = linear <= .0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - .055;
+						const double y = srgb * 255.0 + .5;
+						sumT += t;
+						sumY += y;
+						sumTT += static_cast<double>(t) * t;
+						sumTY += t * y;
+					}
+				}
+
+				constexpr double sampleCount = 256.0 * samplesPerStep;
+				const double slope = (sampleCount * sumTY - sumT * sumY) / (sampleCount * sumTT - sumT * sumT);
+				const double intercept = (sumY - slope * sumT) / sampleCount;
+				entries[entry] = static_cast<uint32_t>(std::lround(intercept * 128.0)) << 16 | static_cast<uint32_t>(std::lround(slope * 65536.0));
+			}
+			return entries;
+		}();
+		return table;
+	}
+
+	uint8_t EncodeSRGBChannel(const std::array<uint32_t, encodeTableSize>& table, const float value)
+	{
+		const float minimum = std::bit_cast<float>(encodeMinimumBits);
+		const float maximum = std::bit_cast<float>(encodeMaximumBits);
+		const uint32_t bits = std::bit_cast<uint32_t>(std::min(value > minimum ? value : minimum, maximum)); // NaN goes to the minimum
+
+		const uint32_t entry = table[(bits - encodeMinimumBits) >> 20];
+		const uint32_t bias = (entry >> 16) << 9;
+		const uint32_t scale = entry & 0xffffu;
+		const uint32_t t = (bits >> 12) & 0xffu;
+		return static_cast<uint8_t>((bias + scale * t) >> 16);
+	}
+
+	uint8_t PremultiplyChannel(const uint32_t channel, const uint32_t alpha)
+	{
+		// Rounded division by 255, exact over the whole range of products
+		const uint32_t product = channel * alpha + 128u;
+		return static_cast<uint8_t>((product + (product >> 8)) >> 8);
+	}
+
+#if defined(MISTRAL_COLOR_SSE)
+	void LoadColor3x4(const float* values, __m128& r, __m128& g, __m128& b)
+	{
+		const __m128 first = _mm_loadu_ps(values);		// r0 g0 b0 r1
+		const __m128 second = _mm_loadu_ps(values + 4); // g1 b1 r2 g2
+		const __m128 third = _mm_loadu_ps(values + 8);	// b2 r3 g3 b3
+
+		r = _mm_shuffle_ps(first, _mm_shuffle_ps(second, third, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		g = _mm_shuffle_ps(_mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 0, 1, 1)), _mm_shuffle_ps(second, third, _MM_SHUFFLE(2, 2, 3, 3)),
+						   _MM_SHUFFLE(2, 0, 2, 0));
+		b = _mm_shuffle_ps(_mm_shuffle_ps(first, second, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(third, third, _MM_SHUFFLE(3, 3, 0, 0)),
+						   _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	void StoreColor3x4(float* values, const __m128 r, const __m128 g, const __m128 b)
+	{
+		_mm_storeu_ps(values, _mm_shuffle_ps(_mm_shuffle_ps(r, g, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(b, r, _MM_SHUFFLE(1, 1, 0, 0)),
+											 _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(values + 4, _mm_shuffle_ps(_mm_shuffle_ps(g, b, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(r, g, _MM_SHUFFLE(2, 2, 2, 2)),
+												 _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(values + 8, _mm_shuffle_ps(_mm_shuffle_ps(b, r, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(g, b, _MM_SHUFFLE(3, 3, 3, 3)),
+												 _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+
+	__m128 Select(const __m128 mask, const __m128 whenSet, const __m128 whenClear)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, whenClear));
+	}
+
+	// SSE2 has no rounding instruction, truncation is corrected for negative values
+	__m128 Floor(const __m128 value)
+	{
+		const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value));
+		return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, value), _mm_set1_ps(1.f)));
+	}
+
+	__m128 HSVChannel4(const float n, const __m128 h, const __m128 s, const __m128 v)
+	{
+		const __m128 shifted = _mm_add_ps(_mm_set1_ps(n), _mm_mul_ps(h, _mm_set1_ps(6.f)));
+		const __m128 k = _mm_sub_ps(shifted, _mm_mul_ps(_mm_set1_ps(6.f), Floor(_mm_mul_ps(shifted, _mm_set1_ps(1.f / 6.f)))));
+		const __m128 amount = _mm_max_ps(_mm_min_ps(_mm_min_ps(k, _mm_sub_ps(_mm_set1_ps(4.f), k)), _mm_set1_ps(1.f)), _mm_setzero_ps());
+		return _mm_sub_ps(v, _mm_mul_ps(_mm_mul_ps(v, s), amount));
+	}
+
+	void HSVToRGB4(const __m128 h, const __m128 s, const __m128 v, __m128& r, __m128& g, __m128& b)
+	{
+		r = HSVChannel4(5.f, h, s, v);
+		g = HSVChannel4(3.f, h, s, v);
+		b = HSVChannel4(1.f, h, s, v);
+	}
+
+	// Same steps as Color3::ToHSV with the swaps turned into selects
+	void RGBToHSV4(const __m128 r, const __m128 g, const __m128 b, __m128& h, __m128& s, __m128& v)
+	{
+		const __m128 swapGreenBlue = _mm_cmplt_ps(g, b);
+		const __m128 high = _mm_max_ps(g, b);
+		const __m128 low = _mm_min_ps(g, b);
+		__m128 k = _mm_and_ps(swapGreenBlue, _mm_set1_ps(-1.f));
+
+		const __m128 swapRedGreen = _mm_cmplt_ps(r, high);
+		const __m128 largest = _mm_max_ps(r, high);
+		const __m128 middle = Select(swapRedGreen, r, high);
+		k = Select(swapRedGreen, _mm_sub_ps(_mm_set1_ps(-1.f / 3.f), k), k);
+
+		const __m128 epsilon = _mm_set1_ps(hsvEpsilon);
+		const __m128 chroma = _mm_sub_ps(largest, _mm_min_ps(middle, low));
+		const __m128 hue = _mm_add_ps(k, _mm_div_ps(_mm_sub_ps(middle, low), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(6.f), chroma), epsilon)));
+		h = _mm_andnot_ps(_mm_set1_ps(-0.f), hue);
+		s = _mm_div_ps(chroma, _mm_add_ps(largest, epsilon));
+		v = largest;
+	}
+#endif
+} // namespace
+
 // Parametrized constructors
 Color3::Color3(const float r, const float g, const float b):
-	r(r),
-	g(g),
-	b(b)
+	components{r, g, b}
 {
 }
 
 Color3::Color3(const uint32_t r, const uint32_t g, const uint32_t b):
-	r(r / 255.0f),
-	g(g / 255.0f),
-	b(b / 255.0f)
+	components{r / 255.0f, g / 255.0f, b / 255.0f}
 {
 }
 
 Color3::Color3(const float value):
-	r(value),
-	g(value),
-	b(value)
+	components{value, value, value}
 {
 }
 
 // Copy constructors
 Color3::Color3(const Color4& color):
-	r(color.r),
-	g(color.g),
-	b(color.b)
+	components{color.r, color.g, color.b}
 {
 }
 
 Color3::Color3(const Vec3& vector):
-	r(vector.x),
-	g(vector.y),
-	b(vector.z)
+	components{vector.x, vector.y, vector.z}
 {
 }
 
 Color3::Color3(const Color& color):
-	r(color.r / 255.f),
-	g(color.g / 255.f),
-	b(color.b / 255.f)
+	components{color.r / 255.f, color.g / 255.f, color.b / 255.f}
 {
 }
 
 // Conversion operators
 Color3::operator Color() const
 {
-	return Color {static_cast<unsigned char>(std::clamp(r, 0.0f, 1.0f) * 255.f),
-				  static_cast<unsigned char>(std::clamp(g, 0.0f, 1.0f) * 255.f),
-				  static_cast<unsigned char>(std::clamp(b, 0.0f, 1.0f) * 255.f), 255};
-}
-
-// Access operators
-float& Color3::operator[](const std::size_t index)
-{
-	assert(index <= 2);
-	switch (index)
-	{
-		case 0:
-			return r;
-		case 1:
-			return g;
-		case 2:
-			return b;
-		default:
-			break;
-	}
-	return r;
-}
-
-float Color3::operator[](const std::size_t index) const
-{
-	assert(index <= 2);
-	switch (index)
-	{
-		case 0:
-			return r;
-		case 1:
-			return g;
-		case 2:
-			return b;
-		default:
-			break;
-	}
-	return r;
+	return Color {static_cast<unsigned char>(std::nearbyint(std::clamp(r, 0.0f, 1.0f) * 255.f)),
+				  static_cast<unsigned char>(std::nearbyint(std::clamp(g, 0.0f, 1.0f) * 255.f)),
+				  static_cast<unsigned char>(std::nearbyint(std::clamp(b, 0.0f, 1.0f) * 255.f)), 255};
 }
 
 // Compound assignment operators
@@ -306,68 +433,31 @@ Color3 Color3::Lerp(const Color3& target, const float amount) const
 }
 
 // Color functionalities
-Color3 Color3::HSV(const float h, const float s, const float v)
-{
-	// Code by Alejandro Hitti from:
-	// https://alejandrohitti.com/2015/06/29/rgb-hsv-color-conversions/
-	Color3 RGB;
-
-	// Achromatic (gray)
-	if (s == 0)
+Color3 Color3::ToHSV() const
+{
+	// Sam Hocevar's sort, the channels are ordered with at most two swaps and the hue offset follows them
+	float red = r;
+	float green = g;
+	float blue = b;
+	float k = 0.f;
+	if (green < blue)
 	{
-		RGB.r = RGB.g = RGB.b = v;
-		return RGB;
+		std::swap(green, blue);
+		k = -1.f;
 	}
-
-	// Conversion values
-	const float tempH = h * 6.f;
-	const float hueSection = std::floor(tempH);
-	const float f = tempH - hueSection;
-	const float p = v * (1 - s);
-	const float q = v * (1 - s * f);
-	const float t = v * (1 - s * (1 - f));
-
-	// There are 6 cases, one for every 60 degrees
-	switch (static_cast<int>(hueSection))
+	if (red < green)
 	{
-		case 0:
-			RGB.r = v;
-			RGB.g = t;
-			RGB.b = p;
-			break;
-
-		case 1:
-			RGB.r = q;
-			RGB.g = v;
-			RGB.b = p;
-			break;
-
-		case 2:
-			RGB.r = p;
-			RGB.g = v;
-			RGB.b = t;
-			break;
-
-		case 3:
-			RGB.r = p;
-			RGB.g = q;
-			RGB.b = v;
-			break;
-
-		case 4:
-			RGB.r = t;
-			RGB.g = p;
-			RGB.b = v;
-			break;
-
-		default:
-			RGB.r = v;
-			RGB.g = p;
-			RGB.b = q;
-			break;
+		std::swap(red, green);
+		k = -1.f / 3.f - k;
 	}
 
-	return RGB;
+	const float chroma = red - std::min(green, blue);
+	return {std::fabs(k + (green - blue) / (6.f * chroma + hsvEpsilon)), chroma / (red + hsvEpsilon), red};
+}
+
+Color3 Color3::HSV(const float h, const float s, const float v)
+{
+	return {HSVChannel(5.f, h, s, v), HSVChannel(3.f, h, s, v), HSVChannel(1.f, h, s, v)};
 }
 
 Color3 Color3::HSV(const uint32_t h, const uint32_t s, const uint32_t v)
@@ -377,108 +467,48 @@ Color3 Color3::HSV(const uint32_t h, const uint32_t s, const uint32_t v)
 
 // Parametrized constructors
 Color4::Color4(const float r, const float g, const float b, const float a):
-	r(r),
-	g(g),
-	b(b),
-	a(a)
+	components{r, g, b, a}
 {
 }
 
 Color4::Color4(const uint32_t r, const uint32_t g, const uint32_t b, const uint32_t a):
-	r(r / 255.0f),
-	g(g / 255.0f),
-	b(b / 255.0f),
-	a(a / 255.0f)
+	components{r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f}
 {
 }
 
 Color4::Color4(const float value):
-	r(value),
-	g(value),
-	b(value),
-	a(1.f)
+	components{value, value, value, 1.f}
 {
 }
 
 Color4::Color4(const float value, const float alpha):
-	r(value),
-	g(value),
-	b(value),
-	a(alpha)
+	components{value, value, value, alpha}
 {
 }
 
 // Copy constructors
 Color4::Color4(const Color3& color, const float a):
-	r(color.r),
-	g(color.g),
-	b(color.b),
-	a(a)
+	components{color.r, color.g, color.b, a}
 {
 }
 
 Color4::Color4(const Vec4& vector):
-	r(vector.x),
-	g(vector.y),
-	b(vector.z),
-	a(vector.w)
+	components{vector.x, vector.y, vector.z, vector.w}
 {
 }
 
 Color4::Color4(const Color& color):
-	r(color.r / 255.f),
-	g(color.g / 255.f),
-	b(color.b / 255.f),
-	a(color.a / 255.f)
+	components{color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f}
 {
 }
 
 // Conversion operators
 Color4::operator Color() const
 {
-	return Color {static_cast<unsigned char>(std::clamp(r, 0.0f, 1.0f) * 255.f),
-				  static_cast<unsigned char>(std::clamp(g, 0.0f, 1.0f) * 255.f),
-				  static_cast<unsigned char>(std::clamp(b, 0.0f, 1.0f) * 255.f),
-				  static_cast<unsigned char>(std::clamp(a, 0.0f, 1.0f) * 255.f)};
-}
-
-// Access operators
-float& Color4::operator[](const std::size_t index)
-{
-	assert(index <= 3);
-	switch (index)
-	{
-		case 0:
-			return r;
-		case 1:
-			return g;
-		case 2:
-			return b;
-		case 3:
-			return a;
-		default:
-			break;
-	}
-	return r;
-}
-
-float Color4::operator[](const std::size_t index) const
-{
-	assert(index <= 3);
-	switch (index)
-	{
-		case 0:
-			return r;
-		case 1:
-			return g;
-		case 2:
-			return b;
-		case 3:
-			return a;
-		default:
-			break;
-	}
-	return r;
+	return Color {static_cast<unsigned char>(std::nearbyint(std::clamp(r, 0.0f, 1.0f) * 255.f)),
+				  static_cast<unsigned char>(std::nearbyint(std::clamp(g, 0.0f, 1.0f) * 255.f)),
+				  static_cast<unsigned char>(std::nearbyint(std::clamp(b, 0.0f, 1.0f) * 255.f)),
+				  static_cast<unsigned char>(std::nearbyint(std::clamp(a, 0.0f, 1.0f) * 255.f))};
 }
 
 // Compound assignment operators
@@ -688,13 +718,18 @@ Color4 Color4::Lerp(const Color4& target, const float amount) const
 
 uint32_t Color4::ToUInt32() const
 {
-	auto R = static_cast<uint32_t>(std::clamp(r, 0.0f, 1.0f) * 255.f);
-	auto G = static_cast<uint32_t>(std::clamp(g, 0.0f, 1.0f) * 255.f);
-	auto B = static_cast<uint32_t>(std::clamp(b, 0.0f, 1.0f) * 255.f);
-	auto A = static_cast<uint32_t>(std::clamp(a, 0.0f, 1.0f) * 255.f);
+	auto R = static_cast<uint32_t>(std::nearbyint(std::clamp(r, 0.0f, 1.0f) * 255.f));
+	auto G = static_cast<uint32_t>(std::nearbyint(std::clamp(g, 0.0f, 1.0f) * 255.f));
+	auto B = static_cast<uint32_t>(std::nearbyint(std::clamp(b, 0.0f, 1.0f) * 255.f));
+	auto A = static_cast<uint32_t>(std::nearbyint(std::clamp(a, 0.0f, 1.0f) * 255.f));
 	return R | (G << 8) | (B << 16) | (A << 24);
 }
 
+Color4 Color4::ToHSVA() const
+{
+	return Color4(Color3(*this).ToHSV(), a);
+}
+
 // Color functionalities
 Color4 Color4::Grey(float value, float alpha)
 {
@@ -715,4 +750,357 @@ Color4 Color4::HSVA(const uint32_t h, const uint32_t s, const uint32_t v,
 Color4 Color4::WithAlpha(float alpha) const
 {
 	return {r, g, b, alpha};
-}
\ No newline at end of file
+}
+// sRGB transfer function
+float SRGBToLinear(const float value)
+{
+	return value <= .04045f ? value / 12.92f : std::pow((value + .055f) / 1.055f, 2.4f);
+}
+
+float LinearToSRGB(const float value)
+{
+	return value <= .0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.f / 2.4f) - .055f;
+}
+
+// Bulk conversions
+void ConvertHSVToRGB(const std::span<const Color3> hsv, const std::span<Color3> rgb)
+{
+	const size_t count = std::min(hsv.size(), rgb.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_COLOR_SSE)
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 h, s, v, r, g, b;
+		LoadColor3x4(reinterpret_cast<const float*>(hsv.data() + index), h, s, v);
+		HSVToRGB4(h, s, v, r, g, b);
+		StoreColor3x4(reinterpret_cast<float*>(rgb.data() + index), r, g, b);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		rgb[index] = Color3::HSV(hsv[index].r, hsv[index].g, hsv[index].b);
+	}
+}
+
+void ConvertHSVToRGB(const std::span<const Color4> hsv, const std::span<Color4> rgb)
+{
+	const size_t count = std::min(hsv.size(), rgb.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_COLOR_SSE)
+	for (; index + 4 <= count; index += 4)
+	{
+		const float* values = reinterpret_cast<const float*>(hsv.data() + index);
+		__m128 h = _mm_loadu_ps(values);
+		__m128 s = _mm_loadu_ps(values + 4);
+		__m128 v = _mm_loadu_ps(values + 8);
+		__m128 a = _mm_loadu_ps(values + 12);
+		_MM_TRANSPOSE4_PS(h, s, v, a);
+
+		__m128 r, g, b;
+		HSVToRGB4(h, s, v, r, g, b);
+		_MM_TRANSPOSE4_PS(r, g, b, a);
+
+		float* results = reinterpret_cast<float*>(rgb.data() + index);
+		_mm_storeu_ps(results, r);
+		_mm_storeu_ps(results + 4, g);
+		_mm_storeu_ps(results + 8, b);
+		_mm_storeu_ps(results + 12, a);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		rgb[index] = Color4::HSVA(hsv[index].r, hsv[index].g, hsv[index].b, hsv[index].a);
+	}
+}
+
+void ConvertRGBToHSV(const std::span<const Color3> rgb, const std::span<Color3> hsv)
+{
+	const size_t count = std::min(rgb.size(), hsv.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_COLOR_SSE)
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 r, g, b, h, s, v;
+		LoadColor3x4(reinterpret_cast<const float*>(rgb.data() + index), r, g, b);
+		RGBToHSV4(r, g, b, h, s, v);
+		StoreColor3x4(reinterpret_cast<float*>(hsv.data() + index), h, s, v);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		hsv[index] = rgb[index].ToHSV();
+	}
+}
+
+void ConvertRGBToHSV(const std::span<const Color4> rgb, const std::span<Color4> hsv)
+{
+	const size_t count = std::min(rgb.size(), hsv.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_COLOR_SSE)
+	for (; index + 4 <= count; index += 4)
+	{
+		const float* values = reinterpret_cast<const float*>(rgb.data() + index);
+		__m128 r = _mm_loadu_ps(values);
+		__m128 g = _mm_loadu_ps(values + 4);
+		__m128 b = _mm_loadu_ps(values + 8);
+		__m128 a = _mm_loadu_ps(values + 12);
+		_MM_TRANSPOSE4_PS(r, g, b, a);
+
+		__m128 h, s, v;
+		RGBToHSV4(r, g, b, h, s, v);
+		_MM_TRANSPOSE4_PS(h, s, v, a);
+
+		float* results = reinterpret_cast<float*>(hsv.data() + index);
+		_mm_storeu_ps(results, h);
+		_mm_storeu_ps(results + 4, s);
+		_mm_storeu_ps(results + 8, v);
+		_mm_storeu_ps(results + 12, a);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		hsv[index] = rgb[index].ToHSVA();
+	}
+}
+
+void DecodeSRGB(const std::span<const Color> srgb, const std::span<Color4> linear)
+{
+	const size_t count = std::min(srgb.size(), linear.size());
+	const std::array<float, 256>& table = GetDecodeTable();
+
+	constexpr float alphaScale = 1.f / 255.f;
+	for (size_t index = 0; index < count; index++)
+	{
+		const Color& color = srgb[index];
+		linear[index] = {table[color.r], table[color.g], table[color.b], static_cast<float>(color.a) * alphaScale};
+	}
+}
+
+void EncodeSRGB(const std::span<const Color4> linear, const std::span<Color> srgb)
+{
+	const size_t count = std::min(linear.size(), srgb.size());
+	const std::array<uint32_t, encodeTableSize>& table = GetEncodeTable();
+	size_t index = 0;
+
+#if defined(MISTRAL_COLOR_SSE)
+	const __m128 minimum = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(encodeMinimumBits)));
+	const __m128 maximum = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(encodeMaximumBits)));
+	const __m128i alphaMask = _mm_setr_epi32(0, 0, 0, -1);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 scale = _mm_set1_ps(255.f);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		const float* values = reinterpret_cast<const float*>(linear.data() + index);
+
+		__m128i quantized[4];
+		for (uint32_t color = 0; color < 4; color++)
+		{
+			const __m128 value = _mm_loadu_ps(values + color * 4);
+			const __m128i bits = _mm_castps_si128(_mm_min_ps(_mm_max_ps(value, minimum), maximum)); // NaN goes to the minimum
+
+			alignas(16) uint32_t entries[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(entries), _mm_srli_epi32(_mm_sub_epi32(bits, _mm_castps_si128(minimum)), 20));
+			const __m128i entry = _mm_setr_epi32(static_cast<int>(table[entries[0]]), static_cast<int>(table[entries[1]]),
+												 static_cast<int>(table[entries[2]]), 0);
+
+			// Slopes and steps both fit 16 bits, their product comes out of a single multiply-add
+			const __m128i bias = _mm_slli_epi32(_mm_srli_epi32(entry, 16), 9);
+			const __m128i slope = _mm_and_si128(entry, _mm_set1_epi32(0xffff));
+			const __m128i step = _mm_and_si128(_mm_srli_epi32(bits, 12), _mm_set1_epi32(0xff));
+			const __m128i channels = _mm_srli_epi32(_mm_add_epi32(bias, _mm_madd_epi16(slope, step)), 16);
+
+			const __m128i alpha = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(value, one), zero), scale));
+			quantized[color] = _mm_or_si128(_mm_andnot_si128(alphaMask, channels), _mm_and_si128(alphaMask, alpha));
+		}
+
+		const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(quantized[0], quantized[1]), _mm_packs_epi32(quantized[2], quantized[3]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(srgb.data() + index), bytes);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		const Color4& color = linear[index];
+		srgb[index] = {EncodeSRGBChannel(table, color.r), EncodeSRGBChannel(table, color.g), EncodeSRGBChannel(table, color.b),
+					   static_cast<unsigned char>(std::nearbyint(std::clamp(color.a, 0.f, 1.f) * 255.f))};
+	}
+}
+
+void PremultiplyAlpha(const std::span<Color4> colors)
+{
+	size_t index = 0;
+
+#if defined(MISTRAL_COLOR_SSE)
+	const __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (; index < colors.size(); index++)
+	{
+		float* values = reinterpret_cast<float*>(colors.data() + index);
+		const __m128 color = _mm_loadu_ps(values);
+		const __m128 alpha = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3));
+		_mm_storeu_ps(values, _mm_mul_ps(color, Select(alphaMask, one, alpha)));
+	}
+#endif
+
+	for (; index < colors.size(); index++)
+	{
+		Color4& color = colors[index];
+		color.r *= color.a;
+		color.g *= color.a;
+		color.b *= color.a;
+	}
+}
+
+void UnpremultiplyAlpha(const std::span<Color4> colors)
+{
+	size_t index = 0;
+
+#if defined(MISTRAL_COLOR_SSE)
+	const __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+
+	for (; index < colors.size(); index++)
+	{
+		float* values = reinterpret_cast<float*>(colors.data() + index);
+		const __m128 color = _mm_loadu_ps(values);
+		const __m128 alpha = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3));
+		const __m128 inverse = _mm_and_ps(_mm_cmpgt_ps(alpha, zero), _mm_div_ps(one, alpha));
+		_mm_storeu_ps(values, _mm_mul_ps(color, Select(alphaMask, one, inverse)));
+	}
+#endif
+
+	for (; index < colors.size(); index++)
+	{
+		Color4& color = colors[index];
+		const float inverse = color.a > 0.f ? 1.f / color.a : 0.f;
+		color.r *= inverse;
+		color.g *= inverse;
+		color.b *= inverse;
+	}
+}
+
+void PremultiplyAlpha(const std::span<Color> colors)
+{
+	size_t index = 0;
+
+#if defined(MISTRAL_COLOR_SSE)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i half = _mm_set1_epi16(128);
+	const __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+
+	for (; index + 4 <= colors.size(); index += 4)
+	{
+		__m128i* values = reinterpret_cast<__m128i*>(colors.data() + index);
+		const __m128i bytes = _mm_loadu_si128(values);
+
+		__m128i words[2] = {_mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero)};
+		for (__m128i& word : words)
+		{
+			const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(word, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			const __m128i product = _mm_add_epi16(_mm_mullo_epi16(word, alpha), half);
+			const __m128i divided = _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+			word = _mm_or_si128(_mm_andnot_si128(alphaMask, divided), _mm_and_si128(alphaMask, word));
+		}
+
+		_mm_storeu_si128(values, _mm_packus_epi16(words[0], words[1]));
+	}
+#endif
+
+	for (; index < colors.size(); index++)
+	{
+		Color& color = colors[index];
+		color.r = PremultiplyChannel(color.r, color.a);
+		color.g = PremultiplyChannel(color.g, color.a);
+		color.b = PremultiplyChannel(color.b, color.a);
+	}
+}
+
+// Images
+std::vector<Color4> DecodeImage(const Image& image, const bool srgb)
+{
+	Image converted = image;
+	const bool copied = image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+	if (copied)
+	{
+		converted = ImageCopy(image);
+		ImageFormat(&converted, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+	}
+
+	std::vector<Color4> pixels;
+	if (converted.data != nullptr && converted.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+	{
+		pixels.resize(static_cast<size_t>(converted.width) * converted.height);
+		const Color* colors = static_cast<const Color*>(converted.data);
+		if (srgb)
+		{
+			DecodeSRGB({colors, pixels.size()}, pixels);
+		}
+		else
+		{
+			DecodeColors({reinterpret_cast<const ColorRGBA8*>(colors), pixels.size()}, pixels);
+		}
+	}
+	else
+	{
+		std::cerr << "[Error] Image could not be decoded, its pixel format can't be converted to RGBA8" << std::endl;
+	}
+
+	if (copied)
+	{
+		UnloadImage(converted);
+	}
+	return pixels;
+}
+
+void EncodeImage(const std::span<const Color4> pixels, Image& image, const bool srgb)
+{
+	if (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+	{
+		ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+	}
+
+	const size_t count = static_cast<size_t>(image.width) * image.height;
+	if (image.data == nullptr || image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || pixels.size() != count)
+	{
+		std::cerr << "[Error] Image could not be encoded, expected " << count << " pixels in RGBA8 and got " << pixels.size() << std::endl;
+		return;
+	}
+
+	Color* colors = static_cast<Color*>(image.data);
+	if (srgb)
+	{
+		EncodeSRGB(pixels, {colors, count});
+	}
+	else
+	{
+		EncodeColors(pixels, {reinterpret_cast<ColorRGBA8*>(colors), count});
+	}
+}
+
+void PremultiplyImageAlpha(Image& image)
+{
+	if (image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+	{
+		ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+	}
+
+	if (image.data == nullptr || image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+	{
+		std::cerr << "[Error] Image alpha could not be premultiplied, its pixel format can't be converted to RGBA8" << std::endl;
+		return;
+	}
+
+	PremultiplyAlpha({static_cast<Color*>(image.data), static_cast<size_t>(image.width) * image.height});
+}
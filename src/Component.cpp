@@ -3,7 +3,12 @@
 #include <ranges>
 #include <vector>
 
+#include "Cameras.h"
+#include "DebugDraw.h"
+#include "DynamicBvh.h"
+#include "Occlusion.h"
 #include "Random.h"
+#include "SpriteBatch.h"
 
 static std::map<std::string, std::shared_ptr<Mistral::Component>, std::less<>> components;
 static std::vector<std::string> createList;
@@ -62,11 +67,21 @@ bool Mistral::Component::HasChildren() const
 	return !mChildren.empty();
 }
 
+uint32_t Mistral::Component::GetLayerMask() const
+{
+	return mLayerMask;
+}
+
 void Mistral::Component::SetName(const std::string& name)
 {
 	mName = name;
 }
 
+void Mistral::Component::SetLayerMask(const uint32_t layerMask)
+{
+	mLayerMask = layerMask;
+}
+
 void Mistral::Component::SetParent(Component* parent)
 {
 	if (mParent == parent)
@@ -182,6 +197,7 @@ void Mistral::ComponentDestroyEventCallback()
 	for (const auto& componentId : destroyList)
 	{
 		components[componentId]->DestroyEvent();
+		RemoveComponentFromBvh(components[componentId].get());
 		components.erase(componentId);
 	}
 	destroyList.clear();
@@ -205,18 +221,43 @@ void Mistral::ComponentFixedUpdateEventCallback()
 
 void Mistral::ComponentRender3DEventCallback()
 {
+	// Already culled by the camera being rendered
+	if (const auto visibleComponents = GetRenderingCameraComponents())
+	{
+		for (const auto component : *visibleComponents)
+		{
+			component->Render3DEvent();
+		}
+
+		DebugDrawRender();
+		return;
+	}
+
+	const bool occlusionCulling = IsOcclusionCullingEnabled();
+
 	for (const auto& component : components | std::views::values)
 	{
+		if (BoundingBox bounds; occlusionCulling && component->GetBounds(bounds) && IsOccluded(bounds))
+		{
+			continue;
+		}
+
 		component->Render3DEvent();
 	}
+
+	DebugDrawRender();
 }
 
 void Mistral::ComponentRender2DEventCallback()
 {
+	ResetSpriteBatchStats();
+
 	for (const auto& component : components | std::views::values)
 	{
 		component->Render2DEvent();
 	}
+
+	FlushSprites();
 }
 
 void Mistral::ComponentRenderGUIEventCallback()
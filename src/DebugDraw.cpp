@@ -0,0 +1,207 @@
+#include "DebugDraw.h"
+
+#if defined(MISTRAL_DEBUG_DRAW)
+
+	#include <cmath>
+	#include <vector>
+
+	#include "Color.h"
+	#include "rlgl.h"
+
+namespace
+{
+	// Lines only need two of the four vertices rlgl reserves per element, so a buffer holds twice as many lines
+	constexpr int batchBufferCount = 2;
+	constexpr int batchElementCount = 32768;
+
+	constexpr int sphereSegments = 24;
+
+	struct DebugLine
+	{
+		Vec3 start;
+		Vec3 end;
+		Color color;
+		float remaining;
+	};
+
+	std::vector<DebugLine> depthLines;
+	std::vector<DebugLine> overlayLines;
+	rlRenderBatch batch = {};
+	bool batchLoaded = false;
+
+	// Unit circle shared by every sphere
+	struct CircleTable
+	{
+		float cos[sphereSegments + 1];
+		float sin[sphereSegments + 1];
+
+		CircleTable()
+		{
+			for (int segment = 0; segment <= sphereSegments; segment++)
+			{
+				const float angle = static_cast<float>(segment) / static_cast<float>(sphereSegments) * 2.f * PI;
+				cos[segment] = std::cos(angle);
+				sin[segment] = std::sin(angle);
+			}
+		}
+	};
+
+	void EmitLines(const std::vector<DebugLine>& lines)
+	{
+		rlBegin(RL_LINES);
+		for (const DebugLine& line : lines)
+		{
+			rlColor4ub(line.color.r, line.color.g, line.color.b, line.color.a);
+			rlVertex3f(line.start.x, line.start.y, line.start.z);
+			rlVertex3f(line.end.x, line.end.y, line.end.z);
+		}
+		rlEnd();
+	}
+
+	void AgeLines(std::vector<DebugLine>& lines, const float deltaTime)
+	{
+		std::erase_if(lines, [deltaTime](DebugLine& line) {
+			line.remaining -= deltaTime;
+			return line.remaining < 0.f;
+		});
+	}
+} // namespace
+
+void Mistral::DebugDrawLine(const Vec3& start, const Vec3& end, const Color color, const float duration, const bool depthTest)
+{
+	(depthTest ? depthLines : overlayLines).push_back({start, end, color, duration});
+}
+
+void Mistral::DebugDrawAxes(const Matrix4x4& transform, const float size, const float duration, const bool depthTest)
+{
+	// The basis is read once from the matrix columns instead of decomposing a rotation per axis
+	const Vec3 origin = {transform.m12, transform.m13, transform.m14};
+	const Vec3 axes[3] = {{transform.m0, transform.m1, transform.m2}, {transform.m4, transform.m5, transform.m6}, {transform.m8, transform.m9, transform.m10}};
+	const Color colors[3] = {Color4::Red, Color4::Green, Color4::Blue};
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const Vec3 tip = origin + axes[axis] * size;
+		DebugDrawLine(origin, tip, colors[axis], duration, depthTest);
+
+		// Arrow head made of two lines along the next axes
+		const Vec3 back = tip - axes[axis] * (size * .2f);
+		const Vec3 side = axes[(axis + 1) % 3].Normalized() * (size * .08f);
+		const Vec3 other = axes[(axis + 2) % 3].Normalized() * (size * .08f);
+		DebugDrawLine(tip, back + side, colors[axis], duration, depthTest);
+		DebugDrawLine(tip, back - side, colors[axis], duration, depthTest);
+		DebugDrawLine(tip, back + other, colors[axis], duration, depthTest);
+		DebugDrawLine(tip, back - other, colors[axis], duration, depthTest);
+	}
+}
+
+void Mistral::DebugDrawBox(const BoundingBox& box, const Color color, const float duration, const bool depthTest)
+{
+	const Vec3 center = (Vec3(box.min) + Vec3(box.max)) * .5f;
+	const Vec3 halfExtents = (Vec3(box.max) - Vec3(box.min)) * .5f;
+	DebugDrawBox(Matrix4x4(halfExtents.x, 0.f, 0.f, 0.f, 0.f, halfExtents.y, 0.f, 0.f, 0.f, 0.f, halfExtents.z, 0.f, center.x, center.y, center.z, 1.f),
+				 color, duration, depthTest);
+}
+
+void Mistral::DebugDrawBox(const Matrix4x4& transform, const Color color, const float duration, const bool depthTest)
+{
+	Vec3 corners[8];
+	for (int corner = 0; corner < 8; corner++)
+	{
+		const Vec4 point = transform * Vec4(corner & 1 ? 1.f : -1.f, corner & 2 ? 1.f : -1.f, corner & 4 ? 1.f : -1.f, 1.f);
+		corners[corner] = {point.x, point.y, point.z};
+	}
+
+	// Every edge joins two corners differing by a single bit
+	for (int corner = 0; corner < 8; corner++)
+	{
+		for (int bit = 1; bit < 8; bit <<= 1)
+		{
+			if ((corner & bit) == 0)
+			{
+				DebugDrawLine(corners[corner], corners[corner | bit], color, duration, depthTest);
+			}
+		}
+	}
+}
+
+void Mistral::DebugDrawSphere(const Vec3& center, const float radius, const Color color, const float duration, const bool depthTest)
+{
+	static const CircleTable circle;
+
+	auto& lines = depthTest ? depthLines : overlayLines;
+	for (int segment = 0; segment < sphereSegments; segment++)
+	{
+		const float cos0 = circle.cos[segment] * radius;
+		const float sin0 = circle.sin[segment] * radius;
+		const float cos1 = circle.cos[segment + 1] * radius;
+		const float sin1 = circle.sin[segment + 1] * radius;
+
+		lines.push_back({center + Vec3(cos0, sin0, 0.f), center + Vec3(cos1, sin1, 0.f), color, duration});
+		lines.push_back({center + Vec3(cos0, 0.f, sin0), center + Vec3(cos1, 0.f, sin1), color, duration});
+		lines.push_back({center + Vec3(0.f, cos0, sin0), center + Vec3(0.f, cos1, sin1), color, duration});
+	}
+}
+
+void Mistral::DebugDrawRender()
+{
+	if (depthLines.empty() && overlayLines.empty())
+	{
+		return;
+	}
+
+	if (!batchLoaded)
+	{
+		batch = rlLoadRenderBatch(batchBufferCount, batchElementCount);
+		batchLoaded = true;
+	}
+
+	// Switching batches draws what was pending in the default one first
+	rlSetRenderBatchActive(&batch);
+
+	EmitLines(depthLines);
+
+	if (!overlayLines.empty())
+	{
+		rlDrawRenderBatchActive();
+		rlDisableDepthTest();
+
+		EmitLines(overlayLines);
+
+		rlDrawRenderBatchActive();
+		rlEnableDepthTest();
+	}
+
+	rlSetRenderBatchActive(nullptr);
+}
+
+void Mistral::DebugDrawEndFrame(const float deltaTime)
+{
+	AgeLines(depthLines, deltaTime);
+	AgeLines(overlayLines, deltaTime);
+}
+
+void Mistral::DebugDrawClear()
+{
+	depthLines.clear();
+	overlayLines.clear();
+}
+
+void Mistral::UnloadDebugDraw()
+{
+	DebugDrawClear();
+
+	if (batchLoaded)
+	{
+		rlUnloadRenderBatch(batch);
+		batch = {};
+		batchLoaded = false;
+	}
+}
+
+uint32_t Mistral::GetDebugDrawLineCount()
+{
+	return depthLines.size() + overlayLines.size();
+}
+
+#endif
@@ -1,36 +1,47 @@
 #include "DefaultRenderPipeline.h"
 
+#include "Cameras.h"
 #include "Mistral.h"
 #include "raylib.h"
 
 void Mistral::DefaultRenderPipeline::Initialize()
 {
-}
+	const RenderGraphResource backbuffer = mRenderGraph.GetBackbuffer();
 
-void Mistral::DefaultRenderPipeline::RenderEvent()
-{
-	BeginDrawing();
+	mRenderGraph.AddPass(
+		"Scene3D", [backbuffer](RenderGraphBuilder& builder) { builder.Write(backbuffer); },
+		[](const RenderGraph&) {
+			ClearBackground(RAYWHITE);
 
-	ClearBackground(RAYWHITE);
+			RenderCameras();
+		});
 
-	if (const auto camera = GetActiveCamera())
-	{
-		BeginMode3D(*camera);
+	mRenderGraph.AddPass(
+		"Scene2D", [backbuffer](RenderGraphBuilder& builder) { builder.Write(backbuffer); },
+		[](const RenderGraph&) { ComponentRender2DEventCallback(); });
 
-		ComponentRender3DEventCallback();
+	mRenderGraph.AddPass(
+		"GUI", [backbuffer](RenderGraphBuilder& builder) { builder.Write(backbuffer); },
+		[](const RenderGraph&) {
+			rlImGuiBegin();
 
-		EndMode3D();
-	}
+			ComponentRenderGUIEventCallback();
 
-	ComponentRender2DEventCallback();
-
-	{ // ImGui space
-		rlImGuiBegin();
+			rlImGuiEnd();
+		});
+}
 
-		ComponentRenderGUIEventCallback();
+void Mistral::DefaultRenderPipeline::RenderEvent()
+{
+	BeginDrawing();
 
-		rlImGuiEnd();
-	}
+	mRenderGraph.Execute();
 
 	EndDrawing();
-}
\ No newline at end of file
+}
+
+// Getters
+const Mistral::RenderGraph& Mistral::DefaultRenderPipeline::GetRenderGraph() const
+{
+	return mRenderGraph;
+}
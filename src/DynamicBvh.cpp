@@ -0,0 +1,719 @@
+#include "DynamicBvh.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <queue>
+#include <unordered_map>
+
+#include "Component.h"
+#include "JobSystem.h"
+
+namespace
+{
+	constexpr uint32_t batchChunkSize = 32;
+
+	struct IndexedComponent
+	{
+		uint32_t proxy;
+		bool seen;
+	};
+
+	Mistral::DynamicBvh componentBvh;
+	std::unordered_map<const Mistral::Component*, IndexedComponent> indexedComponents;
+
+	BoundingBox Union(const BoundingBox& a, const BoundingBox& b)
+	{
+		return {{std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)},
+				{std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)}};
+	}
+
+	// Half the surface area, only ever compared
+	float Area(const BoundingBox& box)
+	{
+		const float x = box.max.x - box.min.x;
+		const float y = box.max.y - box.min.y;
+		const float z = box.max.z - box.min.z;
+		return x * y + y * z + z * x;
+	}
+
+	bool Contains(const BoundingBox& outer, const BoundingBox& inner)
+	{
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z && inner.max.x <= outer.max.x &&
+			   inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+	}
+
+	bool Overlaps(const BoundingBox& a, const BoundingBox& b)
+	{
+		return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y && a.min.z <= b.max.z &&
+			   b.min.z <= a.max.z;
+	}
+
+	float DistanceSqr(const BoundingBox& box, const Vec3& point)
+	{
+		const float x = std::max({box.min.x - point.x, 0.f, point.x - box.max.x});
+		const float y = std::max({box.min.y - point.y, 0.f, point.y - box.max.y});
+		const float z = std::max({box.min.z - point.z, 0.f, point.z - box.max.z});
+		return x * x + y * y + z * z;
+	}
+
+	// Slab test, returns the entry distance or a negative value when the ray misses within maxDistance
+	float IntersectRay(const BoundingBox& box, const Vec3& origin, const Vec3& inverseDirection, const float maxDistance)
+	{
+		const float x1 = (box.min.x - origin.x) * inverseDirection.x;
+		const float x2 = (box.max.x - origin.x) * inverseDirection.x;
+		const float y1 = (box.min.y - origin.y) * inverseDirection.y;
+		const float y2 = (box.max.y - origin.y) * inverseDirection.y;
+		const float z1 = (box.min.z - origin.z) * inverseDirection.z;
+		const float z2 = (box.max.z - origin.z) * inverseDirection.z;
+
+		const float entry = std::max({std::min(x1, x2), std::min(y1, y2), std::min(z1, z2), 0.f});
+		const float exit = std::min({std::max(x1, x2), std::max(y1, y2), std::max(z1, z2), maxDistance});
+		return entry <= exit ? entry : -1.f;
+	}
+
+	Vec3 InverseDirection(const Vector3& direction)
+	{
+		const auto inverse = [](const float value) {
+			return value != 0.f ? 1.f / value : std::copysign(std::numeric_limits<float>::max(), value);
+		};
+		return {inverse(direction.x), inverse(direction.y), inverse(direction.z)};
+	}
+
+	std::vector<uint32_t>& GetQueryStack()
+	{
+		thread_local std::vector<uint32_t> stack;
+		stack.clear();
+		return stack;
+	}
+
+	BoundingBox GetComponentBounds(Mistral::Component& component)
+	{
+		if (BoundingBox bounds; component.GetBounds(bounds))
+		{
+			return bounds;
+		}
+
+		const Vec3& position = component.GetSpatial().GetPosition();
+		return {position, position};
+	}
+} // namespace
+
+Mistral::DynamicBvh::DynamicBvh(const float margin):
+	mMargin(margin)
+{
+}
+
+// Proxies
+uint32_t Mistral::DynamicBvh::CreateProxy(const BoundingBox& bounds, void* userData)
+{
+	const uint32_t proxy = AllocateNode();
+	Node& node = mNodes[proxy];
+	node.exact = bounds;
+	node.box = {Vec3(bounds.min) - mMargin, Vec3(bounds.max) + mMargin};
+	node.userData = userData;
+	node.height = 0;
+
+	InsertLeaf(proxy);
+	mProxyCount++;
+	return proxy;
+}
+
+void Mistral::DynamicBvh::DestroyProxy(const uint32_t proxy)
+{
+	assert(proxy < mNodes.size() && IsLeaf(proxy));
+
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	mProxyCount--;
+}
+
+bool Mistral::DynamicBvh::MoveProxy(const uint32_t proxy, const BoundingBox& bounds)
+{
+	assert(proxy < mNodes.size() && IsLeaf(proxy));
+
+	mNodes[proxy].exact = bounds;
+	if (Contains(mNodes[proxy].box, bounds))
+	{
+		return false;
+	}
+
+	RemoveLeaf(proxy);
+	mNodes[proxy].box = {Vec3(bounds.min) - mMargin, Vec3(bounds.max) + mMargin};
+	InsertLeaf(proxy);
+	return true;
+}
+
+void Mistral::DynamicBvh::Clear()
+{
+	mNodes.clear();
+	mRoot = BvhNullProxy;
+	mFreeList = BvhNullProxy;
+	mProxyCount = 0;
+}
+
+// Getters
+void* Mistral::DynamicBvh::GetUserData(const uint32_t proxy) const
+{
+	return mNodes[proxy].userData;
+}
+
+const BoundingBox& Mistral::DynamicBvh::GetBounds(const uint32_t proxy) const
+{
+	return mNodes[proxy].exact;
+}
+
+const BoundingBox& Mistral::DynamicBvh::GetFatBounds(const uint32_t proxy) const
+{
+	return mNodes[proxy].box;
+}
+
+uint32_t Mistral::DynamicBvh::GetProxyCount() const
+{
+	return mProxyCount;
+}
+
+uint32_t Mistral::DynamicBvh::GetHeight() const
+{
+	return mRoot == BvhNullProxy ? 0 : static_cast<uint32_t>(mNodes[mRoot].height);
+}
+
+float Mistral::DynamicBvh::GetAreaRatio() const
+{
+	if (mRoot == BvhNullProxy)
+	{
+		return 0.f;
+	}
+
+	float totalArea = 0.f;
+	for (const Node& node : mNodes)
+	{
+		if (node.height > 0)
+		{
+			totalArea += Area(node.box);
+		}
+	}
+
+	const float rootArea = Area(mNodes[mRoot].box);
+	return rootArea > 0.f ? totalArea / rootArea : 0.f;
+}
+
+// Queries
+void Mistral::DynamicBvh::QueryBox(const BoundingBox& box, std::vector<void*>& results) const
+{
+	if (mRoot == BvhNullProxy)
+	{
+		return;
+	}
+
+	std::vector<uint32_t>& stack = GetQueryStack();
+	stack.push_back(mRoot);
+
+	while (!stack.empty())
+	{
+		const Node& node = mNodes[stack.back()];
+		stack.pop_back();
+
+		if (!Overlaps(node.box, box))
+		{
+			continue;
+		}
+
+		if (node.height == 0)
+		{
+			if (Overlaps(node.exact, box))
+			{
+				results.push_back(node.userData);
+			}
+			continue;
+		}
+
+		stack.push_back(node.child1);
+		stack.push_back(node.child2);
+	}
+}
+
+void Mistral::DynamicBvh::QuerySphere(const Vec3& center, const float radius, std::vector<void*>& results) const
+{
+	if (mRoot == BvhNullProxy)
+	{
+		return;
+	}
+
+	const float radiusSqr = radius * radius;
+
+	std::vector<uint32_t>& stack = GetQueryStack();
+	stack.push_back(mRoot);
+
+	while (!stack.empty())
+	{
+		const Node& node = mNodes[stack.back()];
+		stack.pop_back();
+
+		if (DistanceSqr(node.box, center) > radiusSqr)
+		{
+			continue;
+		}
+
+		if (node.height == 0)
+		{
+			if (DistanceSqr(node.exact, center) <= radiusSqr)
+			{
+				results.push_back(node.userData);
+			}
+			continue;
+		}
+
+		stack.push_back(node.child1);
+		stack.push_back(node.child2);
+	}
+}
+
+bool Mistral::DynamicBvh::Raycast(const Ray& ray, const float maxDistance, BvhRayHit& hit) const
+{
+	if (mRoot == BvhNullProxy)
+	{
+		return false;
+	}
+
+	const Vec3 origin = ray.position;
+	const Vec3 inverseDirection = InverseDirection(ray.direction);
+	float closest = maxDistance;
+	bool found = false;
+
+	std::vector<uint32_t>& stack = GetQueryStack();
+	stack.push_back(mRoot);
+
+	while (!stack.empty())
+	{
+		const Node& node = mNodes[stack.back()];
+		const uint32_t index = stack.back();
+		stack.pop_back();
+
+		if (node.height == 0)
+		{
+			if (const float distance = IntersectRay(node.exact, origin, inverseDirection, closest); distance >= 0.f)
+			{
+				closest = distance;
+				hit = {index, node.userData, distance};
+				found = true;
+			}
+			continue;
+		}
+
+		// Nearer child popped first, so the closest hit shrinks the search early
+		const float distance1 = IntersectRay(mNodes[node.child1].box, origin, inverseDirection, closest);
+		const float distance2 = IntersectRay(mNodes[node.child2].box, origin, inverseDirection, closest);
+		const bool nearFirst = distance2 < 0.f || (distance1 >= 0.f && distance1 <= distance2);
+
+		const uint32_t nearChild = nearFirst ? node.child1 : node.child2;
+		const uint32_t farChild = nearFirst ? node.child2 : node.child1;
+		if ((nearFirst ? distance2 : distance1) >= 0.f)
+		{
+			stack.push_back(farChild);
+		}
+		if ((nearFirst ? distance1 : distance2) >= 0.f)
+		{
+			stack.push_back(nearChild);
+		}
+	}
+
+	return found;
+}
+
+bool Mistral::DynamicBvh::FindNearest(const Vec3& point, const float maxDistance, BvhRayHit& hit) const
+{
+	if (mRoot == BvhNullProxy)
+	{
+		return false;
+	}
+
+	// Best first, nodes are visited by increasing distance from their box to the point
+	using Entry = std::pair<float, uint32_t>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+	queue.emplace(DistanceSqr(mNodes[mRoot].box, point), mRoot);
+
+	float closestSqr = maxDistance >= std::sqrt(std::numeric_limits<float>::max()) ? std::numeric_limits<float>::max() : maxDistance * maxDistance;
+	bool found = false;
+
+	while (!queue.empty())
+	{
+		const auto [distanceSqr, index] = queue.top();
+		queue.pop();
+
+		if (distanceSqr > closestSqr)
+		{
+			break;
+		}
+
+		const Node& node = mNodes[index];
+		if (node.height == 0)
+		{
+			if (const float exactSqr = DistanceSqr(node.exact, point); exactSqr <= closestSqr)
+			{
+				closestSqr = exactSqr;
+				hit = {index, node.userData, std::sqrt(exactSqr)};
+				found = true;
+			}
+			continue;
+		}
+
+		for (const uint32_t child : {node.child1, node.child2})
+		{
+			if (const float childSqr = DistanceSqr(mNodes[child].box, point); childSqr <= closestSqr)
+			{
+				queue.emplace(childSqr, child);
+			}
+		}
+	}
+
+	return found;
+}
+
+void Mistral::DynamicBvh::RaycastBatch(const std::span<const Ray> rays, const float maxDistance, const std::span<BvhRayHit> hits) const
+{
+	assert(hits.size() >= rays.size());
+
+	ParallelFor(static_cast<uint32_t>(rays.size()), batchChunkSize, [&](const uint32_t begin, const uint32_t end) {
+		for (uint32_t index = begin; index < end; index++)
+		{
+			if (!Raycast(rays[index], maxDistance, hits[index]))
+			{
+				hits[index] = {};
+			}
+		}
+	});
+}
+
+void Mistral::DynamicBvh::QuerySphereBatch(const std::span<const Vec3> centers, const float radius,
+										   const std::span<std::vector<void*>> results) const
+{
+	assert(results.size() >= centers.size());
+
+	ParallelFor(static_cast<uint32_t>(centers.size()), batchChunkSize, [&](const uint32_t begin, const uint32_t end) {
+		for (uint32_t index = begin; index < end; index++)
+		{
+			results[index].clear();
+			QuerySphere(centers[index], radius, results[index]);
+		}
+	});
+}
+
+// Internal
+bool Mistral::DynamicBvh::IsLeaf(const uint32_t node) const
+{
+	return mNodes[node].height == 0;
+}
+
+uint32_t Mistral::DynamicBvh::AllocateNode()
+{
+	uint32_t node = mFreeList;
+	if (node == BvhNullProxy)
+	{
+		node = static_cast<uint32_t>(mNodes.size());
+		mNodes.emplace_back();
+	}
+	else
+	{
+		mFreeList = mNodes[node].parent;
+	}
+
+	mNodes[node] = {{}, {}, nullptr, BvhNullProxy, BvhNullProxy, BvhNullProxy, 0};
+	return node;
+}
+
+void Mistral::DynamicBvh::FreeNode(const uint32_t node)
+{
+	mNodes[node].parent = mFreeList;
+	mNodes[node].height = -1;
+	mFreeList = node;
+}
+
+void Mistral::DynamicBvh::InsertLeaf(const uint32_t leaf)
+{
+	if (mRoot == BvhNullProxy)
+	{
+		mRoot = leaf;
+		mNodes[leaf].parent = BvhNullProxy;
+		return;
+	}
+
+	// Descends while a child is cheaper than pairing the leaf with the current node, counting the growth of every ancestor on the way
+	const BoundingBox leafBox = mNodes[leaf].box;
+	uint32_t index = mRoot;
+	while (!IsLeaf(index))
+	{
+		const Node& node = mNodes[index];
+		const float area = Area(node.box);
+		const float combinedArea = Area(Union(node.box, leafBox));
+
+		const float cost = 2.f * combinedArea;
+		const float inheritedCost = 2.f * (combinedArea - area);
+
+		const auto childCost = [&](const uint32_t child) {
+			const float unionArea = Area(Union(mNodes[child].box, leafBox));
+			return (IsLeaf(child) ? unionArea : unionArea - Area(mNodes[child].box)) + inheritedCost;
+		};
+		const float cost1 = childCost(node.child1);
+		const float cost2 = childCost(node.child2);
+
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const uint32_t sibling = index;
+	const uint32_t oldParent = mNodes[sibling].parent;
+	const uint32_t newParent = AllocateNode();
+
+	Node& parent = mNodes[newParent];
+	parent.parent = oldParent;
+	parent.box = Union(leafBox, mNodes[sibling].box);
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+	parent.height = mNodes[sibling].height + 1;
+
+	if (oldParent == BvhNullProxy)
+	{
+		mRoot = newParent;
+	}
+	else if (mNodes[oldParent].child1 == sibling)
+	{
+		mNodes[oldParent].child1 = newParent;
+	}
+	else
+	{
+		mNodes[oldParent].child2 = newParent;
+	}
+
+	mNodes[sibling].parent = newParent;
+	mNodes[leaf].parent = newParent;
+
+	RefitAncestors(newParent);
+}
+
+void Mistral::DynamicBvh::RemoveLeaf(const uint32_t leaf)
+{
+	if (leaf == mRoot)
+	{
+		mRoot = BvhNullProxy;
+		return;
+	}
+
+	const uint32_t parent = mNodes[leaf].parent;
+	const uint32_t grandParent = mNodes[parent].parent;
+	const uint32_t sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+	mNodes[sibling].parent = grandParent;
+	FreeNode(parent);
+
+	if (grandParent == BvhNullProxy)
+	{
+		mRoot = sibling;
+		return;
+	}
+
+	if (mNodes[grandParent].child1 == parent)
+	{
+		mNodes[grandParent].child1 = sibling;
+	}
+	else
+	{
+		mNodes[grandParent].child2 = sibling;
+	}
+
+	RefitAncestors(grandParent);
+}
+
+void Mistral::DynamicBvh::RefitAncestors(uint32_t node)
+{
+	while (node != BvhNullProxy)
+	{
+		Node& current = mNodes[node];
+		current.box = Union(mNodes[current.child1].box, mNodes[current.child2].box);
+		current.height = 1 + std::max(mNodes[current.child1].height, mNodes[current.child2].height);
+
+		Rotate(node);
+		node = current.parent;
+	}
+}
+
+void Mistral::DynamicBvh::Rotate(const uint32_t node)
+{
+	Node& a = mNodes[node];
+	const uint32_t b = a.child1;
+	const uint32_t c = a.child2;
+
+	// Candidate swaps of a child with a grandchild on the other side, rated by how much the affected child shrinks
+	enum class Rotation
+	{
+		None,
+		CwithD,
+		CwithE,
+		BwithF,
+		BwithG
+	};
+
+	Rotation best = Rotation::None;
+	float bestGain = 0.f;
+
+	const auto consider = [&](const Rotation rotation, const float gain) {
+		if (gain > bestGain)
+		{
+			best = rotation;
+			bestGain = gain;
+		}
+	};
+
+	if (!IsLeaf(b))
+	{
+		const float areaB = Area(mNodes[b].box);
+		consider(Rotation::CwithD, areaB - Area(Union(mNodes[c].box, mNodes[mNodes[b].child2].box)));
+		consider(Rotation::CwithE, areaB - Area(Union(mNodes[c].box, mNodes[mNodes[b].child1].box)));
+	}
+
+	if (!IsLeaf(c))
+	{
+		const float areaC = Area(mNodes[c].box);
+		consider(Rotation::BwithF, areaC - Area(Union(mNodes[b].box, mNodes[mNodes[c].child2].box)));
+		consider(Rotation::BwithG, areaC - Area(Union(mNodes[b].box, mNodes[mNodes[c].child1].box)));
+	}
+
+	if (best == Rotation::None)
+	{
+		return;
+	}
+
+	// Swaps the outer child of the node with the grandchild at the given slot of the inner child, then refits the inner child
+	const auto swap = [&](const uint32_t inner, const bool outerIsChild1, const bool grandchildIsChild1) {
+		const uint32_t outer = outerIsChild1 ? a.child1 : a.child2;
+		Node& innerNode = mNodes[inner];
+		const uint32_t grandchild = grandchildIsChild1 ? innerNode.child1 : innerNode.child2;
+
+		(outerIsChild1 ? a.child1 : a.child2) = grandchild;
+		(grandchildIsChild1 ? innerNode.child1 : innerNode.child2) = outer;
+		mNodes[grandchild].parent = node;
+		mNodes[outer].parent = inner;
+
+		innerNode.box = Union(mNodes[innerNode.child1].box, mNodes[innerNode.child2].box);
+		innerNode.height = 1 + std::max(mNodes[innerNode.child1].height, mNodes[innerNode.child2].height);
+	};
+
+	switch (best)
+	{
+		case Rotation::CwithD:
+			swap(b, false, true);
+			break;
+		case Rotation::CwithE:
+			swap(b, false, false);
+			break;
+		case Rotation::BwithF:
+			swap(c, true, true);
+			break;
+		case Rotation::BwithG:
+			swap(c, true, false);
+			break;
+		default:
+			break;
+	}
+
+	a.height = 1 + std::max(mNodes[a.child1].height, mNodes[a.child2].height);
+}
+
+// Engine integration
+void Mistral::UpdateComponentBvh()
+{
+	// Moves every live component's proxy, creates the missing ones and drops the ones whose component is gone
+	for (auto& [component, indexed] : indexedComponents)
+	{
+		indexed.seen = false;
+	}
+
+	for (const auto& component : GetComponentsView())
+	{
+		const BoundingBox bounds = GetComponentBounds(*component);
+		if (const auto it = indexedComponents.find(component.get()); it != indexedComponents.end())
+		{
+			componentBvh.MoveProxy(it->second.proxy, bounds);
+			it->second.seen = true;
+		}
+		else
+		{
+			indexedComponents.emplace(component.get(), IndexedComponent{componentBvh.CreateProxy(bounds, component.get()), true});
+		}
+	}
+
+	// Destroyed components are only used as keys here, never dereferenced
+	std::erase_if(indexedComponents, [](const auto& entry) {
+		if (!entry.second.seen)
+		{
+			componentBvh.DestroyProxy(entry.second.proxy);
+		}
+		return !entry.second.seen;
+	});
+}
+
+void Mistral::RemoveComponentFromBvh(const Component* component)
+{
+	if (const auto it = indexedComponents.find(component); it != indexedComponents.end())
+	{
+		componentBvh.DestroyProxy(it->second.proxy);
+		indexedComponents.erase(it);
+	}
+}
+
+Mistral::DynamicBvh& Mistral::GetComponentBvh()
+{
+	return componentBvh;
+}
+
+Mistral::Component* Mistral::RaycastComponents(const Ray& ray, const float maxDistance, float* distance)
+{
+	BvhRayHit hit;
+	if (!GetComponentBvh().Raycast(ray, maxDistance, hit))
+	{
+		return nullptr;
+	}
+
+	if (distance)
+	{
+		*distance = hit.distance;
+	}
+	return static_cast<Component*>(hit.userData);
+}
+
+void Mistral::RaycastComponents(const std::span<const Ray> rays, const float maxDistance, const std::span<Component*> hits)
+{
+	std::vector<BvhRayHit> rayHits(rays.size());
+	GetComponentBvh().RaycastBatch(rays, maxDistance, rayHits);
+
+	std::ranges::transform(rayHits, hits.begin(), [](const BvhRayHit& hit) { return static_cast<Component*>(hit.userData); });
+}
+
+void Mistral::QueryComponents(const BoundingBox& box, std::vector<Component*>& components)
+{
+	thread_local std::vector<void*> results;
+	results.clear();
+	GetComponentBvh().QueryBox(box, results);
+
+	std::ranges::transform(results, std::back_inserter(components), [](void* userData) { return static_cast<Component*>(userData); });
+}
+
+void Mistral::QueryComponents(const Vec3& center, const float radius, std::vector<Component*>& components)
+{
+	thread_local std::vector<void*> results;
+	results.clear();
+	GetComponentBvh().QuerySphere(center, radius, results);
+
+	std::ranges::transform(results, std::back_inserter(components), [](void* userData) { return static_cast<Component*>(userData); });
+}
+
+Mistral::Component* Mistral::FindNearestComponent(const Vec3& point, const float maxDistance)
+{
+	BvhRayHit hit;
+	return GetComponentBvh().FindNearest(point, maxDistance, hit) ? static_cast<Component*>(hit.userData) : nullptr;
+}
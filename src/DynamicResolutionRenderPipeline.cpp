@@ -0,0 +1,208 @@
+#include "DynamicResolutionRenderPipeline.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Cameras.h"
+#include "Mistral.h"
+#include "rlgl.h"
+
+namespace
+{
+	// Aim slightly below the budget so small spikes don't immediately miss it
+	constexpr float budgetHeadroom = .9f;
+
+	// Scale changes are ignored when the budget is met within this margin, avoids oscillating around the target
+	constexpr float deadZone = .08f;
+
+	constexpr float frameTimeSmoothing = .1f;
+	constexpr float scaleSmoothing = .15f;
+} // namespace
+
+Mistral::DynamicResolutionRenderPipeline::DynamicResolutionRenderPipeline(const float targetFrameTime, const float minScale, const float maxScale)
+	: mTargetFrameTime(targetFrameTime), mMinScale(std::clamp(minScale, .1f, 1.f)), mMaxScale(std::clamp(maxScale, mMinScale, 1.f)),
+	  mScale(mMaxScale)
+{
+}
+
+Mistral::DynamicResolutionRenderPipeline::~DynamicResolutionRenderPipeline()
+{
+	if (mTarget.id != 0)
+	{
+		UnloadRenderTexture(mTarget);
+	}
+}
+
+void Mistral::DynamicResolutionRenderPipeline::Initialize()
+{
+	UpdateTarget();
+}
+
+void Mistral::DynamicResolutionRenderPipeline::RenderEvent()
+{
+	const double cpuStart = GetTime();
+
+	UpdateTarget();
+	UpdateScale();
+
+	mSceneWidth = std::max(1, static_cast<int>(std::lround(static_cast<float>(mTarget.texture.width) * mScale)));
+	mSceneHeight = std::max(1, static_cast<int>(std::lround(static_cast<float>(mTarget.texture.height) * mScale)));
+
+	BeginDrawing();
+
+	mFrameTimer.Begin();
+
+	{ // Scene space, drawn into the corner of the target so resizing the scene never reallocates it
+		BeginTextureMode(mTarget);
+
+		ClearBackground(RAYWHITE);
+
+		EndTextureMode();
+
+		// Camera viewports are taken relative to the scaled area, so the projection aspect stays the one of the full target
+		CameraOutput output;
+		output.target = &mTarget;
+		output.width = mSceneWidth;
+		output.height = mSceneHeight;
+
+		mSceneTimer.Begin();
+
+		RenderCameras(output);
+
+		mSceneTimer.End();
+	}
+
+	ClearBackground(BLACK);
+
+	// Render textures are stored bottom up and the viewport starts at the bottom left texel, hence the negative source height
+	const Rectangle source = {0.f, 0.f, static_cast<float>(mSceneWidth), -static_cast<float>(mSceneHeight)};
+	const Rectangle destination = {0.f, 0.f, static_cast<float>(GetScreenWidth()), static_cast<float>(GetScreenHeight())};
+	DrawTexturePro(mTarget.texture, source, destination, {0.f, 0.f}, 0.f, WHITE);
+
+	ComponentRender2DEventCallback();
+
+	{ // ImGui space
+		rlImGuiBegin();
+
+		ComponentRenderGUIEventCallback();
+
+		rlImGuiEnd();
+	}
+
+	mFrameTimer.End();
+
+	mCpuTime = (GetTime() - cpuStart) * 1000.0;
+
+	EndDrawing();
+}
+
+// Setters
+void Mistral::DynamicResolutionRenderPipeline::SetTargetFrameTime(const float milliseconds)
+{
+	mTargetFrameTime = milliseconds;
+}
+
+void Mistral::DynamicResolutionRenderPipeline::SetScaleLimits(const float minScale, const float maxScale)
+{
+	mMinScale = std::clamp(minScale, .1f, 1.f);
+	mMaxScale = std::clamp(maxScale, mMinScale, 1.f);
+	mScale = std::clamp(mScale, mMinScale, mMaxScale);
+}
+
+void Mistral::DynamicResolutionRenderPipeline::SetDynamicScaling(const bool enabled)
+{
+	mDynamicScaling = enabled;
+}
+
+void Mistral::DynamicResolutionRenderPipeline::SetResolutionScale(const float scale)
+{
+	mScale = std::clamp(scale, mMinScale, mMaxScale);
+}
+
+// Getters
+float Mistral::DynamicResolutionRenderPipeline::GetTargetFrameTime() const
+{
+	return mTargetFrameTime;
+}
+
+float Mistral::DynamicResolutionRenderPipeline::GetResolutionScale() const
+{
+	return mScale;
+}
+
+bool Mistral::DynamicResolutionRenderPipeline::IsDynamicScaling() const
+{
+	return mDynamicScaling;
+}
+
+int Mistral::DynamicResolutionRenderPipeline::GetSceneWidth() const
+{
+	return mSceneWidth;
+}
+
+int Mistral::DynamicResolutionRenderPipeline::GetSceneHeight() const
+{
+	return mSceneHeight;
+}
+
+double Mistral::DynamicResolutionRenderPipeline::GetCpuTime() const
+{
+	return mCpuTime;
+}
+
+double Mistral::DynamicResolutionRenderPipeline::GetGpuTime() const
+{
+	return mFrameTimer.GetMilliseconds();
+}
+
+double Mistral::DynamicResolutionRenderPipeline::GetSceneGpuTime() const
+{
+	return mSceneTimer.GetMilliseconds();
+}
+
+// Internal
+void Mistral::DynamicResolutionRenderPipeline::UpdateTarget()
+{
+	const int width = GetRenderWidth();
+	const int height = GetRenderHeight();
+	if (mTarget.id != 0 && mTarget.texture.width == width && mTarget.texture.height == height)
+	{
+		return;
+	}
+
+	if (mTarget.id != 0)
+	{
+		UnloadRenderTexture(mTarget);
+	}
+
+	mTarget = LoadRenderTexture(width, height);
+	SetTextureFilter(mTarget.texture, TEXTURE_FILTER_BILINEAR);
+}
+
+void Mistral::DynamicResolutionRenderPipeline::UpdateScale()
+{
+	// Only the GPU side scales with the resolution, a CPU bound frame would shrink the scene without getting any faster. The timer reads
+	// zero until the first queries come back.
+	const double frameTime = mFrameTimer.GetMilliseconds();
+	if (frameTime <= 0.0)
+	{
+		return;
+	}
+
+	mSmoothedFrameTime = mSmoothedFrameTime <= 0.0 ? frameTime : mSmoothedFrameTime + (frameTime - mSmoothedFrameTime) * frameTimeSmoothing;
+
+	if (!mDynamicScaling)
+	{
+		return;
+	}
+
+	// Fill cost grows with the pixel count, so the scale follows the square root of the time ratio
+	const double ratio = mTargetFrameTime * budgetHeadroom / mSmoothedFrameTime;
+	if (std::abs(ratio - 1.0) < deadZone)
+	{
+		return;
+	}
+
+	const float desired = std::clamp(mScale * static_cast<float>(std::sqrt(ratio)), mMinScale, mMaxScale);
+	mScale = std::clamp(mScale + (desired - mScale) * scaleSmoothing, mMinScale, mMaxScale);
+}
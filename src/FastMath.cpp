@@ -0,0 +1,110 @@
+#include "FastMath.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define MISTRAL_FAST_MATH_SSE
+#endif
+
+namespace
+{
+	constexpr float pi = 3.14159265f;
+	constexpr float halfPi = 1.57079633f;
+	constexpr float twoPi = 6.28318531f;
+	constexpr double twoPiPrecise = 6.283185307179586;
+	constexpr double inverseTwoPi = .15915494309189535;
+
+	// Past it the double reduction no longer keeps the error below 1e-6
+	constexpr float maxReducedAngle = 1e9f;
+
+	// Minimax fits, sine over [0, pi/2] and arctangent over [0, 1], odd powers only
+	constexpr float sinCoefficients[4] = {.999996617f, -.166648286f, .00830632683f, -.000183636887f};
+	constexpr float atanCoefficients[6] = {.999977222f, -.332622853f, .193540445f, -.116426535f, .0526473342f, -.0117191107f};
+
+	// Reduced in double precision so large angles keep every bit, rounding through an integer conversion rather than a libm call
+	float ReduceAngle(const float angle)
+	{
+		const double scaled = angle * inverseTwoPi;
+		const double turns = static_cast<double>(static_cast<int64_t>(scaled + std::copysign(.5, scaled)));
+		return static_cast<float>(angle - turns * twoPiPrecise);
+	}
+
+	// Angle within [-pi, pi], folded to [-pi/2, pi/2] where the polynomial is fitted
+	float SinReduced(const float angle)
+	{
+		// Folded without branching, the side of the fold is unpredictable for scattered angles
+		const float magnitude = std::fabs(angle);
+		const float x = std::copysign(std::min(magnitude, pi - magnitude), angle);
+
+		const float x2 = x * x;
+		return x * (sinCoefficients[0] + x2 * (sinCoefficients[1] + x2 * (sinCoefficients[2] + x2 * sinCoefficients[3])));
+	}
+} // namespace
+
+float FastRsqrt(const float value)
+{
+#if defined(MISTRAL_FAST_MATH_SSE)
+	const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+#else
+	const float estimate = std::bit_cast<float>(0x5f375a86u - (std::bit_cast<uint32_t>(value) >> 1));
+#endif
+
+	// One Newton-Raphson step squares the relative error of the estimate
+	return estimate * (1.5f - .5f * value * estimate * estimate);
+}
+
+float FastSin(const float angle)
+{
+	if (std::fabs(angle) > maxReducedAngle)
+	{
+		return std::sin(angle);
+	}
+	return SinReduced(ReduceAngle(angle));
+}
+
+float FastCos(const float angle)
+{
+	if (std::fabs(angle) > maxReducedAngle)
+	{
+		return std::cos(angle);
+	}
+
+	// Shifted after the reduction, adding pi/2 to a large angle would round it
+	const float x = ReduceAngle(angle) + halfPi;
+	return SinReduced(x > pi ? x - twoPi : x);
+}
+
+float FastAtan2(const float y, const float x)
+{
+	const float absX = std::fabs(x);
+	const float absY = std::fabs(y);
+	const float maximum = absX > absY ? absX : absY;
+
+	if (maximum == 0.f)
+	{
+		return 0.f;
+	}
+
+	// Arctangent of the ratio within [0, 1], then moved to its octant
+	const float a = (absX < absY ? absX : absY) / maximum;
+	const float a2 = a * a;
+	float result = a * (atanCoefficients[0] +
+						a2 * (atanCoefficients[1] +
+							  a2 * (atanCoefficients[2] + a2 * (atanCoefficients[3] + a2 * (atanCoefficients[4] + a2 * atanCoefficients[5])))));
+
+	if (absY > absX)
+	{
+		result = halfPi - result;
+	}
+
+	if (x < 0.f)
+	{
+		result = pi - result;
+	}
+
+	return y < 0.f ? -result : result;
+}
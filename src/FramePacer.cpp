@@ -0,0 +1,224 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "raylib.h"
+
+namespace
+{
+	// Sleeping stops this long before the deadline, on top of the measured oversleep
+	constexpr double spinMargin = .0002;
+
+	// Low latency mode leaves this much slack between the predicted end of the work and the present
+	constexpr double presentMargin = .001;
+
+	constexpr double missedDeadlineTolerance = 1.2;
+
+	constexpr double smoothing = .1;
+
+	double ToSeconds(const std::chrono::steady_clock::duration duration)
+	{
+		return std::chrono::duration<double>(duration).count();
+	}
+} // namespace
+
+// Setters
+void Mistral::FramePacer::SetMode(const FramePacingMode mode, const float targetFps)
+{
+	mMode = mode;
+	mTargetFps = std::max(targetFps, 1.f);
+}
+
+void Mistral::FramePacer::SetLowLatency(const bool enabled)
+{
+	mLowLatency = enabled;
+}
+
+// Getters
+Mistral::FramePacingMode Mistral::FramePacer::GetMode() const
+{
+	return mMode;
+}
+
+float Mistral::FramePacer::GetTargetFps() const
+{
+	return mTargetFps;
+}
+
+bool Mistral::FramePacer::IsLowLatency() const
+{
+	return mLowLatency;
+}
+
+double Mistral::FramePacer::GetTargetPeriod() const
+{
+	switch (mMode)
+	{
+		case FramePacingMode::Fixed:
+			return 1.0 / mTargetFps;
+		case FramePacingMode::DisplayRate:
+		{
+			const int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+			return 1.0 / (refreshRate > 0 ? refreshRate : 60);
+		}
+		default:
+			return 0.0;
+	}
+}
+
+const Mistral::FramePacingStats& Mistral::FramePacer::GetStats() const
+{
+	return mStats;
+}
+
+float Mistral::FramePacer::GetFrameTime() const
+{
+	return mFrameTime;
+}
+
+// Functionalities
+void Mistral::FramePacer::BeginFrame()
+{
+	ApplyVsync();
+
+	const double period = GetTargetPeriod();
+	const Clock::time_point now = Clock::now();
+	std::optional<Clock::time_point> deadline;
+
+	if (mStats.frames > 0)
+	{
+		const auto toDuration = [](const double seconds) {
+			return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+		};
+
+		if (mMode == FramePacingMode::Fixed)
+		{
+			// Starting a period after the previous start, or right away after falling more than a period behind
+			deadline = mLastFrameStart + toDuration(period);
+			if (now - *deadline > toDuration(period))
+			{
+				deadline.reset();
+			}
+
+			if (mLowLatency)
+			{
+				// Presents happen as soon as the work ends, so the start is pushed back to end the work at the deadline instead
+				deadline = std::max(deadline.value_or(now), mLastPresent + toDuration(period - GetPredictedWork()));
+			}
+		}
+		else if (mMode == FramePacingMode::DisplayRate && mLowLatency)
+		{
+			// The previous present returned at a vertical blank, the next one is a period later
+			deadline = mLastPresent + toDuration(period - GetPredictedWork());
+		}
+	}
+
+	if (deadline && *deadline > now)
+	{
+		WaitUntil(*deadline);
+	}
+
+	mFrameStart = Clock::now();
+	mStats.waitTime = ToSeconds(mFrameStart - now) * 1000.0;
+	mFrameTime = mStats.frames > 0 ? static_cast<float>(ToSeconds(mFrameStart - mLastFrameStart)) : 0.f;
+	mLastFrameStart = mFrameStart;
+}
+
+void Mistral::FramePacer::EndFrame()
+{
+	const Clock::time_point present = Clock::now();
+
+	const double work = ToSeconds(present - mFrameStart);
+	mWorkAverage = mWorkAverage == 0.0 ? work : mWorkAverage + (work - mWorkAverage) * smoothing;
+	mWorkDeviation += (std::abs(work - mWorkAverage) - mWorkDeviation) * smoothing;
+	mStats.workTime = work * 1000.0;
+
+	if (mStats.frames > 0)
+	{
+		const double frameTime = ToSeconds(present - mLastPresent);
+		mStats.frameTime = frameTime * 1000.0;
+
+		const double period = GetTargetPeriod();
+		if (period > 0.0 && frameTime > period * missedDeadlineTolerance)
+		{
+			mStats.missedDeadlines++;
+		}
+
+		mHistory[mHistoryNext] = mStats.frameTime;
+		mHistoryNext = (mHistoryNext + 1) % HistorySize;
+		mHistoryCount = std::min(mHistoryCount + 1, HistorySize);
+
+		double sum = 0.0;
+		for (uint32_t index = 0; index < mHistoryCount; index++)
+		{
+			sum += mHistory[index];
+		}
+		mStats.averageFrameTime = sum / mHistoryCount;
+
+		double variance = 0.0;
+		for (uint32_t index = 0; index < mHistoryCount; index++)
+		{
+			variance += (mHistory[index] - mStats.averageFrameTime) * (mHistory[index] - mStats.averageFrameTime);
+		}
+		mStats.jitter = std::sqrt(variance / mHistoryCount);
+	}
+
+	mLastPresent = present;
+	mStats.frames++;
+}
+
+// Internal
+void Mistral::FramePacer::ApplyVsync()
+{
+	const bool vsync = mMode == FramePacingMode::DisplayRate;
+	if (mVsync == vsync)
+	{
+		return;
+	}
+
+	vsync ? SetWindowState(FLAG_VSYNC_HINT) : ClearWindowState(FLAG_VSYNC_HINT);
+	mVsync = vsync;
+}
+
+void Mistral::FramePacer::WaitUntil(const Clock::time_point deadline)
+{
+	while (true)
+	{
+		const Clock::time_point now = Clock::now();
+		const double remaining = ToSeconds(deadline - now);
+		if (remaining <= 0.0)
+		{
+			return;
+		}
+
+		const double sleep = remaining - mSleepOvershoot - spinMargin;
+		if (sleep <= 0.0)
+		{
+			break;
+		}
+
+		std::this_thread::sleep_for(std::chrono::duration<double>(sleep));
+
+		// Tracks how late the OS wakes us, the margin grows quickly and shrinks slowly
+		const double overshoot = std::max(ToSeconds(Clock::now() - now) - sleep, 0.0);
+		mSleepOvershoot += (overshoot - mSleepOvershoot) * (overshoot > mSleepOvershoot ? .5 : smoothing);
+	}
+
+	while (Clock::now() < deadline)
+	{
+		std::this_thread::yield();
+	}
+}
+
+double Mistral::FramePacer::GetPredictedWork() const
+{
+	return mWorkAverage + mWorkDeviation * 2.0 + presentMargin;
+}
+
+Mistral::FramePacer& Mistral::GetFramePacer()
+{
+	static FramePacer framePacer;
+	return framePacer;
+}
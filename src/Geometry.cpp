@@ -0,0 +1,557 @@
+#include "Geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	constexpr float epsilon = 1e-6f;
+
+	Vec3 Min(const Vec3& a, const Vec3& b)
+	{
+		return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
+	}
+
+	Vec3 Max(const Vec3& a, const Vec3& b)
+	{
+		return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+	}
+
+	float GetMaxScale(const Matrix4x4& matrix)
+	{
+		const Vec3 scale = matrix.GetScale();
+		return std::max({scale.x, scale.y, scale.z});
+	}
+
+	// Closest points between the segments p1q1 and p2q2, returns their squared distance
+	float SegmentSegmentDistanceSqr(const Vec3& p1, const Vec3& q1, const Vec3& p2, const Vec3& q2)
+	{
+		const Vec3 d1 = q1 - p1;
+		const Vec3 d2 = q2 - p2;
+		const Vec3 r = p1 - p2;
+		const float a = d1.Dot(d1);
+		const float e = d2.Dot(d2);
+		const float f = d2.Dot(r);
+
+		float s = 0.f;
+		float t = 0.f;
+
+		if (a <= epsilon && e <= epsilon)
+		{
+			return r.LengthSqr();
+		}
+
+		if (a <= epsilon)
+		{
+			t = std::clamp(f / e, 0.f, 1.f);
+		}
+		else
+		{
+			const float c = d1.Dot(r);
+			if (e <= epsilon)
+			{
+				s = std::clamp(-c / a, 0.f, 1.f);
+			}
+			else
+			{
+				const float b = d1.Dot(d2);
+				const float denominator = a * e - b * b;
+
+				// Parallel segments pick any point, the clamps below fix t
+				s = denominator != 0.f ? std::clamp((b * f - c * e) / denominator, 0.f, 1.f) : 0.f;
+				t = (b * s + f) / e;
+
+				if (t < 0.f)
+				{
+					t = 0.f;
+					s = std::clamp(-c / a, 0.f, 1.f);
+				}
+				else if (t > 1.f)
+				{
+					t = 1.f;
+					s = std::clamp((b - c) / a, 0.f, 1.f);
+				}
+			}
+		}
+
+		return ((p1 + d1 * s) - (p2 + d2 * t)).LengthSqr();
+	}
+} // namespace
+
+// Aabb
+Aabb::Aabb(const Vec3& min, const Vec3& max):
+	min(min),
+	max(max)
+{
+}
+
+Aabb::Aabb(const BoundingBox& box):
+	min(box.min),
+	max(box.max)
+{
+}
+
+Aabb::operator BoundingBox() const
+{
+	return {min, max};
+}
+
+Vec3 Aabb::GetCenter() const
+{
+	return (min + max) * .5f;
+}
+
+Vec3 Aabb::GetExtents() const
+{
+	return (max - min) * .5f;
+}
+
+float Aabb::GetSurfaceArea() const
+{
+	const Vec3 size = max - min;
+	return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+Aabb Aabb::Merged(const Aabb& aabb) const
+{
+	return {Min(min, aabb.min), Max(max, aabb.max)};
+}
+
+Aabb Aabb::Merged(const Vec3& point) const
+{
+	return {Min(min, point), Max(max, point)};
+}
+
+Vec3 Aabb::ClosestPoint(const Vec3& point) const
+{
+	return Min(Max(point, min), max);
+}
+
+bool Aabb::Contains(const Vec3& point) const
+{
+	return point.x >= min.x && point.y >= min.y && point.z >= min.z && point.x <= max.x && point.y <= max.y && point.z <= max.z;
+}
+
+bool Aabb::Intersects(const Aabb& aabb) const
+{
+	return min.x <= aabb.max.x && aabb.min.x <= max.x && min.y <= aabb.max.y && aabb.min.y <= max.y && min.z <= aabb.max.z &&
+		   aabb.min.z <= max.z;
+}
+
+bool Aabb::Intersects(const Sphere& sphere) const
+{
+	return sphere.Intersects(*this);
+}
+
+Aabb Aabb::Transformed(const Matrix4x4& matrix) const
+{
+	const Vec3 center = matrix.TransformPoint(GetCenter());
+	const Vec3 extents = GetExtents();
+	const Vec3 transformedExtents = {
+		std::abs(matrix.m0) * extents.x + std::abs(matrix.m4) * extents.y + std::abs(matrix.m8) * extents.z,
+		std::abs(matrix.m1) * extents.x + std::abs(matrix.m5) * extents.y + std::abs(matrix.m9) * extents.z,
+		std::abs(matrix.m2) * extents.x + std::abs(matrix.m6) * extents.y + std::abs(matrix.m10) * extents.z};
+
+	return FromCenterExtents(center, transformedExtents);
+}
+
+Aabb Aabb::FromCenterExtents(const Vec3& center, const Vec3& extents)
+{
+	return {center - extents, center + extents};
+}
+
+// Sphere
+Sphere::Sphere(const Vec3& center, const float radius):
+	center(center),
+	radius(radius)
+{
+}
+
+bool Sphere::Contains(const Vec3& point) const
+{
+	return (point - center).LengthSqr() <= radius * radius;
+}
+
+bool Sphere::Intersects(const Sphere& sphere) const
+{
+	const float reach = radius + sphere.radius;
+	return (sphere.center - center).LengthSqr() <= reach * reach;
+}
+
+bool Sphere::Intersects(const Aabb& aabb) const
+{
+	return (aabb.ClosestPoint(center) - center).LengthSqr() <= radius * radius;
+}
+
+Sphere Sphere::Transformed(const Matrix4x4& matrix) const
+{
+	return {matrix.TransformPoint(center), radius * GetMaxScale(matrix)};
+}
+
+// Plane
+Plane::Plane(const Vec3& normal, const float distance):
+	normal(normal),
+	distance(distance)
+{
+}
+
+float Plane::SignedDistance(const Vec3& point) const
+{
+	return normal.Dot(point) + distance;
+}
+
+Plane Plane::Normalized() const
+{
+	const float length = normal.Length();
+	if (length < epsilon)
+	{
+		return *this;
+	}
+
+	return {normal / length, distance / length};
+}
+
+Plane Plane::Transformed(const Matrix4x4& matrix) const
+{
+	const Matrix4x4 inverse = matrix.AffineInverted();
+	const Vec3 transformedNormal = {inverse.m0 * normal.x + inverse.m1 * normal.y + inverse.m2 * normal.z,
+									inverse.m4 * normal.x + inverse.m5 * normal.y + inverse.m6 * normal.z,
+									inverse.m8 * normal.x + inverse.m9 * normal.y + inverse.m10 * normal.z};
+
+	const Vec3 point = matrix.TransformPoint(normal * (-distance / normal.LengthSqr()));
+	return FromPointNormal(point, transformedNormal);
+}
+
+Plane Plane::FromPointNormal(const Vec3& point, const Vec3& normal)
+{
+	const Vec3 unitNormal = normal.Normalized();
+	return {unitNormal, -unitNormal.Dot(point)};
+}
+
+Plane Plane::FromPoints(const Vec3& a, const Vec3& b, const Vec3& c)
+{
+	return FromPointNormal(a, (b - a).Cross(c - a));
+}
+
+// Ray3
+Ray3::Ray3(const Vec3& origin, const Vec3& direction):
+	origin(origin),
+	direction(direction)
+{
+}
+
+Ray3::Ray3(const Ray& ray):
+	origin(ray.position),
+	direction(ray.direction)
+{
+}
+
+Ray3::operator Ray() const
+{
+	return {origin, direction};
+}
+
+Vec3 Ray3::GetPoint(const float distance) const
+{
+	return origin + direction * distance;
+}
+
+bool Ray3::Intersects(const Aabb& aabb, float& distance) const
+{
+	float entry = 0.f;
+	float exit = std::numeric_limits<float>::max();
+
+	for (std::size_t axis = 0; axis < 3; axis++)
+	{
+		if (std::abs(direction[axis]) < epsilon)
+		{
+			if (origin[axis] < aabb.min[axis] || origin[axis] > aabb.max[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const float inverse = 1.f / direction[axis];
+		const float near = (aabb.min[axis] - origin[axis]) * inverse;
+		const float far = (aabb.max[axis] - origin[axis]) * inverse;
+		entry = std::max(entry, std::min(near, far));
+		exit = std::min(exit, std::max(near, far));
+
+		if (entry > exit)
+		{
+			return false;
+		}
+	}
+
+	distance = entry;
+	return true;
+}
+
+bool Ray3::Intersects(const Sphere& sphere, float& distance) const
+{
+	const Vec3 offset = origin - sphere.center;
+	const float a = direction.Dot(direction);
+	const float b = offset.Dot(direction);
+	const float c = offset.Dot(offset) - sphere.radius * sphere.radius;
+
+	// Starting outside and pointing away
+	if (c > 0.f && b > 0.f)
+	{
+		return false;
+	}
+
+	const float discriminant = b * b - a * c;
+	if (discriminant < 0.f || a < epsilon)
+	{
+		return false;
+	}
+
+	distance = std::max((-b - std::sqrt(discriminant)) / a, 0.f);
+	return true;
+}
+
+bool Ray3::Intersects(const Plane& plane, float& distance) const
+{
+	const float denominator = plane.normal.Dot(direction);
+	if (std::abs(denominator) < epsilon)
+	{
+		return false;
+	}
+
+	const float hit = -plane.SignedDistance(origin) / denominator;
+	if (hit < 0.f)
+	{
+		return false;
+	}
+
+	distance = hit;
+	return true;
+}
+
+bool Ray3::Intersects(const Obb& obb, float& distance) const
+{
+	const Vec3 offset = origin - obb.center;
+	const Ray3 local = {{offset.Dot(obb.axes[0]), offset.Dot(obb.axes[1]), offset.Dot(obb.axes[2])},
+						{direction.Dot(obb.axes[0]), direction.Dot(obb.axes[1]), direction.Dot(obb.axes[2])}};
+
+	return local.Intersects(Aabb::FromCenterExtents(Vec3::Zero, obb.extents), distance);
+}
+
+Ray3 Ray3::Transformed(const Matrix4x4& matrix) const
+{
+	return {matrix.TransformPoint(origin), matrix.TransformVector(direction)};
+}
+
+// Obb
+Obb::Obb(const Vec3& center, const Vec3& extents, const Vec3& axisX, const Vec3& axisY, const Vec3& axisZ):
+	center(center),
+	extents(extents),
+	axes{axisX, axisY, axisZ}
+{
+}
+
+Obb::Obb(const Aabb& aabb):
+	center(aabb.GetCenter()),
+	extents(aabb.GetExtents())
+{
+}
+
+Vec3 Obb::ClosestPoint(const Vec3& point) const
+{
+	const Vec3 offset = point - center;
+	Vec3 result = center;
+	for (std::size_t axis = 0; axis < 3; axis++)
+	{
+		result += axes[axis] * std::clamp(offset.Dot(axes[axis]), -extents[axis], extents[axis]);
+	}
+	return result;
+}
+
+bool Obb::Contains(const Vec3& point) const
+{
+	const Vec3 offset = point - center;
+	return std::abs(offset.Dot(axes[0])) <= extents.x && std::abs(offset.Dot(axes[1])) <= extents.y &&
+		   std::abs(offset.Dot(axes[2])) <= extents.z;
+}
+
+bool Obb::Intersects(const Obb& obb) const
+{
+	// Separating axis test over the 3 + 3 face normals and the 9 edge cross products, all expressed in this box frame
+	float rotation[3][3];
+	float absRotation[3][3];
+	for (std::size_t i = 0; i < 3; i++)
+	{
+		for (std::size_t j = 0; j < 3; j++)
+		{
+			rotation[i][j] = axes[i].Dot(obb.axes[j]);
+			absRotation[i][j] = std::abs(rotation[i][j]) + epsilon; // Keeps parallel edges from producing a null cross product
+		}
+	}
+
+	const Vec3 offset = obb.center - center;
+	const float translation[3] = {offset.Dot(axes[0]), offset.Dot(axes[1]), offset.Dot(axes[2])};
+
+	for (std::size_t i = 0; i < 3; i++)
+	{
+		const float radiusB = obb.extents.x * absRotation[i][0] + obb.extents.y * absRotation[i][1] + obb.extents.z * absRotation[i][2];
+		if (std::abs(translation[i]) > extents[i] + radiusB)
+		{
+			return false;
+		}
+	}
+
+	for (std::size_t j = 0; j < 3; j++)
+	{
+		const float radiusA = extents.x * absRotation[0][j] + extents.y * absRotation[1][j] + extents.z * absRotation[2][j];
+		const float projection = translation[0] * rotation[0][j] + translation[1] * rotation[1][j] + translation[2] * rotation[2][j];
+		if (std::abs(projection) > radiusA + obb.extents[j])
+		{
+			return false;
+		}
+	}
+
+	for (std::size_t i = 0; i < 3; i++)
+	{
+		const std::size_t i1 = (i + 1) % 3;
+		const std::size_t i2 = (i + 2) % 3;
+		for (std::size_t j = 0; j < 3; j++)
+		{
+			const std::size_t j1 = (j + 1) % 3;
+			const std::size_t j2 = (j + 2) % 3;
+
+			const float radiusA = extents[i1] * absRotation[i2][j] + extents[i2] * absRotation[i1][j];
+			const float radiusB = obb.extents[j1] * absRotation[i][j2] + obb.extents[j2] * absRotation[i][j1];
+			const float projection = translation[i2] * rotation[i1][j] - translation[i1] * rotation[i2][j];
+			if (std::abs(projection) > radiusA + radiusB)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool Obb::Intersects(const Sphere& sphere) const
+{
+	return (ClosestPoint(sphere.center) - sphere.center).LengthSqr() <= sphere.radius * sphere.radius;
+}
+
+Aabb Obb::GetBounds() const
+{
+	const Vec3 halfSize = {
+		std::abs(axes[0].x) * extents.x + std::abs(axes[1].x) * extents.y + std::abs(axes[2].x) * extents.z,
+		std::abs(axes[0].y) * extents.x + std::abs(axes[1].y) * extents.y + std::abs(axes[2].y) * extents.z,
+		std::abs(axes[0].z) * extents.x + std::abs(axes[1].z) * extents.y + std::abs(axes[2].z) * extents.z};
+
+	return Aabb::FromCenterExtents(center, halfSize);
+}
+
+Obb Obb::Transformed(const Matrix4x4& matrix) const
+{
+	Obb result;
+	result.center = matrix.TransformPoint(center);
+	for (std::size_t axis = 0; axis < 3; axis++)
+	{
+		const Vec3 transformedAxis = matrix.TransformVector(axes[axis] * extents[axis]);
+		const float length = transformedAxis.Length();
+		result.extents[axis] = length;
+		result.axes[axis] = length > epsilon ? transformedAxis / length : axes[axis];
+	}
+	return result;
+}
+
+// Capsule
+Capsule::Capsule(const Vec3& a, const Vec3& b, const float radius):
+	a(a),
+	b(b),
+	radius(radius)
+{
+}
+
+Vec3 Capsule::ClosestPoint(const Vec3& point) const
+{
+	const Vec3 segment = b - a;
+	const float lengthSqr = segment.LengthSqr();
+	if (lengthSqr < epsilon)
+	{
+		return a;
+	}
+
+	return a + segment * std::clamp((point - a).Dot(segment) / lengthSqr, 0.f, 1.f);
+}
+
+bool Capsule::Contains(const Vec3& point) const
+{
+	return (ClosestPoint(point) - point).LengthSqr() <= radius * radius;
+}
+
+bool Capsule::Intersects(const Sphere& sphere) const
+{
+	const float reach = radius + sphere.radius;
+	return (ClosestPoint(sphere.center) - sphere.center).LengthSqr() <= reach * reach;
+}
+
+bool Capsule::Intersects(const Capsule& capsule) const
+{
+	const float reach = radius + capsule.radius;
+	return SegmentSegmentDistanceSqr(a, b, capsule.a, capsule.b) <= reach * reach;
+}
+
+Aabb Capsule::GetBounds() const
+{
+	return {Min(a, b) - radius, Max(a, b) + radius};
+}
+
+Capsule Capsule::Transformed(const Matrix4x4& matrix) const
+{
+	return {matrix.TransformPoint(a), matrix.TransformPoint(b), radius * GetMaxScale(matrix)};
+}
+
+// Frustum
+bool Frustum::Contains(const Vec3& point) const
+{
+	return std::ranges::all_of(planes, [&point](const Plane& plane) { return plane.SignedDistance(point) >= 0.f; });
+}
+
+bool Frustum::Intersects(const Sphere& sphere) const
+{
+	return std::ranges::all_of(planes, [&sphere](const Plane& plane) { return plane.SignedDistance(sphere.center) >= -sphere.radius; });
+}
+
+bool Frustum::Intersects(const Aabb& aabb) const
+{
+	return std::ranges::all_of(planes, [&aabb](const Plane& plane) {
+		const Vec3 corner = {plane.normal.x > 0.f ? aabb.max.x : aabb.min.x, plane.normal.y > 0.f ? aabb.max.y : aabb.min.y,
+							 plane.normal.z > 0.f ? aabb.max.z : aabb.min.z};
+		return plane.SignedDistance(corner) >= 0.f;
+	});
+}
+
+Frustum Frustum::Transformed(const Matrix4x4& matrix) const
+{
+	Frustum result;
+	for (std::size_t index = 0; index < 6; index++)
+	{
+		result.planes[index] = planes[index].Transformed(matrix);
+	}
+	return result;
+}
+
+Frustum Frustum::FromMatrix(const Matrix4x4& viewProjection)
+{
+	// Gribb and Hartmann, every plane is the last row plus or minus another row of the matrix
+	const Matrix4x4& m = viewProjection;
+	const Vec4 rows[4] = {{m.m0, m.m4, m.m8, m.m12}, {m.m1, m.m5, m.m9, m.m13}, {m.m2, m.m6, m.m10, m.m14}, {m.m3, m.m7, m.m11, m.m15}};
+
+	Frustum result;
+	for (std::size_t index = 0; index < 6; index++)
+	{
+		const Vec4& row = rows[index / 2];
+		const Vec4 plane = index % 2 == 0 ? rows[3] + row : rows[3] - row;
+		result.planes[index] = Plane({plane.x, plane.y, plane.z}, plane.w).Normalized();
+	}
+	return result;
+}
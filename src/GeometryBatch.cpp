@@ -0,0 +1,392 @@
+#include "GeometryBatch.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+	#define MISTRAL_GEOMETRY_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define MISTRAL_GEOMETRY_SSE
+#endif
+
+namespace
+{
+#if defined(MISTRAL_GEOMETRY_AVX)
+	struct Lanes
+	{
+		static constexpr uint32_t Width = 8;
+		using Type = __m256;
+
+		static Type Load(const float* values)
+		{
+			return _mm256_loadu_ps(values);
+		}
+
+		static Type Set(const float value)
+		{
+			return _mm256_set1_ps(value);
+		}
+
+		static Type Add(const Type a, const Type b)
+		{
+			return _mm256_add_ps(a, b);
+		}
+
+		static Type Sub(const Type a, const Type b)
+		{
+			return _mm256_sub_ps(a, b);
+		}
+
+		static Type Mul(const Type a, const Type b)
+		{
+			return _mm256_mul_ps(a, b);
+		}
+
+		static Type Min(const Type a, const Type b)
+		{
+			return _mm256_min_ps(a, b);
+		}
+
+		static Type Max(const Type a, const Type b)
+		{
+			return _mm256_max_ps(a, b);
+		}
+
+		static void Store(float* values, const Type a)
+		{
+			_mm256_storeu_ps(values, a);
+		}
+
+		// One bit per lane where a >= b
+		static uint32_t GreaterEqual(const Type a, const Type b)
+		{
+			return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ)));
+		}
+	};
+#elif defined(MISTRAL_GEOMETRY_SSE)
+	struct Lanes
+	{
+		static constexpr uint32_t Width = 4;
+		using Type = __m128;
+
+		static Type Load(const float* values)
+		{
+			return _mm_loadu_ps(values);
+		}
+
+		static Type Set(const float value)
+		{
+			return _mm_set1_ps(value);
+		}
+
+		static Type Add(const Type a, const Type b)
+		{
+			return _mm_add_ps(a, b);
+		}
+
+		static Type Sub(const Type a, const Type b)
+		{
+			return _mm_sub_ps(a, b);
+		}
+
+		static Type Mul(const Type a, const Type b)
+		{
+			return _mm_mul_ps(a, b);
+		}
+
+		static Type Min(const Type a, const Type b)
+		{
+			return _mm_min_ps(a, b);
+		}
+
+		static Type Max(const Type a, const Type b)
+		{
+			return _mm_max_ps(a, b);
+		}
+
+		static void Store(float* values, const Type a)
+		{
+			_mm_storeu_ps(values, a);
+		}
+
+		// One bit per lane where a >= b
+		static uint32_t GreaterEqual(const Type a, const Type b)
+		{
+			return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(a, b)));
+		}
+	};
+#endif
+
+	// A zero component would turn a box face on the origin into 0 * inf, the largest finite value keeps the slabs well defined
+	float SafeInverse(const float value)
+	{
+		return value != 0.f ? 1.f / value : std::copysign(std::numeric_limits<float>::max(), value);
+	}
+
+	float IntersectRayScalar(const AabbBatch& aabbs, const std::size_t index, const Vec3& origin, const Vec3& inverse, const float maxDistance)
+	{
+		const float x1 = (aabbs.minX[index] - origin.x) * inverse.x;
+		const float x2 = (aabbs.maxX[index] - origin.x) * inverse.x;
+		const float y1 = (aabbs.minY[index] - origin.y) * inverse.y;
+		const float y2 = (aabbs.maxY[index] - origin.y) * inverse.y;
+		const float z1 = (aabbs.minZ[index] - origin.z) * inverse.z;
+		const float z2 = (aabbs.maxZ[index] - origin.z) * inverse.z;
+
+		const float entry = std::max({std::min(x1, x2), std::min(y1, y2), std::min(z1, z2), 0.f});
+		const float exit = std::min({std::max(x1, x2), std::max(y1, y2), std::max(z1, z2), maxDistance});
+		return entry <= exit ? entry : -1.f;
+	}
+
+	// Calls the function with every box hit, the function returns the distance further hits must beat
+	template <typename Function>
+	void ForEachRayHit(const Ray3& ray, const AabbBatch& aabbs, float maxDistance, Function&& function)
+	{
+		const Vec3 inverse = {SafeInverse(ray.direction.x), SafeInverse(ray.direction.y), SafeInverse(ray.direction.z)};
+		const std::size_t count = aabbs.Size();
+		std::size_t index = 0;
+
+#if defined(MISTRAL_GEOMETRY_AVX) || defined(MISTRAL_GEOMETRY_SSE)
+		const Lanes::Type originX = Lanes::Set(ray.origin.x);
+		const Lanes::Type originY = Lanes::Set(ray.origin.y);
+		const Lanes::Type originZ = Lanes::Set(ray.origin.z);
+		const Lanes::Type inverseX = Lanes::Set(inverse.x);
+		const Lanes::Type inverseY = Lanes::Set(inverse.y);
+		const Lanes::Type inverseZ = Lanes::Set(inverse.z);
+		const Lanes::Type zero = Lanes::Set(0.f);
+
+		for (; index + Lanes::Width <= count; index += Lanes::Width)
+		{
+			const Lanes::Type x1 = Lanes::Mul(Lanes::Sub(Lanes::Load(&aabbs.minX[index]), originX), inverseX);
+			const Lanes::Type x2 = Lanes::Mul(Lanes::Sub(Lanes::Load(&aabbs.maxX[index]), originX), inverseX);
+			const Lanes::Type y1 = Lanes::Mul(Lanes::Sub(Lanes::Load(&aabbs.minY[index]), originY), inverseY);
+			const Lanes::Type y2 = Lanes::Mul(Lanes::Sub(Lanes::Load(&aabbs.maxY[index]), originY), inverseY);
+			const Lanes::Type z1 = Lanes::Mul(Lanes::Sub(Lanes::Load(&aabbs.minZ[index]), originZ), inverseZ);
+			const Lanes::Type z2 = Lanes::Mul(Lanes::Sub(Lanes::Load(&aabbs.maxZ[index]), originZ), inverseZ);
+
+			const Lanes::Type entry = Lanes::Max(Lanes::Max(Lanes::Min(x1, x2), Lanes::Min(y1, y2)), Lanes::Max(Lanes::Min(z1, z2), zero));
+			const Lanes::Type exit =
+				Lanes::Min(Lanes::Min(Lanes::Max(x1, x2), Lanes::Max(y1, y2)), Lanes::Min(Lanes::Max(z1, z2), Lanes::Set(maxDistance)));
+
+			uint32_t mask = Lanes::GreaterEqual(exit, entry);
+			if (mask == 0)
+			{
+				continue;
+			}
+
+			float entries[Lanes::Width];
+			Lanes::Store(entries, entry);
+			for (; mask != 0; mask &= mask - 1)
+			{
+				const auto lane = static_cast<uint32_t>(std::countr_zero(mask));
+				if (entries[lane] <= maxDistance)
+				{
+					maxDistance = function(static_cast<uint32_t>(index + lane), entries[lane]);
+				}
+			}
+		}
+#endif
+
+		for (; index < count; index++)
+		{
+			if (const float distance = IntersectRayScalar(aabbs, index, ray.origin, inverse, maxDistance); distance >= 0.f)
+			{
+				maxDistance = function(static_cast<uint32_t>(index), distance);
+			}
+		}
+	}
+} // namespace
+
+// AabbBatch
+void AabbBatch::Add(const Aabb& aabb)
+{
+	minX.push_back(aabb.min.x);
+	minY.push_back(aabb.min.y);
+	minZ.push_back(aabb.min.z);
+	maxX.push_back(aabb.max.x);
+	maxY.push_back(aabb.max.y);
+	maxZ.push_back(aabb.max.z);
+}
+
+void AabbBatch::Clear()
+{
+	minX.clear();
+	minY.clear();
+	minZ.clear();
+	maxX.clear();
+	maxY.clear();
+	maxZ.clear();
+}
+
+void AabbBatch::Reserve(const std::size_t count)
+{
+	minX.reserve(count);
+	minY.reserve(count);
+	minZ.reserve(count);
+	maxX.reserve(count);
+	maxY.reserve(count);
+	maxZ.reserve(count);
+}
+
+std::size_t AabbBatch::Size() const
+{
+	return minX.size();
+}
+
+// SphereBatch
+void SphereBatch::Add(const Sphere& sphere)
+{
+	centerX.push_back(sphere.center.x);
+	centerY.push_back(sphere.center.y);
+	centerZ.push_back(sphere.center.z);
+	radius.push_back(sphere.radius);
+}
+
+void SphereBatch::Clear()
+{
+	centerX.clear();
+	centerY.clear();
+	centerZ.clear();
+	radius.clear();
+}
+
+void SphereBatch::Reserve(const std::size_t count)
+{
+	centerX.reserve(count);
+	centerY.reserve(count);
+	centerZ.reserve(count);
+	radius.reserve(count);
+}
+
+std::size_t SphereBatch::Size() const
+{
+	return centerX.size();
+}
+
+// Batch tests
+void CullSpheres(const Frustum& frustum, const SphereBatch& spheres, std::vector<uint32_t>& visible)
+{
+	const std::size_t count = spheres.Size();
+	std::size_t index = 0;
+
+#if defined(MISTRAL_GEOMETRY_AVX) || defined(MISTRAL_GEOMETRY_SSE)
+	constexpr uint32_t allLanes = (1u << Lanes::Width) - 1;
+	const Lanes::Type zero = Lanes::Set(0.f);
+
+	for (; index + Lanes::Width <= count; index += Lanes::Width)
+	{
+		const Lanes::Type x = Lanes::Load(&spheres.centerX[index]);
+		const Lanes::Type y = Lanes::Load(&spheres.centerY[index]);
+		const Lanes::Type z = Lanes::Load(&spheres.centerZ[index]);
+		const Lanes::Type radius = Lanes::Load(&spheres.radius[index]);
+
+		uint32_t mask = allLanes;
+		for (const Plane& plane : frustum.planes)
+		{
+			const Lanes::Type distance = Lanes::Add(Lanes::Add(Lanes::Mul(x, Lanes::Set(plane.normal.x)), Lanes::Mul(y, Lanes::Set(plane.normal.y))),
+													Lanes::Add(Lanes::Mul(z, Lanes::Set(plane.normal.z)), Lanes::Set(plane.distance)));
+			mask &= Lanes::GreaterEqual(Lanes::Add(distance, radius), zero);
+			if (mask == 0)
+			{
+				break;
+			}
+		}
+
+		for (; mask != 0; mask &= mask - 1)
+		{
+			visible.push_back(static_cast<uint32_t>(index) + static_cast<uint32_t>(std::countr_zero(mask)));
+		}
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		const Sphere sphere = {{spheres.centerX[index], spheres.centerY[index], spheres.centerZ[index]}, spheres.radius[index]};
+		if (frustum.Intersects(sphere))
+		{
+			visible.push_back(static_cast<uint32_t>(index));
+		}
+	}
+}
+
+void CullAabbs(const Frustum& frustum, const AabbBatch& aabbs, std::vector<uint32_t>& visible)
+{
+	const std::size_t count = aabbs.Size();
+	std::size_t index = 0;
+
+#if defined(MISTRAL_GEOMETRY_AVX) || defined(MISTRAL_GEOMETRY_SSE)
+	constexpr uint32_t allLanes = (1u << Lanes::Width) - 1;
+	const Lanes::Type zero = Lanes::Set(0.f);
+
+	for (; index + Lanes::Width <= count; index += Lanes::Width)
+	{
+		uint32_t mask = allLanes;
+		for (const Plane& plane : frustum.planes)
+		{
+			// The corner farthest along the normal only depends on the plane, so the arrays are picked once for every lane
+			const float* x = plane.normal.x > 0.f ? &aabbs.maxX[index] : &aabbs.minX[index];
+			const float* y = plane.normal.y > 0.f ? &aabbs.maxY[index] : &aabbs.minY[index];
+			const float* z = plane.normal.z > 0.f ? &aabbs.maxZ[index] : &aabbs.minZ[index];
+
+			const Lanes::Type distance =
+				Lanes::Add(Lanes::Add(Lanes::Mul(Lanes::Load(x), Lanes::Set(plane.normal.x)), Lanes::Mul(Lanes::Load(y), Lanes::Set(plane.normal.y))),
+						   Lanes::Add(Lanes::Mul(Lanes::Load(z), Lanes::Set(plane.normal.z)), Lanes::Set(plane.distance)));
+			mask &= Lanes::GreaterEqual(distance, zero);
+			if (mask == 0)
+			{
+				break;
+			}
+		}
+
+		for (; mask != 0; mask &= mask - 1)
+		{
+			visible.push_back(static_cast<uint32_t>(index) + static_cast<uint32_t>(std::countr_zero(mask)));
+		}
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		const Aabb aabb = {{aabbs.minX[index], aabbs.minY[index], aabbs.minZ[index]}, {aabbs.maxX[index], aabbs.maxY[index], aabbs.maxZ[index]}};
+		if (frustum.Intersects(aabb))
+		{
+			visible.push_back(static_cast<uint32_t>(index));
+		}
+	}
+}
+
+void IntersectRay(const Ray3& ray, const AabbBatch& aabbs, const float maxDistance, const std::span<float> distances)
+{
+	assert(distances.size() >= aabbs.Size());
+
+	std::fill_n(distances.begin(), aabbs.Size(), -1.f);
+	ForEachRayHit(ray, aabbs, maxDistance, [&](const uint32_t index, const float distance) {
+		distances[index] = distance;
+		return maxDistance;
+	});
+}
+
+int32_t RaycastClosest(const Ray3& ray, const AabbBatch& aabbs, const float maxDistance, float* distance)
+{
+	int32_t closest = -1;
+	float closestDistance = maxDistance;
+
+	ForEachRayHit(ray, aabbs, maxDistance, [&](const uint32_t index, const float hitDistance) {
+		if (closest < 0 || hitDistance < closestDistance)
+		{
+			closest = static_cast<int32_t>(index);
+			closestDistance = hitDistance;
+		}
+		return closestDistance;
+	});
+
+	if (distance && closest >= 0)
+	{
+		*distance = closestDistance;
+	}
+	return closest;
+}
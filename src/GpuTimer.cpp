@@ -0,0 +1,63 @@
+#include "GpuTimer.h"
+
+#include "external/glad.h"
+#include "rlgl.h"
+
+Mistral::GpuTimer::~GpuTimer()
+{
+	if (mCreated)
+	{
+		glDeleteQueries(FramesInFlight * 2, &mQueries[0][0]);
+	}
+}
+
+void Mistral::GpuTimer::Begin()
+{
+	// Queries need a live context, so they are created on first use rather than in the constructor
+	if (!mCreated)
+	{
+		glGenQueries(FramesInFlight * 2, &mQueries[0][0]);
+		mCreated = true;
+	}
+
+	// Collect the oldest measurement before its queries are reused
+	auto& queries = mQueries[mFrame];
+	if (mPending[mFrame])
+	{
+		GLint available = 0;
+		glGetQueryObjectiv(queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available)
+		{
+			GLuint64 start = 0;
+			GLuint64 end = 0;
+			glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &start);
+			glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &end);
+			mMilliseconds = static_cast<double>(end - start) * 1e-6;
+		}
+
+		// A result that is still not available after several frames is dropped instead of stalling
+		mPending[mFrame] = false;
+	}
+
+	rlDrawRenderBatchActive();
+	glQueryCounter(queries[0], GL_TIMESTAMP);
+}
+
+void Mistral::GpuTimer::End()
+{
+	if (!mCreated)
+	{
+		return;
+	}
+
+	rlDrawRenderBatchActive();
+	glQueryCounter(mQueries[mFrame][1], GL_TIMESTAMP);
+	mPending[mFrame] = true;
+	mFrame = (mFrame + 1) % FramesInFlight;
+}
+
+// Getters
+double Mistral::GpuTimer::GetMilliseconds() const
+{
+	return mMilliseconds;
+}
@@ -0,0 +1,188 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Batch
+	{
+		const std::function<void(uint32_t, uint32_t)>* job = nullptr;
+		uint32_t count = 0;
+		uint32_t chunkSize = 1;
+		std::atomic<uint32_t> nextChunk = 0;
+		uint32_t activeWorkers = 0;
+	};
+
+	thread_local bool insideJob = false;
+
+	void RunChunks(Batch& batch)
+	{
+		const uint32_t chunkCount = (batch.count + batch.chunkSize - 1) / batch.chunkSize;
+
+		for (uint32_t chunk = batch.nextChunk++; chunk < chunkCount; chunk = batch.nextChunk++)
+		{
+			const uint32_t begin = chunk * batch.chunkSize;
+			const uint32_t end = std::min(begin + batch.chunkSize, batch.count);
+			(*batch.job)(begin, end);
+		}
+	}
+
+	class WorkerPool
+	{
+	  public:
+
+		explicit WorkerPool(const uint32_t workerCount)
+		{
+			for (uint32_t index = 0; index < workerCount; index++)
+			{
+				mThreads.emplace_back([this] { WorkerLoop(); });
+			}
+		}
+
+		~WorkerPool()
+		{
+			{
+				std::scoped_lock lock(mMutex);
+				mStop = true;
+			}
+			mWakeCondition.notify_all();
+
+			for (auto& thread : mThreads)
+			{
+				thread.join();
+			}
+		}
+
+		[[nodiscard]] uint32_t GetThreadCount() const
+		{
+			return static_cast<uint32_t>(mThreads.size());
+		}
+
+		void Run(Batch& batch)
+		{
+			std::scoped_lock dispatchLock(mDispatchMutex);
+
+			{
+				std::scoped_lock lock(mMutex);
+				mCurrent = &batch;
+				mGeneration++;
+			}
+			mWakeCondition.notify_all();
+
+			insideJob = true;
+			RunChunks(batch);
+			insideJob = false;
+
+			std::unique_lock lock(mMutex);
+			mDoneCondition.wait(lock, [&batch] { return batch.activeWorkers == 0; });
+			mCurrent = nullptr;
+		}
+
+	  private:
+
+		void WorkerLoop()
+		{
+			insideJob = true;
+			uint64_t seenGeneration = 0;
+
+			while (true)
+			{
+				std::unique_lock lock(mMutex);
+				mWakeCondition.wait(lock, [this, &seenGeneration] { return mStop || mGeneration != seenGeneration; });
+
+				if (mStop)
+				{
+					return;
+				}
+
+				seenGeneration = mGeneration;
+				Batch* batch = mCurrent;
+				if (!batch)
+				{
+					continue;
+				}
+
+				batch->activeWorkers++;
+				lock.unlock();
+
+				RunChunks(*batch);
+
+				lock.lock();
+				if (--batch->activeWorkers == 0)
+				{
+					mDoneCondition.notify_all();
+				}
+			}
+		}
+
+		std::vector<std::thread> mThreads;
+		std::mutex mMutex;
+		std::mutex mDispatchMutex;
+		std::condition_variable mWakeCondition;
+		std::condition_variable mDoneCondition;
+		Batch* mCurrent = nullptr;
+		uint64_t mGeneration = 0;
+		bool mStop = false;
+	};
+
+	std::unique_ptr<WorkerPool> workerPool;
+	std::mutex workerPoolMutex;
+
+	WorkerPool& GetWorkerPool()
+	{
+		std::scoped_lock lock(workerPoolMutex);
+		if (!workerPool)
+		{
+			const uint32_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+			workerPool = std::make_unique<WorkerPool>(threadCount - 1);
+		}
+		return *workerPool;
+	}
+} // namespace
+
+void Mistral::ParallelFor(const uint32_t count, const uint32_t chunkSize, const std::function<void(uint32_t begin, uint32_t end)>& job)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	const uint32_t safeChunkSize = std::max(chunkSize, 1u);
+
+	if (insideJob || count <= safeChunkSize)
+	{
+		job(0, count);
+		return;
+	}
+
+	WorkerPool& pool = GetWorkerPool();
+	if (pool.GetThreadCount() == 0)
+	{
+		job(0, count);
+		return;
+	}
+
+	Batch batch;
+	batch.job = &job;
+	batch.count = count;
+	batch.chunkSize = safeChunkSize;
+	pool.Run(batch);
+}
+
+uint32_t Mistral::GetWorkerCount()
+{
+	return GetWorkerPool().GetThreadCount() + 1;
+}
+
+void Mistral::SetWorkerCount(const uint32_t count)
+{
+	std::scoped_lock lock(workerPoolMutex);
+	workerPool.reset();
+	workerPool = std::make_unique<WorkerPool>(std::max(count, 1u) - 1);
+}
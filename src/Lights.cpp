@@ -0,0 +1,40 @@
+#include "Lights.h"
+
+#include <stdexcept>
+
+namespace
+{
+	std::map<uint32_t, Mistral::PointLight> pointLights;
+	uint32_t nextLightId = 1;
+} // namespace
+
+uint32_t Mistral::AddPointLight(const PointLight& light)
+{
+	const uint32_t lightId = nextLightId++;
+	pointLights.emplace(lightId, light);
+	return lightId;
+}
+
+void Mistral::RemovePointLight(const uint32_t lightId)
+{
+	pointLights.erase(lightId);
+}
+
+Mistral::PointLight& Mistral::GetPointLight(const uint32_t lightId)
+{
+	if (!pointLights.contains(lightId))
+	{
+		throw std::runtime_error("Point light not found");
+	}
+	return pointLights[lightId];
+}
+
+std::ranges::values_view<std::ranges::ref_view<std::map<uint32_t, Mistral::PointLight>>> Mistral::GetPointLightsView()
+{
+	return pointLights | std::views::values;
+}
+
+uint32_t Mistral::GetPointLightsCount()
+{
+	return pointLights.size();
+}
@@ -0,0 +1,381 @@
+#include "Lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "Matrix.h"
+#include "MeshOptimizer.h"
+#include "Mistral.h"
+#include "Spatial.h"
+
+namespace
+{
+	float lodBias = 1.f;
+	float lodHysteresis = .1f;
+
+	constexpr float defaultScreenSizes[Mistral::LodMaxLevels] = {.25f, .12f, .05f, 0.f};
+
+	uint32_t GetTriangleVertex(const Mesh& mesh, const int triangle, const int corner)
+	{
+		const int index = triangle * 3 + corner;
+		return mesh.indices ? mesh.indices[index] : static_cast<uint32_t>(index);
+	}
+
+	Vec3 GetVertexPosition(const Mesh& mesh, const uint32_t vertex)
+	{
+		return {mesh.vertices[vertex * 3], mesh.vertices[vertex * 3 + 1], mesh.vertices[vertex * 3 + 2]};
+	}
+
+	// Maps every vertex to a grid cell of cellSize and returns the triangles that stay non degenerate
+	uint32_t ClusterVertices(const Mesh& mesh, const Vec3& boundsMin, const float cellSize, std::vector<uint32_t>& vertexClusters,
+							 std::vector<uint32_t>& triangles)
+	{
+		std::unordered_map<uint64_t, uint32_t> cellClusters;
+		vertexClusters.resize(mesh.vertexCount);
+
+		for (int vertex = 0; vertex < mesh.vertexCount; vertex++)
+		{
+			const Vec3 cell = (GetVertexPosition(mesh, vertex) - boundsMin) / cellSize;
+			const uint64_t key = static_cast<uint64_t>(cell.x) | static_cast<uint64_t>(cell.y) << 21 | static_cast<uint64_t>(cell.z) << 42;
+
+			const auto [iterator, inserted] = cellClusters.try_emplace(key, static_cast<uint32_t>(cellClusters.size()));
+			vertexClusters[vertex] = iterator->second;
+		}
+
+		triangles.clear();
+		for (int triangle = 0; triangle < mesh.triangleCount; triangle++)
+		{
+			const uint32_t a = vertexClusters[GetTriangleVertex(mesh, triangle, 0)];
+			const uint32_t b = vertexClusters[GetTriangleVertex(mesh, triangle, 1)];
+			const uint32_t c = vertexClusters[GetTriangleVertex(mesh, triangle, 2)];
+
+			if (a != b && b != c && a != c)
+			{
+				triangles.insert(triangles.end(), {a, b, c});
+			}
+		}
+
+		return static_cast<uint32_t>(cellClusters.size());
+	}
+
+	Model GenerateLodLevel(const Model& source, const float ratio)
+	{
+		// Materials, bones and bind pose stay owned by the source model
+		Model model = source;
+		model.meshes = static_cast<Mesh*>(RL_CALLOC(source.meshCount, sizeof(Mesh)));
+		model.meshMaterial = static_cast<int*>(RL_CALLOC(source.meshCount, sizeof(int)));
+		std::memcpy(model.meshMaterial, source.meshMaterial, source.meshCount * sizeof(int));
+
+		for (int index = 0; index < source.meshCount; index++)
+		{
+			model.meshes[index] = Mistral::SimplifyMesh(source.meshes[index], ratio);
+		}
+
+		// Optimized before the upload, OptimizeModel only uploads again the meshes already on the GPU
+		if (Mistral::IsMeshOptimizationEnabled())
+		{
+			Mistral::OptimizeModel(model);
+		}
+
+		for (int index = 0; index < model.meshCount; index++)
+		{
+			UploadMesh(&model.meshes[index], false);
+		}
+
+		return model;
+	}
+
+	// Same import pass as the models loaded through ResourceLoad
+	Model LoadLodLevel(const std::filesystem::path& path)
+	{
+		Model model = LoadModel(path.string().c_str());
+		if (Mistral::IsMeshOptimizationEnabled())
+		{
+			Mistral::OptimizeModel(model);
+		}
+		return model;
+	}
+} // namespace
+
+// Loading
+Mistral::LodModel Mistral::LoadLodModel(const std::filesystem::path& path, const uint32_t generatedLevels)
+{
+	LodModel lodModel = {};
+	lodModel.levels[0] = LoadLodLevel(path);
+	lodModel.levelCount = 1;
+
+	// Authored levels live next to the source as <name>_lod<level><extension>
+	for (uint32_t level = 1; level < LodMaxLevels; level++)
+	{
+		const auto levelPath = path.parent_path() / (path.stem().string() + "_lod" + std::to_string(level) + path.extension().string());
+		if (!std::filesystem::exists(levelPath))
+		{
+			break;
+		}
+
+		lodModel.levels[level] = LoadLodLevel(levelPath);
+		lodModel.levelCount++;
+	}
+
+	if (lodModel.levelCount == 1 && lodModel.levels[0].boneCount == 0)
+	{
+		const uint32_t levelCount = std::min(generatedLevels + 1, LodMaxLevels);
+		for (uint32_t level = 1; level < levelCount; level++)
+		{
+			lodModel.levels[level] = GenerateLodLevel(lodModel.levels[0], std::pow(.5f, static_cast<float>(level)));
+			lodModel.generated[level] = true;
+			lodModel.levelCount++;
+		}
+	}
+
+	for (uint32_t level = 0; level < lodModel.levelCount; level++)
+	{
+		lodModel.screenSizes[level] = level + 1 < lodModel.levelCount ? defaultScreenSizes[level] : 0.f;
+	}
+
+	const BoundingBox bounds = GetModelBoundingBox(lodModel.levels[0]);
+	lodModel.boundsCenter = (Vec3(bounds.min) + Vec3(bounds.max)) * .5f;
+	lodModel.boundsRadius = (Vec3(bounds.max) - Vec3(bounds.min)).Length() * .5f;
+
+	return lodModel;
+}
+
+void Mistral::UnloadLodModel(const LodModel& lodModel)
+{
+	for (uint32_t level = lodModel.levelCount; level-- > 0;)
+	{
+		const Model& model = lodModel.levels[level];
+
+		if (!lodModel.generated[level])
+		{
+			UnloadModel(model);
+			continue;
+		}
+
+		for (int index = 0; index < model.meshCount; index++)
+		{
+			UnloadMesh(model.meshes[index]);
+		}
+		RL_FREE(model.meshes);
+		RL_FREE(model.meshMaterial);
+	}
+}
+
+Mesh Mistral::SimplifyMesh(const Mesh& mesh, const float ratio)
+{
+	Mesh result = {};
+	if (!mesh.vertices || mesh.triangleCount == 0)
+	{
+		return result;
+	}
+
+	Vec3 boundsMin = GetVertexPosition(mesh, 0);
+	Vec3 boundsMax = boundsMin;
+	for (int vertex = 1; vertex < mesh.vertexCount; vertex++)
+	{
+		const Vec3 position = GetVertexPosition(mesh, vertex);
+		boundsMin = {std::min(boundsMin.x, position.x), std::min(boundsMin.y, position.y), std::min(boundsMin.z, position.z)};
+		boundsMax = {std::max(boundsMax.x, position.x), std::max(boundsMax.y, position.y), std::max(boundsMax.z, position.z)};
+	}
+
+	const Vec3 extent = boundsMax - boundsMin;
+	const float largestExtent = std::max({extent.x, extent.y, extent.z, 1e-6f});
+	const auto targetTriangles = static_cast<size_t>(static_cast<float>(mesh.triangleCount) * std::clamp(ratio, 0.f, 1.f));
+
+	// Search the grid resolution whose output triangle count is closest to the target from below
+	std::vector<uint32_t> vertexClusters;
+	std::vector<uint32_t> triangles;
+	uint32_t low = 1;
+	uint32_t high = 1u << 20;
+	uint32_t bestResolution = 1;
+
+	for (int iteration = 0; iteration < 20 && low <= high; iteration++)
+	{
+		const uint32_t resolution = low + (high - low) / 2;
+		ClusterVertices(mesh, boundsMin, largestExtent / static_cast<float>(resolution) * 1.0001f, vertexClusters, triangles);
+
+		if (triangles.size() / 3 <= targetTriangles)
+		{
+			bestResolution = resolution;
+			low = resolution + 1;
+		}
+		else
+		{
+			high = resolution - 1;
+		}
+	}
+
+	const uint32_t clusterCount =
+		ClusterVertices(mesh, boundsMin, largestExtent / static_cast<float>(bestResolution) * 1.0001f, vertexClusters, triangles);
+
+	// Every cluster becomes the average of the vertices it contains
+	std::vector<float> positions(clusterCount * 3, 0.f);
+	std::vector<float> normals(mesh.normals ? clusterCount * 3 : 0, 0.f);
+	std::vector<float> texcoords(mesh.texcoords ? clusterCount * 2 : 0, 0.f);
+	std::vector<uint32_t> colors(mesh.colors ? clusterCount * 4 : 0, 0);
+	std::vector<uint32_t> weights(clusterCount, 0);
+
+	for (int vertex = 0; vertex < mesh.vertexCount; vertex++)
+	{
+		const uint32_t cluster = vertexClusters[vertex];
+		weights[cluster]++;
+
+		for (int component = 0; component < 3; component++)
+		{
+			positions[cluster * 3 + component] += mesh.vertices[vertex * 3 + component];
+			if (mesh.normals)
+			{
+				normals[cluster * 3 + component] += mesh.normals[vertex * 3 + component];
+			}
+		}
+
+		for (int component = 0; mesh.texcoords && component < 2; component++)
+		{
+			texcoords[cluster * 2 + component] += mesh.texcoords[vertex * 2 + component];
+		}
+
+		for (int component = 0; mesh.colors && component < 4; component++)
+		{
+			colors[cluster * 4 + component] += mesh.colors[vertex * 4 + component];
+		}
+	}
+
+	const bool indexed = clusterCount <= 65535;
+	const auto outputVertexCount = static_cast<int>(indexed ? clusterCount : triangles.size());
+
+	result.vertexCount = outputVertexCount;
+	result.triangleCount = static_cast<int>(triangles.size() / 3);
+	result.vertices = static_cast<float*>(RL_MALLOC(outputVertexCount * 3 * sizeof(float)));
+	result.normals = mesh.normals ? static_cast<float*>(RL_MALLOC(outputVertexCount * 3 * sizeof(float))) : nullptr;
+	result.texcoords = mesh.texcoords ? static_cast<float*>(RL_MALLOC(outputVertexCount * 2 * sizeof(float))) : nullptr;
+	result.colors = mesh.colors ? static_cast<unsigned char*>(RL_MALLOC(outputVertexCount * 4)) : nullptr;
+
+	const auto writeVertex = [&](const int target, const uint32_t cluster) {
+		const auto weight = static_cast<float>(std::max(weights[cluster], 1u));
+
+		for (int component = 0; component < 3; component++)
+		{
+			result.vertices[target * 3 + component] = positions[cluster * 3 + component] / weight;
+		}
+
+		if (result.normals)
+		{
+			const Vec3 normal = Vec3(normals[cluster * 3], normals[cluster * 3 + 1], normals[cluster * 3 + 2]).Normalized();
+			result.normals[target * 3] = normal.x;
+			result.normals[target * 3 + 1] = normal.y;
+			result.normals[target * 3 + 2] = normal.z;
+		}
+
+		for (int component = 0; result.texcoords && component < 2; component++)
+		{
+			result.texcoords[target * 2 + component] = texcoords[cluster * 2 + component] / weight;
+		}
+
+		for (int component = 0; result.colors && component < 4; component++)
+		{
+			result.colors[target * 4 + component] = static_cast<unsigned char>(colors[cluster * 4 + component] / std::max(weights[cluster], 1u));
+		}
+	};
+
+	if (indexed)
+	{
+		for (uint32_t cluster = 0; cluster < clusterCount; cluster++)
+		{
+			writeVertex(static_cast<int>(cluster), cluster);
+		}
+
+		result.indices = static_cast<unsigned short*>(RL_MALLOC(triangles.size() * sizeof(unsigned short)));
+		for (size_t index = 0; index < triangles.size(); index++)
+		{
+			result.indices[index] = static_cast<unsigned short>(triangles[index]);
+		}
+	}
+	else
+	{
+		for (size_t index = 0; index < triangles.size(); index++)
+		{
+			writeVertex(static_cast<int>(index), triangles[index]);
+		}
+	}
+
+	return result;
+}
+
+// Selection
+float Mistral::GetProjectedScreenSize(const Vec3& center, const float radius, const Camera3D& camera)
+{
+	if (camera.projection == CAMERA_ORTHOGRAPHIC)
+	{
+		return 2.f * radius / std::max(camera.fovy, 1e-6f);
+	}
+
+	const float distance = std::max(center.Distance(camera.position), 1e-6f);
+	return radius / (distance * std::tan(camera.fovy * DEG2RAD * .5f));
+}
+
+uint32_t Mistral::SelectLodLevel(const LodModel& lodModel, const Spatial& spatial, const Camera3D& camera, const uint32_t currentLevel)
+{
+	if (lodModel.levelCount <= 1)
+	{
+		return 0;
+	}
+
+	const Vec3 scale = spatial.GetScale();
+	const Vec4 center = spatial.GetMatrix() * Vec4(Vec3(lodModel.boundsCenter), 1.f);
+	const float radius = lodModel.boundsRadius * std::max({scale.x, scale.y, scale.z});
+	const float screenSize = GetProjectedScreenSize(Vec3(center), radius, camera) * lodBias;
+
+	// Move one threshold at a time and only once the size is past it by the hysteresis margin
+	uint32_t level = std::min(currentLevel, lodModel.levelCount - 1);
+	while (level > 0 && screenSize >= lodModel.screenSizes[level - 1] * (1.f + lodHysteresis))
+	{
+		level--;
+	}
+	while (level + 1 < lodModel.levelCount && screenSize < lodModel.screenSizes[level] * (1.f - lodHysteresis))
+	{
+		level++;
+	}
+
+	return level;
+}
+
+void Mistral::DrawLodModel(const LodModel& lodModel, const Spatial& spatial, uint32_t& currentLevel, const Color tint)
+{
+	if (lodModel.levelCount == 0)
+	{
+		return;
+	}
+
+	if (const auto camera = GetActiveCamera())
+	{
+		currentLevel = SelectLodLevel(lodModel, spatial, *camera, currentLevel);
+	}
+
+	Model model = lodModel.levels[std::min(currentLevel, lodModel.levelCount - 1)];
+	model.transform = spatial.GetMatrix();
+	DrawModel(model, Vec3::Zero, 1.f, tint);
+}
+
+// Settings
+void Mistral::SetLodBias(const float bias)
+{
+	lodBias = std::max(bias, 0.f);
+}
+
+float Mistral::GetLodBias()
+{
+	return lodBias;
+}
+
+void Mistral::SetLodHysteresis(const float hysteresis)
+{
+	lodHysteresis = std::clamp(hysteresis, 0.f, .9f);
+}
+
+float Mistral::GetLodHysteresis()
+{
+	return lodHysteresis;
+}
@@ -0,0 +1,335 @@
+#include "LooseOctree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <queue>
+
+namespace
+{
+	uint32_t GetOctant(const Vec3& center, const Vec3& position)
+	{
+		return (position.x >= center.x ? 1u : 0u) | (position.y >= center.y ? 2u : 0u) | (position.z >= center.z ? 4u : 0u);
+	}
+
+	Vec3 GetOctantCenter(const Vec3& center, const float halfSize, const uint32_t octant)
+	{
+		const float offset = halfSize * .5f;
+		return {center.x + (octant & 1u ? offset : -offset), center.y + (octant & 2u ? offset : -offset),
+				center.z + (octant & 4u ? offset : -offset)};
+	}
+} // namespace
+
+Mistral::LooseOctree::LooseOctree(const float minNodeSize):
+	mMinHalfSize(std::max(minNodeSize, 1e-4f) * .5f)
+{
+}
+
+// Objects
+uint32_t Mistral::LooseOctree::Insert(const Vec3& position, const float radius, void* userData)
+{
+	uint32_t object = mFreeObjects;
+	if (object == NullIndex)
+	{
+		object = static_cast<uint32_t>(mObjects.size());
+		mObjects.emplace_back();
+	}
+	else
+	{
+		mFreeObjects = mObjects[object].node;
+	}
+
+	mObjects[object] = {position, std::max(radius, 0.f), userData, NullIndex, 0};
+	Link(object);
+	mCount++;
+	return object;
+}
+
+void Mistral::LooseOctree::Remove(const uint32_t object)
+{
+	assert(object < mObjects.size() && mObjects[object].slot != NullIndex);
+
+	Unlink(object);
+	mObjects[object].node = mFreeObjects;
+	mObjects[object].slot = NullIndex;
+	mFreeObjects = object;
+	mCount--;
+}
+
+void Mistral::LooseOctree::Move(const uint32_t object, const Vec3& position)
+{
+	Object& movedObject = mObjects[object];
+	movedObject.position = position;
+
+	// Still centered in the same node, the node is the one it would be inserted in anyway
+	if (Contains(movedObject.node, position))
+	{
+		return;
+	}
+
+	Unlink(object);
+	Link(object);
+}
+
+void Mistral::LooseOctree::Clear()
+{
+	mNodes.clear();
+	mObjects.clear();
+	mRoot = NullIndex;
+	mFreeNodes = NullIndex;
+	mFreeObjects = NullIndex;
+	mCount = 0;
+	mNodeCount = 0;
+}
+
+// Queries
+void Mistral::LooseOctree::QueryRadius(const Vec3& center, const float radius, std::vector<uint32_t>& results) const
+{
+	if (mRoot == NullIndex)
+	{
+		return;
+	}
+
+	thread_local std::vector<uint32_t> stack;
+	stack.clear();
+	stack.push_back(mRoot);
+
+	while (!stack.empty())
+	{
+		const Node& node = mNodes[stack.back()];
+		stack.pop_back();
+
+		for (const uint32_t object : node.objects)
+		{
+			const float reach = radius + mObjects[object].radius;
+			if ((mObjects[object].position - center).LengthSqr() <= reach * reach)
+			{
+				results.push_back(object);
+			}
+		}
+
+		for (const uint32_t child : node.children)
+		{
+			if (child != NullIndex && GetDistance(child, center) <= radius)
+			{
+				stack.push_back(child);
+			}
+		}
+	}
+}
+
+void Mistral::LooseOctree::FindNearest(const Vec3& point, const uint32_t count, std::vector<uint32_t>& results, const float maxDistance) const
+{
+	results.clear();
+	if (mRoot == NullIndex || count == 0)
+	{
+		return;
+	}
+
+	// Nodes are visited closest first and the search stops once no node can beat the farthest of the best objects
+	using Entry = std::pair<float, uint32_t>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<>> nodes;
+	std::vector<Entry> best; // Max heap on distance
+	nodes.emplace(GetDistance(mRoot, point), mRoot);
+
+	const auto limit = [&] { return best.size() < count ? maxDistance : best.front().first; };
+
+	while (!nodes.empty())
+	{
+		const auto [nodeDistance, index] = nodes.top();
+		nodes.pop();
+
+		if (nodeDistance > limit())
+		{
+			break;
+		}
+
+		const Node& node = mNodes[index];
+		for (const uint32_t object : node.objects)
+		{
+			const float distance = std::max((mObjects[object].position - point).Length() - mObjects[object].radius, 0.f);
+			if (distance > limit() || (best.size() == count && distance == limit()))
+			{
+				continue;
+			}
+
+			if (best.size() == count)
+			{
+				std::ranges::pop_heap(best);
+				best.pop_back();
+			}
+			best.emplace_back(distance, object);
+			std::ranges::push_heap(best);
+		}
+
+		for (const uint32_t child : node.children)
+		{
+			if (child != NullIndex)
+			{
+				if (const float childDistance = GetDistance(child, point); childDistance <= limit())
+				{
+					nodes.emplace(childDistance, child);
+				}
+			}
+		}
+	}
+
+	std::ranges::sort_heap(best);
+	std::ranges::transform(best, std::back_inserter(results), &Entry::second);
+}
+
+// Getters
+const Vec3& Mistral::LooseOctree::GetPosition(const uint32_t object) const
+{
+	return mObjects[object].position;
+}
+
+void* Mistral::LooseOctree::GetUserData(const uint32_t object) const
+{
+	return mObjects[object].userData;
+}
+
+uint32_t Mistral::LooseOctree::GetCount() const
+{
+	return mCount;
+}
+
+uint32_t Mistral::LooseOctree::GetNodeCount() const
+{
+	return mNodeCount;
+}
+
+// Internal
+bool Mistral::LooseOctree::Contains(const uint32_t node, const Vec3& position) const
+{
+	const Node& current = mNodes[node];
+	return std::abs(position.x - current.center.x) <= current.halfSize && std::abs(position.y - current.center.y) <= current.halfSize &&
+		   std::abs(position.z - current.center.z) <= current.halfSize;
+}
+
+float Mistral::LooseOctree::GetDistance(const uint32_t node, const Vec3& point) const
+{
+	const Node& current = mNodes[node];
+	const float looseSize = current.halfSize * 2.f;
+	const float x = std::max(std::abs(point.x - current.center.x) - looseSize, 0.f);
+	const float y = std::max(std::abs(point.y - current.center.y) - looseSize, 0.f);
+	const float z = std::max(std::abs(point.z - current.center.z) - looseSize, 0.f);
+	return std::sqrt(x * x + y * y + z * z);
+}
+
+uint32_t Mistral::LooseOctree::AllocateNode(const Vec3& center, const float halfSize, const uint32_t parent)
+{
+	uint32_t node = mFreeNodes;
+	if (node == NullIndex)
+	{
+		node = static_cast<uint32_t>(mNodes.size());
+		mNodes.emplace_back();
+	}
+	else
+	{
+		mFreeNodes = mNodes[node].parent;
+	}
+
+	Node& allocated = mNodes[node];
+	allocated.center = center;
+	allocated.halfSize = halfSize;
+	allocated.parent = parent;
+	std::ranges::fill(allocated.children, NullIndex);
+	allocated.childCount = 0;
+	allocated.objects.clear();
+	mNodeCount++;
+	return node;
+}
+
+void Mistral::LooseOctree::GrowRoot(const Vec3& position, const float radius)
+{
+	if (mRoot == NullIndex)
+	{
+		// Sized to a power of two of the minimum so nodes stay aligned on the same grid
+		float halfSize = mMinHalfSize;
+		while (halfSize < radius)
+		{
+			halfSize *= 2.f;
+		}
+
+		const float cellSize = halfSize * 2.f;
+		const Vec3 center = {(std::floor(position.x / cellSize) + .5f) * cellSize, (std::floor(position.y / cellSize) + .5f) * cellSize,
+							 (std::floor(position.z / cellSize) + .5f) * cellSize};
+		mRoot = AllocateNode(center, halfSize, NullIndex);
+		return;
+	}
+
+	// The old root becomes the octant of a root twice its size, extended towards the position
+	while (!Contains(mRoot, position) || radius > mNodes[mRoot].halfSize)
+	{
+		const Node& root = mNodes[mRoot];
+		const Vec3 direction = {position.x >= root.center.x ? 1.f : -1.f, position.y >= root.center.y ? 1.f : -1.f,
+								position.z >= root.center.z ? 1.f : -1.f};
+		const Vec3 center = root.center + direction * root.halfSize;
+		const Vec3 oldCenter = root.center;
+		const float halfSize = root.halfSize * 2.f;
+
+		const uint32_t oldRoot = mRoot;
+		mRoot = AllocateNode(center, halfSize, NullIndex);
+		mNodes[mRoot].children[GetOctant(center, oldCenter)] = oldRoot;
+		mNodes[mRoot].childCount = 1;
+		mNodes[oldRoot].parent = mRoot;
+	}
+}
+
+void Mistral::LooseOctree::Link(const uint32_t object)
+{
+	Object& linked = mObjects[object];
+	GrowRoot(linked.position, linked.radius);
+
+	// Descends while the child is still large enough for the object and above the minimum size
+	uint32_t node = mRoot;
+	while (true)
+	{
+		const float childHalfSize = mNodes[node].halfSize * .5f;
+		if (childHalfSize < mMinHalfSize || linked.radius > childHalfSize)
+		{
+			break;
+		}
+
+		const uint32_t octant = GetOctant(mNodes[node].center, linked.position);
+		uint32_t child = mNodes[node].children[octant];
+		if (child == NullIndex)
+		{
+			child = AllocateNode(GetOctantCenter(mNodes[node].center, mNodes[node].halfSize, octant), childHalfSize, node);
+			mNodes[node].children[octant] = child;
+			mNodes[node].childCount++;
+		}
+		node = child;
+	}
+
+	linked.node = node;
+	linked.slot = static_cast<uint32_t>(mNodes[node].objects.size());
+	mNodes[node].objects.push_back(object);
+}
+
+void Mistral::LooseOctree::Unlink(const uint32_t object)
+{
+	const Object& unlinked = mObjects[object];
+	uint32_t node = unlinked.node;
+
+	std::vector<uint32_t>& objects = mNodes[node].objects;
+	const uint32_t last = objects.back();
+	objects[unlinked.slot] = last;
+	mObjects[last].slot = unlinked.slot;
+	objects.pop_back();
+
+	// Empty leaves are released up to the first node still in use, the root is kept
+	while (node != mRoot && mNodes[node].objects.empty() && mNodes[node].childCount == 0)
+	{
+		const uint32_t parent = mNodes[node].parent;
+		std::ranges::replace(mNodes[parent].children, node, NullIndex);
+		mNodes[parent].childCount--;
+
+		mNodes[node].parent = mFreeNodes;
+		mFreeNodes = node;
+		mNodeCount--;
+		node = parent;
+	}
+}
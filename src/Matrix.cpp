@@ -1,6 +1,5 @@
 #include "Matrix.h"
 
-#include <cassert>
 #include <cmath>
 
 #include "Quaternion.h"
@@ -12,199 +11,46 @@ const Matrix4x4 Matrix4x4::Identity = {1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0
 Matrix4x4::Matrix4x4(const float m0, const float m1, const float m2, const float m3, const float m4, const float m5, const float m6, const float m7,
 					 const float m8, const float m9, const float m10, const float m11, const float m12, const float m13, const float m14,
 					 const float m15):
-	m0(m0),
-	m1(m1),
-	m2(m2),
-	m3(m3),
-	m4(m4),
-	m5(m5),
-	m6(m6),
-	m7(m7),
-	m8(m8),
-	m9(m9),
-	m10(m10),
-	m11(m11),
-	m12(m12),
-	m13(m13),
-	m14(m14),
-	m15(m15)
+	elements{m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15}
 {
 }
 
 Matrix4x4::Matrix4x4(const float value):
-	m0(value),
-	m1(value),
-	m2(value),
-	m3(value),
-	m4(value),
-	m5(value),
-	m6(value),
-	m7(value),
-	m8(value),
-	m9(value),
-	m10(value),
-	m11(value),
-	m12(value),
-	m13(value),
-	m14(value),
-	m15(value)
+	elements{value, value, value, value, value, value, value, value, value, value, value, value, value, value, value, value}
 {
 }
 
 // Copy constructors
 Matrix4x4::Matrix4x4(const Matrix& matrix):
-	m0(matrix.m0),
-	m1(matrix.m1),
-	m2(matrix.m2),
-	m3(matrix.m3),
-	m4(matrix.m4),
-	m5(matrix.m5),
-	m6(matrix.m6),
-	m7(matrix.m7),
-	m8(matrix.m8),
-	m9(matrix.m9),
-	m10(matrix.m10),
-	m11(matrix.m11),
-	m12(matrix.m12),
-	m13(matrix.m13),
-	m14(matrix.m14),
-	m15(matrix.m15)
+	elements{matrix.m0, matrix.m1, matrix.m2, matrix.m3, matrix.m4, matrix.m5, matrix.m6, matrix.m7,
+			 matrix.m8, matrix.m9, matrix.m10, matrix.m11, matrix.m12, matrix.m13, matrix.m14, matrix.m15}
 {
 }
 
 // Conversion operators
 Matrix4x4::operator Matrix() const
 {
-	return {m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15};
-}
-
-// Access operators
-float& Matrix4x4::operator[](const std::size_t index)
-{
-	assert(index <= 15);
-	switch (index)
-	{
-		case 0:
-			return m0;
-		case 1:
-			return m1;
-		case 2:
-			return m2;
-		case 3:
-			return m3;
-		case 4:
-			return m4;
-		case 5:
-			return m5;
-		case 6:
-			return m6;
-		case 7:
-			return m7;
-		case 8:
-			return m8;
-		case 9:
-			return m9;
-		case 10:
-			return m10;
-		case 11:
-			return m11;
-		case 12:
-			return m12;
-		case 13:
-			return m13;
-		case 14:
-			return m14;
-		case 15:
-			return m15;
-		default:
-			break;
-	}
-	return m0;
-}
-
-float Matrix4x4::operator[](const std::size_t index) const
-{
-	assert(index <= 15);
-	switch (index)
-	{
-		case 0:
-			return m0;
-		case 1:
-			return m1;
-		case 2:
-			return m2;
-		case 3:
-			return m3;
-		case 4:
-			return m4;
-		case 5:
-			return m5;
-		case 6:
-			return m6;
-		case 7:
-			return m7;
-		case 8:
-			return m8;
-		case 9:
-			return m9;
-		case 10:
-			return m10;
-		case 11:
-			return m11;
-		case 12:
-			return m12;
-		case 13:
-			return m13;
-		case 14:
-			return m14;
-		case 15:
-			return m15;
-		default:
-			break;
-	}
-	return m0;
+	// Raylib declares its fields row by row, so they are matched by name rather than by position
+	return {.m0 = m0, .m4 = m4, .m8 = m8, .m12 = m12, .m1 = m1, .m5 = m5, .m9 = m9, .m13 = m13,
+			.m2 = m2, .m6 = m6, .m10 = m10, .m14 = m14, .m3 = m3, .m7 = m7, .m11 = m11, .m15 = m15};
 }
 
 // Compound assignment operators
 Matrix4x4& Matrix4x4::operator+=(const Matrix4x4& matrix) noexcept
 {
-	m0 += matrix.m0;
-	m1 += matrix.m1;
-	m2 += matrix.m2;
-	m3 += matrix.m3;
-	m4 += matrix.m4;
-	m5 += matrix.m5;
-	m6 += matrix.m6;
-	m7 += matrix.m7;
-	m8 += matrix.m8;
-	m9 += matrix.m9;
-	m10 += matrix.m10;
-	m11 += matrix.m11;
-	m12 += matrix.m12;
-	m13 += matrix.m13;
-	m14 += matrix.m14;
-	m15 += matrix.m15;
+	for (std::size_t index = 0; index < 16; index++)
+	{
+		elements[index] += matrix.elements[index];
+	}
 	return *this;
 }
 
 Matrix4x4& Matrix4x4::operator-=(const Matrix4x4& matrix) noexcept
 {
-	m0 -= matrix.m0;
-	m1 -= matrix.m1;
-	m2 -= matrix.m2;
-	m3 -= matrix.m3;
-	m4 -= matrix.m4;
-	m5 -= matrix.m5;
-	m6 -= matrix.m6;
-	m7 -= matrix.m7;
-	m8 -= matrix.m8;
-	m9 -= matrix.m9;
-	m10 -= matrix.m10;
-	m11 -= matrix.m11;
-	m12 -= matrix.m12;
-	m13 -= matrix.m13;
-	m14 -= matrix.m14;
-	m15 -= matrix.m15;
+	for (std::size_t index = 0; index < 16; index++)
+	{
+		elements[index] -= matrix.elements[index];
+	}
 	return *this;
 }
 
@@ -217,22 +63,16 @@ Matrix4x4& Matrix4x4::operator*=(const Matrix4x4& matrix) noexcept
 // Arithmetic operators
 Matrix4x4 operator+(const Matrix4x4& leftOperand, const Matrix4x4& rightOperand) noexcept
 {
-	return {leftOperand.m0 + rightOperand.m0,	leftOperand.m1 + rightOperand.m1,	leftOperand.m2 + rightOperand.m2,
-			leftOperand.m3 + rightOperand.m3,	leftOperand.m4 + rightOperand.m4,	leftOperand.m5 + rightOperand.m5,
-			leftOperand.m6 + rightOperand.m6,	leftOperand.m7 + rightOperand.m7,	leftOperand.m8 + rightOperand.m8,
-			leftOperand.m9 + rightOperand.m9,	leftOperand.m10 + rightOperand.m10, leftOperand.m11 + rightOperand.m11,
-			leftOperand.m12 + rightOperand.m12, leftOperand.m13 + rightOperand.m13, leftOperand.m14 + rightOperand.m14,
-			leftOperand.m15 + rightOperand.m15};
+	Matrix4x4 result = leftOperand;
+	result += rightOperand;
+	return result;
 }
 
 Matrix4x4 operator-(const Matrix4x4& leftOperand, const Matrix4x4& rightOperand) noexcept
 {
-	return {leftOperand.m0 - rightOperand.m0,	leftOperand.m1 - rightOperand.m1,	leftOperand.m2 - rightOperand.m2,
-			leftOperand.m3 - rightOperand.m3,	leftOperand.m4 - rightOperand.m4,	leftOperand.m5 - rightOperand.m5,
-			leftOperand.m6 - rightOperand.m6,	leftOperand.m7 - rightOperand.m7,	leftOperand.m8 - rightOperand.m8,
-			leftOperand.m9 - rightOperand.m9,	leftOperand.m10 - rightOperand.m10, leftOperand.m11 - rightOperand.m11,
-			leftOperand.m12 - rightOperand.m12, leftOperand.m13 - rightOperand.m13, leftOperand.m14 - rightOperand.m14,
-			leftOperand.m15 - rightOperand.m15};
+	Matrix4x4 result = leftOperand;
+	result -= rightOperand;
+	return result;
 }
 
 Matrix4x4 operator*(const Matrix4x4& leftOperand, const Matrix4x4& rightOperand) noexcept
@@ -338,6 +178,40 @@ Matrix4x4 Matrix4x4::Inverted() const
 	return result;
 }
 
+Matrix4x4 Matrix4x4::AffineInverted() const
+{
+	// Cofactors of the 3x3 part, the inverse translation is the inverse 3x3 applied to the negated translation
+	const float c0 = m5 * m10 - m6 * m9;
+	const float c1 = m2 * m9 - m1 * m10;
+	const float c2 = m1 * m6 - m2 * m5;
+
+	const float det = m0 * c0 + m4 * c1 + m8 * c2;
+
+	if (fabsf(det) < 1e-6f)
+	{
+		return Matrix4x4::Identity;
+	}
+
+	const float invDet = 1.f / det;
+
+	Matrix4x4 result(0.f);
+	result.m0 = c0 * invDet;
+	result.m1 = c1 * invDet;
+	result.m2 = c2 * invDet;
+	result.m4 = (m6 * m8 - m4 * m10) * invDet;
+	result.m5 = (m0 * m10 - m2 * m8) * invDet;
+	result.m6 = (m2 * m4 - m0 * m6) * invDet;
+	result.m8 = (m4 * m9 - m5 * m8) * invDet;
+	result.m9 = (m1 * m8 - m0 * m9) * invDet;
+	result.m10 = (m0 * m5 - m1 * m4) * invDet;
+	result.m12 = -(result.m0 * m12 + result.m4 * m13 + result.m8 * m14);
+	result.m13 = -(result.m1 * m12 + result.m5 * m13 + result.m9 * m14);
+	result.m14 = -(result.m2 * m12 + result.m6 * m13 + result.m10 * m14);
+	result.m15 = 1.f;
+
+	return result;
+}
+
 float Matrix4x4::Determinant() const
 {
 	const float cofactor0 = m5 * (m10 * m15 - m14 * m11) - m9 * (m6 * m15 - m14 * m7) + m13 * (m6 * m11 - m10 * m7);
@@ -403,6 +277,18 @@ Vec3 Matrix4x4::GetScale() const
 	return {Vec3(m0, m1, m2).Length(), Vec3(m4, m5, m6).Length(), Vec3(m8, m9, m10).Length()};
 }
 
+Vec3 Matrix4x4::TransformPoint(const Vec3& point) const
+{
+	return {m0 * point.x + m4 * point.y + m8 * point.z + m12, m1 * point.x + m5 * point.y + m9 * point.z + m13,
+			m2 * point.x + m6 * point.y + m10 * point.z + m14};
+}
+
+Vec3 Matrix4x4::TransformVector(const Vec3& vector) const
+{
+	return {m0 * vector.x + m4 * vector.y + m8 * vector.z, m1 * vector.x + m5 * vector.y + m9 * vector.z,
+			m2 * vector.x + m6 * vector.y + m10 * vector.z};
+}
+
 // Static constructors
 Matrix4x4 Matrix4x4::FromPosition(const Vec3& position)
 {
@@ -410,9 +296,14 @@ Matrix4x4 Matrix4x4::FromPosition(const Vec3& position)
 }
 
 Matrix4x4 Matrix4x4::FromRotation(const Quat& rotation)
+{
+	return FromNormalizedRotation(rotation.Normalized());
+}
+
+Matrix4x4 Matrix4x4::FromNormalizedRotation(const Quat& rotation)
 {
 	Matrix4x4 result = Matrix4x4::Identity;
-	const Quat q = rotation.Normalized();
+	const Quat& q = rotation;
 
 	const float xx = q.x * q.x;
 	const float yy = q.y * q.y;
@@ -0,0 +1,505 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+#include "rlgl.h"
+#include "Vector.h"
+
+namespace
+{
+	bool meshOptimization = true;
+
+	// Matches MAX_MESH_VERTEX_BUFFERS in raylib 5.5, the size of the vboId array UploadMesh allocates
+	constexpr int meshVertexBufferCount = 9;
+
+	// Forsyth's linear-speed vertex cache optimization, https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+	constexpr uint32_t vertexCacheSize = 32;
+	constexpr float cacheDecayPower = 1.5f;
+	constexpr float lastTriangleScore = .75f;
+	constexpr float valenceBoostScale = 2.f;
+	constexpr float valenceBoostPower = .5f;
+	constexpr uint32_t maxValence = 64;
+
+	// Overdraw clusters are cut where the cache restarts, smaller runs are merged into the previous cluster
+	constexpr uint32_t overdrawCacheSize = 16;
+	constexpr uint32_t minClusterTriangles = 32;
+
+	struct ScoreTables
+	{
+		float cache[vertexCacheSize];
+		float valence[maxValence];
+
+		ScoreTables()
+		{
+			for (uint32_t position = 0; position < vertexCacheSize; position++)
+			{
+				if (position < 3)
+				{
+					cache[position] = lastTriangleScore;
+				}
+				else
+				{
+					const float scaler = 1.f / static_cast<float>(vertexCacheSize - 3);
+					cache[position] = std::pow(1.f - static_cast<float>(position - 3) * scaler, cacheDecayPower);
+				}
+			}
+
+			valence[0] = 0.f;
+			for (uint32_t count = 1; count < maxValence; count++)
+			{
+				valence[count] = valenceBoostScale * std::pow(static_cast<float>(count), -valenceBoostPower);
+			}
+		}
+	};
+
+	float GetVertexScore(const ScoreTables& tables, const int32_t cachePosition, const uint32_t remaining)
+	{
+		if (remaining == 0)
+		{
+			return -1.f;
+		}
+
+		const float cacheScore = cachePosition >= 0 ? tables.cache[cachePosition] : 0.f;
+		return cacheScore + tables.valence[std::min(remaining, maxValence - 1)];
+	}
+
+	// Gathers the attributes of every vertex into one blob so identical vertices can be found with a byte comparison
+	struct VertexLayout
+	{
+		std::vector<std::pair<const unsigned char*, size_t>> attributes;
+		size_t stride = 0;
+
+		explicit VertexLayout(const Mesh& mesh)
+		{
+			Add(mesh.vertices, 3 * sizeof(float));
+			Add(mesh.texcoords, 2 * sizeof(float));
+			Add(mesh.texcoords2, 2 * sizeof(float));
+			Add(mesh.normals, 3 * sizeof(float));
+			Add(mesh.tangents, 4 * sizeof(float));
+			Add(mesh.colors, 4);
+			Add(mesh.boneIds, 4);
+			Add(mesh.boneWeights, 4 * sizeof(float));
+		}
+
+		void Add(const void* data, const size_t size)
+		{
+			if (data)
+			{
+				attributes.emplace_back(static_cast<const unsigned char*>(data), size);
+				stride += size;
+			}
+		}
+	};
+
+	template <typename T>
+	void RemapAttribute(T*& data, const size_t components, const std::vector<uint32_t>& sourceVertices)
+	{
+		if (!data)
+		{
+			return;
+		}
+
+		auto* remapped = static_cast<T*>(RL_MALLOC(sourceVertices.size() * components * sizeof(T)));
+		for (size_t vertex = 0; vertex < sourceVertices.size(); vertex++)
+		{
+			std::memcpy(remapped + vertex * components, data + sourceVertices[vertex] * components, components * sizeof(T));
+		}
+
+		RL_FREE(data);
+		data = remapped;
+	}
+
+	std::vector<uint32_t> GetIndices(const Mesh& mesh)
+	{
+		std::vector<uint32_t> indices(static_cast<size_t>(mesh.triangleCount) * 3);
+		for (size_t index = 0; index < indices.size(); index++)
+		{
+			indices[index] = mesh.indices ? mesh.indices[index] : static_cast<uint32_t>(index);
+		}
+		return indices;
+	}
+
+	// Cuts the triangles into clusters at cache restarts and draws first the clusters facing away from the mesh center, which are the
+	// most likely to occlude the others
+	std::vector<uint32_t> OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<Vec3>& positions)
+	{
+		const size_t triangleCount = indices.size() / 3;
+		std::vector<uint32_t> clusterStarts = {0};
+		{
+			std::vector<uint32_t> cacheTimes(positions.size(), 0);
+			uint32_t time = overdrawCacheSize + 1;
+
+			for (size_t triangle = 0; triangle < triangleCount; triangle++)
+			{
+				uint32_t misses = 0;
+				for (int corner = 0; corner < 3; corner++)
+				{
+					const uint32_t vertex = indices[triangle * 3 + corner];
+					if (time - cacheTimes[vertex] > overdrawCacheSize)
+					{
+						cacheTimes[vertex] = time++;
+						misses++;
+					}
+				}
+
+				if (misses == 3 && triangle - clusterStarts.back() >= minClusterTriangles)
+				{
+					clusterStarts.push_back(static_cast<uint32_t>(triangle));
+				}
+			}
+		}
+
+		Vec3 meshCenter = Vec3::Zero;
+		for (const Vec3& position : positions)
+		{
+			meshCenter += position;
+		}
+		meshCenter = meshCenter / static_cast<float>(std::max<size_t>(positions.size(), 1));
+
+		const size_t clusterCount = clusterStarts.size();
+		std::vector<float> sortKeys(clusterCount);
+		for (size_t cluster = 0; cluster < clusterCount; cluster++)
+		{
+			const size_t end = cluster + 1 < clusterCount ? clusterStarts[cluster + 1] : triangleCount;
+			Vec3 center = Vec3::Zero;
+			Vec3 normal = Vec3::Zero;
+			float area = 0.f;
+
+			for (size_t triangle = clusterStarts[cluster]; triangle < end; triangle++)
+			{
+				const Vec3& a = positions[indices[triangle * 3]];
+				const Vec3& b = positions[indices[triangle * 3 + 1]];
+				const Vec3& c = positions[indices[triangle * 3 + 2]];
+
+				const Vec3 cross = (b - a).Cross(c - a);
+				const float triangleArea = cross.Length();
+				center += (a + b + c) * (triangleArea / 3.f);
+				normal += cross;
+				area += triangleArea;
+			}
+
+			center = area > 0.f ? center / area : meshCenter;
+			sortKeys[cluster] = (center - meshCenter).Dot(normal.Normalized());
+		}
+
+		std::vector<uint32_t> clusterOrder(clusterCount);
+		std::iota(clusterOrder.begin(), clusterOrder.end(), 0u);
+		std::ranges::stable_sort(clusterOrder, [&sortKeys](const uint32_t a, const uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+		for (const uint32_t cluster : clusterOrder)
+		{
+			const size_t end = cluster + 1 < clusterCount ? clusterStarts[cluster + 1] : triangleCount;
+			result.insert(result.end(), indices.begin() + clusterStarts[cluster] * 3, indices.begin() + static_cast<std::ptrdiff_t>(end * 3));
+		}
+		return result;
+	}
+
+	void UploadAgain(Mesh& mesh)
+	{
+		if (mesh.vaoId == 0)
+		{
+			return;
+		}
+
+		rlUnloadVertexArray(mesh.vaoId);
+		if (mesh.vboId)
+		{
+			for (int buffer = 0; buffer < meshVertexBufferCount; buffer++)
+			{
+				rlUnloadVertexBuffer(mesh.vboId[buffer]);
+			}
+			RL_FREE(mesh.vboId);
+		}
+
+		mesh.vaoId = 0;
+		mesh.vboId = nullptr;
+		UploadMesh(&mesh, false);
+	}
+} // namespace
+
+Mistral::MeshOptimizationStats Mistral::OptimizeMesh(Mesh& mesh)
+{
+	MeshOptimizationStats stats;
+	stats.verticesBefore = mesh.vertexCount;
+	stats.verticesAfter = mesh.vertexCount;
+	stats.acmrBefore = ComputeAcmr(mesh);
+	stats.acmrAfter = stats.acmrBefore;
+
+	if (!mesh.vertices || mesh.triangleCount == 0)
+	{
+		return stats;
+	}
+
+	const auto vertexCount = static_cast<uint32_t>(mesh.vertexCount);
+	const VertexLayout layout(mesh);
+
+	std::vector<unsigned char> blob(vertexCount * layout.stride);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++)
+	{
+		unsigned char* destination = blob.data() + vertex * layout.stride;
+		for (const auto& [data, size] : layout.attributes)
+		{
+			std::memcpy(destination, data + vertex * size, size);
+			destination += size;
+		}
+	}
+
+	// Weld by sorting the vertex blobs, runs of identical bytes become one vertex
+	std::vector<uint32_t> sorted(vertexCount);
+	std::iota(sorted.begin(), sorted.end(), 0u);
+	std::ranges::sort(sorted, [&blob, &layout](const uint32_t a, const uint32_t b) {
+		return std::memcmp(blob.data() + a * layout.stride, blob.data() + b * layout.stride, layout.stride) < 0;
+	});
+
+	std::vector<uint32_t> weldRemap(vertexCount);
+	std::vector<uint32_t> weldedSources;
+	for (size_t position = 0; position < sorted.size(); position++)
+	{
+		const uint32_t vertex = sorted[position];
+		if (position == 0 ||
+			std::memcmp(blob.data() + vertex * layout.stride, blob.data() + sorted[position - 1] * layout.stride, layout.stride) != 0)
+		{
+			weldedSources.push_back(vertex);
+		}
+		weldRemap[vertex] = static_cast<uint32_t>(weldedSources.size() - 1);
+	}
+
+	// raylib indices are 16 bits
+	if (weldedSources.size() > 65535)
+	{
+		return stats;
+	}
+
+	std::vector<uint32_t> indices = GetIndices(mesh);
+	for (uint32_t& index : indices)
+	{
+		index = weldRemap[index];
+	}
+
+	std::vector<Vec3> positions(weldedSources.size());
+	for (size_t vertex = 0; vertex < weldedSources.size(); vertex++)
+	{
+		const float* position = mesh.vertices + weldedSources[vertex] * 3;
+		positions[vertex] = {position[0], position[1], position[2]};
+	}
+
+	indices = OptimizeVertexCache(indices, static_cast<uint32_t>(weldedSources.size()));
+	indices = OptimizeOverdraw(indices, positions);
+
+	// Fetch order, vertices are renumbered by first use and unreferenced ones are dropped
+	std::vector<uint32_t> fetchRemap(weldedSources.size(), static_cast<uint32_t>(-1));
+	std::vector<uint32_t> sourceVertices;
+	for (uint32_t& index : indices)
+	{
+		if (fetchRemap[index] == static_cast<uint32_t>(-1))
+		{
+			fetchRemap[index] = static_cast<uint32_t>(sourceVertices.size());
+			sourceVertices.push_back(weldedSources[index]);
+		}
+		index = fetchRemap[index];
+	}
+
+	RemapAttribute(mesh.vertices, 3, sourceVertices);
+	RemapAttribute(mesh.texcoords, 2, sourceVertices);
+	RemapAttribute(mesh.texcoords2, 2, sourceVertices);
+	RemapAttribute(mesh.normals, 3, sourceVertices);
+	RemapAttribute(mesh.tangents, 4, sourceVertices);
+	RemapAttribute(mesh.colors, 4, sourceVertices);
+	RemapAttribute(mesh.animVertices, 3, sourceVertices);
+	RemapAttribute(mesh.animNormals, 3, sourceVertices);
+	RemapAttribute(mesh.boneIds, 4, sourceVertices);
+	RemapAttribute(mesh.boneWeights, 4, sourceVertices);
+
+	RL_FREE(mesh.indices);
+	mesh.indices = static_cast<unsigned short*>(RL_MALLOC(indices.size() * sizeof(unsigned short)));
+	for (size_t index = 0; index < indices.size(); index++)
+	{
+		mesh.indices[index] = static_cast<unsigned short>(indices[index]);
+	}
+	mesh.vertexCount = static_cast<int>(sourceVertices.size());
+
+	stats.verticesAfter = mesh.vertexCount;
+	stats.acmrAfter = ComputeAcmr(indices, static_cast<uint32_t>(sourceVertices.size()));
+	return stats;
+}
+
+void Mistral::OptimizeModel(Model& model)
+{
+	for (int index = 0; index < model.meshCount; index++)
+	{
+		const MeshOptimizationStats stats = OptimizeMesh(model.meshes[index]);
+		UploadAgain(model.meshes[index]);
+
+		std::cout << "[Info] Mesh " << index << " optimized: " << stats.verticesBefore << " -> " << stats.verticesAfter << " vertices, ACMR "
+				  << stats.acmrBefore << " -> " << stats.acmrAfter << std::endl;
+	}
+}
+
+std::vector<uint32_t> Mistral::OptimizeVertexCache(const std::span<const uint32_t> indices, const uint32_t vertexCount)
+{
+	static const ScoreTables tables;
+
+	const size_t triangleCount = indices.size() / 3;
+
+	// Triangles adjacent to every vertex, the remaining ones are kept at the front of each range
+	std::vector<uint32_t> remaining(vertexCount, 0);
+	for (const uint32_t index : indices)
+	{
+		remaining[index]++;
+	}
+
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++)
+	{
+		offsets[vertex + 1] = offsets[vertex] + remaining[vertex];
+	}
+
+	std::vector<uint32_t> adjacency(indices.size());
+	{
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t index = 0; index < indices.size(); index++)
+		{
+			adjacency[fill[indices[index]]++] = static_cast<uint32_t>(index / 3);
+		}
+	}
+
+	std::vector<int32_t> cachePositions(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (uint32_t vertex = 0; vertex < vertexCount; vertex++)
+	{
+		vertexScores[vertex] = GetVertexScore(tables, -1, remaining[vertex]);
+	}
+
+	std::vector<bool> emitted(triangleCount, false);
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> nextCache;
+	cache.reserve(vertexCacheSize + 3);
+	nextCache.reserve(vertexCacheSize + 3);
+
+	int64_t bestTriangle = -1;
+	size_t scanCursor = 0;
+
+	for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+	{
+		// Without a candidate from the cache, restart from the first triangle left, keeps the whole pass linear on disconnected meshes
+		if (bestTriangle < 0)
+		{
+			while (emitted[scanCursor])
+			{
+				scanCursor++;
+			}
+			bestTriangle = static_cast<int64_t>(scanCursor);
+		}
+
+		const auto triangle = static_cast<size_t>(bestTriangle);
+		emitted[triangle] = true;
+
+		nextCache.clear();
+		for (int corner = 0; corner < 3; corner++)
+		{
+			const uint32_t vertex = indices[triangle * 3 + corner];
+			result.push_back(vertex);
+			nextCache.push_back(vertex);
+
+			// Removes the triangle from the remaining adjacency of the vertex
+			const auto begin = adjacency.begin() + offsets[vertex];
+			const auto end = begin + remaining[vertex];
+			std::iter_swap(std::find(begin, end, static_cast<uint32_t>(triangle)), end - 1);
+			remaining[vertex]--;
+		}
+
+		for (const uint32_t vertex : cache)
+		{
+			if (vertex != nextCache[0] && vertex != nextCache[1] && vertex != nextCache[2])
+			{
+				nextCache.push_back(vertex);
+			}
+		}
+		std::swap(cache, nextCache);
+
+		// Vertices pushed out of the cache lose their cache score
+		for (size_t position = vertexCacheSize; position < cache.size(); position++)
+		{
+			cachePositions[cache[position]] = -1;
+			vertexScores[cache[position]] = GetVertexScore(tables, -1, remaining[cache[position]]);
+		}
+		cache.resize(std::min<size_t>(cache.size(), vertexCacheSize));
+
+		for (size_t position = 0; position < cache.size(); position++)
+		{
+			cachePositions[cache[position]] = static_cast<int32_t>(position);
+			vertexScores[cache[position]] = GetVertexScore(tables, static_cast<int32_t>(position), remaining[cache[position]]);
+		}
+
+		// Only the triangles touching the cache changed score, the best of them is the next candidate
+		bestTriangle = -1;
+		float bestScore = -1.f;
+		for (const uint32_t vertex : cache)
+		{
+			for (uint32_t adjacent = 0; adjacent < remaining[vertex]; adjacent++)
+			{
+				const uint32_t candidate = adjacency[offsets[vertex] + adjacent];
+				const float score = vertexScores[indices[candidate * 3]] + vertexScores[indices[candidate * 3 + 1]] +
+									vertexScores[indices[candidate * 3 + 2]];
+
+				if (score > bestScore)
+				{
+					bestScore = score;
+					bestTriangle = candidate;
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+float Mistral::ComputeAcmr(const std::span<const uint32_t> indices, const uint32_t vertexCount, const uint32_t cacheSize)
+{
+	if (indices.size() < 3)
+	{
+		return 0.f;
+	}
+
+	// FIFO cache, a vertex is a hit while fewer than cacheSize misses happened since it was loaded
+	std::vector<uint32_t> cacheTimes(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+	uint32_t misses = 0;
+
+	for (const uint32_t index : indices)
+	{
+		if (time - cacheTimes[index] > cacheSize)
+		{
+			cacheTimes[index] = time++;
+			misses++;
+		}
+	}
+
+	return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+float Mistral::ComputeAcmr(const Mesh& mesh, const uint32_t cacheSize)
+{
+	const std::vector<uint32_t> indices = GetIndices(mesh);
+	return ComputeAcmr(indices, static_cast<uint32_t>(mesh.vertexCount), cacheSize);
+}
+
+void Mistral::SetMeshOptimization(const bool enabled)
+{
+	meshOptimization = enabled;
+}
+
+bool Mistral::IsMeshOptimizationEnabled()
+{
+	return meshOptimization;
+}
@@ -1,10 +1,19 @@
 #include "Mistral.h"
 
+#include "Animation.h"
+#include "Cameras.h"
+#include "DebugDraw.h"
 #include "DefaultRenderPipeline.h"
+#include "DynamicBvh.h"
+#include "FramePacer.h"
+#include "Occlusion.h"
+#include "Resources.h"
+#include "SpriteBatch.h"
 
 namespace
 {
 	Camera3D* activeCamera;
+	Mistral::IRenderPipeline* activeRenderPipeline;
 }
 
 void Mistral::StartApplication(const std::string& applicationName, std::unique_ptr<IRenderPipeline> renderPipeline)
@@ -12,7 +21,7 @@ void Mistral::StartApplication(const std::string& applicationName, std::unique_p
 	SetTraceLogLevel(LOG_NONE);
 	SetConfigFlags(FLAG_MSAA_4X_HINT | FLAG_VSYNC_HINT | FLAG_WINDOW_RESIZABLE);
 	InitWindow(1280.f * 2.f, 720.f * 2.f, applicationName.c_str());
-	SetTargetFPS(165);
+	SetTargetFPS(0); // Paced by the frame pacer
 	rlImGuiSetup(true);
 	SetExitKey(KEY_NULL);
 
@@ -21,25 +30,66 @@ void Mistral::StartApplication(const std::string& applicationName, std::unique_p
 		renderPipeline = std::make_unique<DefaultRenderPipeline>();
 	}
 
+	activeRenderPipeline = renderPipeline.get();
 	renderPipeline->Initialize();
 
+	FramePacer& framePacer = GetFramePacer();
+
 	while (!WindowShouldClose())
 	{
+		framePacer.BeginFrame();
+
+#if defined(MISTRAL_CUSTOM_FRAME_CONTROL)
+		// Sampled after the pacer's wait, raylib no longer polls at the end of the previous frame
+		PollInputEvents();
+#endif
+
 		ComponentCreateEventCallback();
 
 		ComponentDestroyEventCallback();
 
 		ComponentUpdateEventCallback();
 
+		FlushTransforms();
+
+		UpdateAnimators(framePacer.GetFrameTime());
+
+		UpdateComponentBvh();
+
+		UpdateOcclusionCulling();
+
 		renderPipeline->RenderEvent();
+
+#if defined(MISTRAL_CUSTOM_FRAME_CONTROL)
+		SwapScreenBuffer();
+#endif
+
+		framePacer.EndFrame();
+
+		DebugDrawEndFrame(framePacer.GetFrameTime());
 	}
 
+	activeRenderPipeline = nullptr;
+	renderPipeline.reset();
+	UnloadSpriteBatch();
+	UnloadDebugDraw();
+	UnloadResources();
+
 	rlImGuiShutdown();
 	CloseWindow();
 }
 
+Mistral::IRenderPipeline* Mistral::GetRenderPipeline()
+{
+	return activeRenderPipeline;
+}
+
 Camera3D* Mistral::GetActiveCamera()
 {
+	if (const auto camera = GetRenderingCamera())
+	{
+		return camera;
+	}
 	return activeCamera;
 }
 
@@ -0,0 +1,514 @@
+#include "Occlusion.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Cameras.h"
+#include "JobSystem.h"
+#include "Mistral.h"
+#include "rlgl.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <xmmintrin.h>
+	#define MISTRAL_OCCLUSION_SSE
+#endif
+
+namespace
+{
+	constexpr uint32_t tileSize = 32;
+	constexpr uint32_t maxTestTexels = 4;
+
+	struct PendingOccluder
+	{
+		const Mesh* mesh;
+		Matrix4x4 transform;
+	};
+
+	bool occlusionCulling = false;
+	bool occlusionReady = false;
+	uint32_t occludedCount = 0;
+	uint32_t occlusionCameraId = 0;
+	std::vector<PendingOccluder> pendingOccluders;
+
+	Vec4 Lerp(const Vec4& from, const Vec4& to, const float amount)
+	{
+		return from + (to - from) * amount;
+	}
+} // namespace
+
+Mistral::OcclusionBuffer::OcclusionBuffer(const uint32_t width, const uint32_t height):
+	mWidth((std::max(width, 4u) + 3) & ~3u),
+	mHeight(std::max(height, 1u)),
+	mTilesX((mWidth + tileSize - 1) / tileSize),
+	mTilesY((mHeight + tileSize - 1) / tileSize)
+{
+	mTileTriangles.resize(mTilesX * mTilesY);
+
+	uint32_t levelWidth = mWidth;
+	uint32_t levelHeight = mHeight;
+	while (true)
+	{
+		mPyramid.emplace_back(levelWidth * levelHeight, 1.f);
+		if (levelWidth == 1 && levelHeight == 1)
+		{
+			break;
+		}
+		levelWidth = std::max(levelWidth / 2, 1u);
+		levelHeight = std::max(levelHeight / 2, 1u);
+	}
+}
+
+void Mistral::OcclusionBuffer::BeginFrame(const Matrix4x4& viewProjection)
+{
+	mViewProjection = viewProjection;
+	mTriangles.clear();
+	for (auto& tileTriangles : mTileTriangles)
+	{
+		tileTriangles.clear();
+	}
+	std::ranges::fill(mPyramid[0], 1.f);
+}
+
+void Mistral::OcclusionBuffer::AddOccluder(const std::span<const Vec3> vertices, const std::span<const uint32_t> indices, const Matrix4x4& transform)
+{
+	const Matrix4x4 modelViewProjection = mViewProjection * transform;
+
+	std::vector<Vec4> clipVertices(vertices.size());
+	std::ranges::transform(vertices, clipVertices.begin(),
+						   [&modelViewProjection](const Vec3& vertex) { return modelViewProjection * Vec4(vertex, 1.f); });
+
+	for (size_t index = 0; index + 2 < indices.size(); index += 3)
+	{
+		AddClipTriangle(clipVertices[indices[index]], clipVertices[indices[index + 1]], clipVertices[indices[index + 2]]);
+	}
+}
+
+void Mistral::OcclusionBuffer::AddOccluder(const Mesh& mesh, const Matrix4x4& transform)
+{
+	if (!mesh.vertices || mesh.vertexCount == 0)
+	{
+		return;
+	}
+
+	std::vector<Vec3> vertices(mesh.vertexCount);
+	for (int vertex = 0; vertex < mesh.vertexCount; vertex++)
+	{
+		vertices[vertex] = {mesh.vertices[vertex * 3], mesh.vertices[vertex * 3 + 1], mesh.vertices[vertex * 3 + 2]};
+	}
+
+	std::vector<uint32_t> indices(static_cast<size_t>(mesh.triangleCount) * 3);
+	for (size_t index = 0; index < indices.size(); index++)
+	{
+		indices[index] = mesh.indices ? mesh.indices[index] : static_cast<uint32_t>(index);
+	}
+
+	AddOccluder(vertices, indices, transform);
+}
+
+void Mistral::OcclusionBuffer::Rasterize()
+{
+	ParallelFor(mTilesX * mTilesY, 1, [this](const uint32_t begin, const uint32_t end) {
+		for (uint32_t tile = begin; tile < end; tile++)
+		{
+			RasterizeTile(tile);
+		}
+	});
+
+	BuildPyramid();
+}
+
+bool Mistral::OcclusionBuffer::IsVisible(const BoundingBox& bounds) const
+{
+	Vec2 screenMin(1e30f);
+	Vec2 screenMax(-1e30f);
+	float nearestDepth = 1.f;
+
+	for (int corner = 0; corner < 8; corner++)
+	{
+		const Vec3 point = {corner & 1 ? bounds.max.x : bounds.min.x, corner & 2 ? bounds.max.y : bounds.min.y,
+							corner & 4 ? bounds.max.z : bounds.min.z};
+		const Vec4 clip = mViewProjection * Vec4(point, 1.f);
+
+		// Boxes crossing the near plane are always visible
+		if (clip.z < -clip.w || clip.w <= 1e-6f)
+		{
+			return true;
+		}
+
+		const float x = (clip.x / clip.w * .5f + .5f) * static_cast<float>(mWidth);
+		const float y = (.5f - clip.y / clip.w * .5f) * static_cast<float>(mHeight);
+		screenMin = {std::min(screenMin.x, x), std::min(screenMin.y, y)};
+		screenMax = {std::max(screenMax.x, x), std::max(screenMax.y, y)};
+		nearestDepth = std::min(nearestDepth, clip.z / clip.w * .5f + .5f);
+	}
+
+	// Out of the screen is frustum culling business, not ours
+	if (screenMax.x < 0.f || screenMax.y < 0.f || screenMin.x >= static_cast<float>(mWidth) || screenMin.y >= static_cast<float>(mHeight))
+	{
+		return true;
+	}
+
+	auto minX = static_cast<uint32_t>(std::max(screenMin.x, 0.f));
+	auto minY = static_cast<uint32_t>(std::max(screenMin.y, 0.f));
+	auto maxX = static_cast<uint32_t>(std::min(screenMax.x, static_cast<float>(mWidth - 1)));
+	auto maxY = static_cast<uint32_t>(std::min(screenMax.y, static_cast<float>(mHeight - 1)));
+
+	// Walk down the pyramid until the box covers only a few texels
+	uint32_t level = 0;
+	uint32_t levelWidth = mWidth;
+	uint32_t levelHeight = mHeight;
+	while (level + 1 < mPyramid.size() && std::max(maxX - minX, maxY - minY) + 1 > maxTestTexels)
+	{
+		level++;
+		levelWidth = std::max(levelWidth / 2, 1u);
+		levelHeight = std::max(levelHeight / 2, 1u);
+		minX = std::min(minX / 2, levelWidth - 1);
+		minY = std::min(minY / 2, levelHeight - 1);
+		maxX = std::min(maxX / 2, levelWidth - 1);
+		maxY = std::min(maxY / 2, levelHeight - 1);
+	}
+
+	const std::vector<float>& depth = mPyramid[level];
+	for (uint32_t y = minY; y <= maxY; y++)
+	{
+		for (uint32_t x = minX; x <= maxX; x++)
+		{
+			if (nearestDepth <= depth[y * levelWidth + x])
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+// Getters
+uint32_t Mistral::OcclusionBuffer::GetWidth() const
+{
+	return mWidth;
+}
+
+uint32_t Mistral::OcclusionBuffer::GetHeight() const
+{
+	return mHeight;
+}
+
+float Mistral::OcclusionBuffer::GetDepth(const uint32_t x, const uint32_t y) const
+{
+	if (x >= mWidth || y >= mHeight)
+	{
+		return 1.f;
+	}
+	return mPyramid[0][y * mWidth + x];
+}
+
+uint32_t Mistral::OcclusionBuffer::GetOccluderTriangleCount() const
+{
+	return static_cast<uint32_t>(mTriangles.size());
+}
+
+// Internal
+void Mistral::OcclusionBuffer::AddClipTriangle(const Vec4& a, const Vec4& b, const Vec4& c)
+{
+	// Clip against the near plane (z >= -w), a triangle becomes at most a quad
+	const Vec4 input[3] = {a, b, c};
+	Vec4 polygon[4];
+	uint32_t vertexCount = 0;
+
+	for (int index = 0; index < 3; index++)
+	{
+		const Vec4& current = input[index];
+		const Vec4& next = input[(index + 1) % 3];
+		const float currentDistance = current.z + current.w;
+		const float nextDistance = next.z + next.w;
+
+		if (currentDistance >= 0.f)
+		{
+			polygon[vertexCount++] = current;
+		}
+
+		if ((currentDistance >= 0.f) != (nextDistance >= 0.f))
+		{
+			polygon[vertexCount++] = Lerp(current, next, currentDistance / (currentDistance - nextDistance));
+		}
+	}
+
+	if (vertexCount < 3)
+	{
+		return;
+	}
+
+	Vec3 screen[4];
+	for (uint32_t index = 0; index < vertexCount; index++)
+	{
+		const float inverseW = 1.f / std::max(polygon[index].w, 1e-6f);
+		screen[index] = {(polygon[index].x * inverseW * .5f + .5f) * static_cast<float>(mWidth),
+						 (.5f - polygon[index].y * inverseW * .5f) * static_cast<float>(mHeight), polygon[index].z * inverseW * .5f + .5f};
+	}
+
+	for (uint32_t index = 1; index + 1 < vertexCount; index++)
+	{
+		const ScreenTriangle triangle = {{screen[0], screen[index], screen[index + 1]}};
+		const Vec3& v0 = triangle.vertices[0];
+		const Vec3& v1 = triangle.vertices[1];
+		const Vec3& v2 = triangle.vertices[2];
+
+		const float minX = std::max(std::min({v0.x, v1.x, v2.x}), 0.f);
+		const float minY = std::max(std::min({v0.y, v1.y, v2.y}), 0.f);
+		const float maxX = std::min(std::max({v0.x, v1.x, v2.x}), static_cast<float>(mWidth - 1));
+		const float maxY = std::min(std::max({v0.y, v1.y, v2.y}), static_cast<float>(mHeight - 1));
+
+		if (minX > maxX || minY > maxY)
+		{
+			continue;
+		}
+
+		const auto triangleIndex = static_cast<uint32_t>(mTriangles.size());
+		mTriangles.push_back(triangle);
+
+		for (auto tileY = static_cast<uint32_t>(minY) / tileSize; tileY <= static_cast<uint32_t>(maxY) / tileSize; tileY++)
+		{
+			for (auto tileX = static_cast<uint32_t>(minX) / tileSize; tileX <= static_cast<uint32_t>(maxX) / tileSize; tileX++)
+			{
+				mTileTriangles[tileY * mTilesX + tileX].push_back(triangleIndex);
+			}
+		}
+	}
+}
+
+void Mistral::OcclusionBuffer::RasterizeTile(const uint32_t tile)
+{
+	const uint32_t tileMinX = tile % mTilesX * tileSize;
+	const uint32_t tileMinY = tile / mTilesX * tileSize;
+	const uint32_t tileMaxX = std::min(tileMinX + tileSize, mWidth);
+	const uint32_t tileMaxY = std::min(tileMinY + tileSize, mHeight);
+	std::vector<float>& depth = mPyramid[0];
+
+	for (const uint32_t triangleIndex : mTileTriangles[tile])
+	{
+		const ScreenTriangle& triangle = mTriangles[triangleIndex];
+		const Vec3& a = triangle.vertices[0];
+		Vec3 b = triangle.vertices[1];
+		Vec3 c = triangle.vertices[2];
+
+		// Occluders are double sided, flip clockwise triangles
+		float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (std::abs(area) < 1e-8f)
+		{
+			continue;
+		}
+		if (area < 0.f)
+		{
+			std::swap(b, c);
+			area = -area;
+		}
+
+		// Edge functions E(p) = (to.x - from.x) * (p.y - from.y) - (to.y - from.y) * (p.x - from.x), positive inside
+		const float stepX[3] = {-(c.y - b.y), -(a.y - c.y), -(b.y - a.y)};
+		const float stepY[3] = {c.x - b.x, a.x - c.x, b.x - a.x};
+		const Vec3* origins[3] = {&b, &c, &a};
+
+		const float inverseArea = 1.f / area;
+		const float depthStepX = (stepX[0] * a.z + stepX[1] * b.z + stepX[2] * c.z) * inverseArea;
+
+		const auto minX = std::max(static_cast<uint32_t>(std::max(std::min({a.x, b.x, c.x}), 0.f)), tileMinX) & ~3u;
+		const auto minY = std::max(static_cast<uint32_t>(std::max(std::min({a.y, b.y, c.y}), 0.f)), tileMinY);
+		const auto maxX = std::min(static_cast<uint32_t>(std::max(std::max({a.x, b.x, c.x}), 0.f)) + 1, tileMaxX);
+		const auto maxY = std::min(static_cast<uint32_t>(std::max(std::max({a.y, b.y, c.y}), 0.f)) + 1, tileMaxY);
+
+		for (uint32_t y = minY; y < maxY; y++)
+		{
+			const float pixelX = static_cast<float>(minX) + .5f;
+			const float pixelY = static_cast<float>(y) + .5f;
+
+			float edges[3];
+			for (int edge = 0; edge < 3; edge++)
+			{
+				edges[edge] = stepY[edge] * (pixelY - origins[edge]->y) + stepX[edge] * (pixelX - origins[edge]->x);
+			}
+			float rowDepth = (edges[0] * a.z + edges[1] * b.z + edges[2] * c.z) * inverseArea;
+			float* row = &depth[y * mWidth];
+
+#if defined(MISTRAL_OCCLUSION_SSE)
+			const __m128 lanes = _mm_set_ps(3.f, 2.f, 1.f, 0.f);
+			__m128 edge0 = _mm_add_ps(_mm_set1_ps(edges[0]), _mm_mul_ps(lanes, _mm_set1_ps(stepX[0])));
+			__m128 edge1 = _mm_add_ps(_mm_set1_ps(edges[1]), _mm_mul_ps(lanes, _mm_set1_ps(stepX[1])));
+			__m128 edge2 = _mm_add_ps(_mm_set1_ps(edges[2]), _mm_mul_ps(lanes, _mm_set1_ps(stepX[2])));
+			__m128 pixelDepth = _mm_add_ps(_mm_set1_ps(rowDepth), _mm_mul_ps(lanes, _mm_set1_ps(depthStepX)));
+			const __m128 edgeStep0 = _mm_set1_ps(stepX[0] * 4.f);
+			const __m128 edgeStep1 = _mm_set1_ps(stepX[1] * 4.f);
+			const __m128 edgeStep2 = _mm_set1_ps(stepX[2] * 4.f);
+			const __m128 depthStep = _mm_set1_ps(depthStepX * 4.f);
+			const __m128 zero = _mm_setzero_ps();
+
+			// Rows are processed four pixels at a time, minX is aligned and tiles are a multiple of four wide
+			for (uint32_t x = minX; x < maxX; x += 4)
+			{
+				const __m128 inside =
+					_mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+
+				if (_mm_movemask_ps(inside) != 0)
+				{
+					const __m128 current = _mm_loadu_ps(row + x);
+					const __m128 nearest = _mm_min_ps(current, pixelDepth);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+				}
+
+				edge0 = _mm_add_ps(edge0, edgeStep0);
+				edge1 = _mm_add_ps(edge1, edgeStep1);
+				edge2 = _mm_add_ps(edge2, edgeStep2);
+				pixelDepth = _mm_add_ps(pixelDepth, depthStep);
+			}
+#else
+			for (uint32_t x = minX; x < maxX; x++)
+			{
+				if (edges[0] >= 0.f && edges[1] >= 0.f && edges[2] >= 0.f)
+				{
+					row[x] = std::min(row[x], rowDepth);
+				}
+
+				edges[0] += stepX[0];
+				edges[1] += stepX[1];
+				edges[2] += stepX[2];
+				rowDepth += depthStepX;
+			}
+#endif
+		}
+	}
+}
+
+void Mistral::OcclusionBuffer::BuildPyramid()
+{
+	uint32_t sourceWidth = mWidth;
+	uint32_t sourceHeight = mHeight;
+
+	for (size_t level = 1; level < mPyramid.size(); level++)
+	{
+		const uint32_t levelWidth = std::max(sourceWidth / 2, 1u);
+		const uint32_t levelHeight = std::max(sourceHeight / 2, 1u);
+		const std::vector<float>& source = mPyramid[level - 1];
+		std::vector<float>& target = mPyramid[level];
+
+		for (uint32_t y = 0; y < levelHeight; y++)
+		{
+			for (uint32_t x = 0; x < levelWidth; x++)
+			{
+				// Odd sizes fold the last row and column into the previous texel
+				const uint32_t x0 = std::min(x * 2, sourceWidth - 1);
+				const uint32_t x1 = x + 1 == levelWidth ? sourceWidth - 1 : std::min(x * 2 + 1, sourceWidth - 1);
+				const uint32_t y0 = std::min(y * 2, sourceHeight - 1);
+				const uint32_t y1 = y + 1 == levelHeight ? sourceHeight - 1 : std::min(y * 2 + 1, sourceHeight - 1);
+
+				float farthest = 0.f;
+				for (uint32_t sourceY = y0; sourceY <= y1; sourceY++)
+				{
+					for (uint32_t sourceX = x0; sourceX <= x1; sourceX++)
+					{
+						farthest = std::max(farthest, source[sourceY * sourceWidth + sourceX]);
+					}
+				}
+				target[y * levelWidth + x] = farthest;
+			}
+		}
+
+		sourceWidth = levelWidth;
+		sourceHeight = levelHeight;
+	}
+}
+
+// Engine integration
+void Mistral::SetOcclusionCulling(const bool enabled)
+{
+	occlusionCulling = enabled;
+	occlusionReady = false;
+}
+
+bool Mistral::IsOcclusionCullingEnabled()
+{
+	return occlusionCulling;
+}
+
+Mistral::OcclusionBuffer& Mistral::GetOcclusionBuffer()
+{
+	static OcclusionBuffer occlusionBuffer;
+	return occlusionBuffer;
+}
+
+void Mistral::SubmitOccluder(const Mesh& mesh, const Matrix4x4& transform)
+{
+	if (occlusionCulling)
+	{
+		pendingOccluders.push_back({&mesh, transform});
+	}
+}
+
+void Mistral::UpdateOcclusionCulling()
+{
+	occludedCount = 0;
+	occlusionReady = false;
+
+	// Rasterized from the view everything else is drawn over, the active camera when no view is registered
+	const uint32_t cameraId = GetPrimaryCamera();
+	const Camera3D* camera = GetActiveCamera();
+	float width = static_cast<float>(GetRenderWidth());
+	float height = static_cast<float>(GetRenderHeight());
+	if (cameraId != 0)
+	{
+		const CameraView& cameraView = GetCamera(cameraId);
+		camera = &cameraView.camera;
+		width = static_cast<float>(cameraView.target ? cameraView.target->texture.width : GetRenderWidth()) * cameraView.viewport.width;
+		height = static_cast<float>(cameraView.target ? cameraView.target->texture.height : GetRenderHeight()) * cameraView.viewport.height;
+	}
+
+	if (!occlusionCulling || !camera)
+	{
+		pendingOccluders.clear();
+		return;
+	}
+
+	const float aspect = width / std::max(height, 1.f);
+	const Matrix4x4 projection = camera->projection == CAMERA_PERSPECTIVE
+									 ? Matrix4x4::Perspective(camera->fovy, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR)
+									 : Matrix4x4::Orthographic(-camera->fovy * aspect * .5f, camera->fovy * aspect * .5f, -camera->fovy * .5f,
+															   camera->fovy * .5f, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+	const Matrix4x4 view = Matrix4x4::LookAt(camera->position, camera->target, camera->up);
+
+	OcclusionBuffer& occlusionBuffer = GetOcclusionBuffer();
+	occlusionBuffer.BeginFrame(projection * view);
+
+	for (const auto& [mesh, transform] : pendingOccluders)
+	{
+		occlusionBuffer.AddOccluder(*mesh, transform);
+	}
+	pendingOccluders.clear();
+
+	occlusionBuffer.Rasterize();
+	occlusionReady = true;
+	occlusionCameraId = cameraId;
+}
+
+bool Mistral::IsOccluded(const BoundingBox& bounds)
+{
+	if (!occlusionReady || GetOcclusionBuffer().IsVisible(bounds))
+	{
+		return false;
+	}
+
+	occludedCount++;
+	return true;
+}
+
+std::optional<uint32_t> Mistral::GetOcclusionCamera()
+{
+	if (!occlusionReady)
+	{
+		return std::nullopt;
+	}
+	return occlusionCameraId;
+}
+
+uint32_t Mistral::GetOccludedCount()
+{
+	return occludedCount;
+}
@@ -0,0 +1,692 @@
+#include "Packed.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "Color.h"
+#include "Quaternion.h"
+#include "Vector.h"
+
+#if defined(__F16C__)
+	#include <immintrin.h>
+	#define MISTRAL_PACKED_F16C
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define MISTRAL_PACKED_SSE
+#endif
+
+// Bulk conversions reinterpret these as flat arrays
+static_assert(sizeof(Vec3) == 3 * sizeof(float));
+static_assert(sizeof(Color4) == 4 * sizeof(float));
+static_assert(sizeof(Half3) == 3 * sizeof(uint16_t));
+static_assert(sizeof(FixedPosition) == 3 * sizeof(int16_t));
+static_assert(sizeof(OctNormal) == 2 * sizeof(int16_t));
+static_assert(sizeof(ColorRGBA8) == 4);
+
+namespace
+{
+	constexpr uint32_t floatInfinity = 255u << 23;
+	constexpr uint32_t halfOverflow = (127u + 16u) << 23;		// Smallest float rounding to a half infinity
+	constexpr uint32_t halfSubnormal = 113u << 23;				// Smallest float with a normal half
+	constexpr uint32_t subnormalMagic = (127u - 15u + 23u - 10u + 1u) << 23;
+	constexpr uint32_t exponentRebias = (127u - 15u) << 23;
+	constexpr uint32_t halfExponentMask = 0x7c00u << 13;		// Half exponent bits once shifted to a float's place
+
+	constexpr float smallestComponentRange = .70710678f; // Every component but the largest of a unit quaternion lies within ±1/sqrt(2)
+	constexpr float snormMaximum = 32767.f;
+
+	float Snorm16(const float value)
+	{
+		return std::nearbyint(std::clamp(value, -1.f, 1.f) * snormMaximum);
+	}
+
+	// Dropped component index and the other three quantized on 0 to maximum, the dropped one made positive so it can be rebuilt
+	void EncodeSmallestThree(const Quat& rotation, const uint32_t maximum, uint32_t& largest, uint32_t values[3])
+	{
+		const Quat q = rotation.Normalized();
+
+		largest = 0;
+		for (uint32_t component = 1; component < 4; component++)
+		{
+			if (std::fabs(q[component]) > std::fabs(q[largest]))
+			{
+				largest = component;
+			}
+		}
+
+		const float sign = q[largest] < 0.f ? -1.f : 1.f;
+		for (uint32_t component = 0, value = 0; component < 4; component++)
+		{
+			if (component != largest)
+			{
+				const float normalized = std::clamp((q[component] * sign / smallestComponentRange + 1.f) * .5f, 0.f, 1.f);
+				values[value++] = static_cast<uint32_t>(std::lround(normalized * static_cast<float>(maximum)));
+			}
+		}
+	}
+
+	Quat DecodeSmallestThree(const uint32_t largest, const uint32_t values[3], const uint32_t maximum)
+	{
+		Quat rotation;
+		float lengthSqr = 0.f;
+		for (uint32_t component = 0, value = 0; component < 4; component++)
+		{
+			if (component != largest)
+			{
+				rotation[component] = (static_cast<float>(values[value++]) / static_cast<float>(maximum) * 2.f - 1.f) * smallestComponentRange;
+				lengthSqr += rotation[component] * rotation[component];
+			}
+		}
+
+		rotation[largest] = std::sqrt(std::max(1.f - lengthSqr, 0.f));
+		return rotation;
+	}
+
+#if defined(MISTRAL_PACKED_SSE)
+	__m128i Select(const __m128i mask, const __m128i ifTrue, const __m128i ifFalse)
+	{
+		return _mm_or_si128(_mm_and_si128(mask, ifTrue), _mm_andnot_si128(mask, ifFalse));
+	}
+
+	__m128 Select(const __m128 mask, const __m128 ifTrue, const __m128 ifFalse)
+	{
+		return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+	}
+
+	// Same steps as FloatToHalf with every branch computed then selected, one half per 32 bits lane
+	__m128i FloatToHalf4(const __m128 values)
+	{
+		const __m128i bits = _mm_castps_si128(values);
+		const __m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int32_t>(0x80000000u)));
+		const __m128i magnitude = _mm_xor_si128(bits, sign);
+
+		const __m128i isNan = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(floatInfinity));
+		const __m128i special = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(isNan, _mm_set1_epi32(0x0200)));
+
+		const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32(subnormalMagic));
+		const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(magnitude), magic)), _mm_castps_si128(magic));
+
+		const __m128i odd = _mm_and_si128(_mm_srli_epi32(magnitude, 13), _mm_set1_epi32(1));
+		const __m128i rebiased = _mm_add_epi32(_mm_sub_epi32(magnitude, _mm_set1_epi32(exponentRebias)), _mm_set1_epi32(0xfff));
+		const __m128i normal = _mm_srli_epi32(_mm_add_epi32(rebiased, odd), 13);
+
+		const __m128i isOverflow = _mm_cmpgt_epi32(magnitude, _mm_set1_epi32(halfOverflow - 1));
+		const __m128i isSubnormal = _mm_cmplt_epi32(magnitude, _mm_set1_epi32(halfSubnormal));
+		const __m128i half = Select(isOverflow, special, Select(isSubnormal, subnormal, normal));
+
+		return _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+	}
+
+	__m128 HalfToFloat4(const __m128i halves)
+	{
+		__m128i bits = _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x7fff)), 13);
+		const __m128i exponent = _mm_and_si128(bits, _mm_set1_epi32(halfExponentMask));
+		bits = _mm_add_epi32(bits, _mm_set1_epi32(exponentRebias));
+
+		const __m128i isSpecial = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(halfExponentMask));
+		bits = _mm_add_epi32(bits, _mm_and_si128(isSpecial, _mm_set1_epi32(exponentRebias)));
+
+		const __m128i isSubnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+		const __m128 renormalized = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))),
+											   _mm_castsi128_ps(_mm_set1_epi32(halfSubnormal)));
+		bits = Select(isSubnormal, _mm_castps_si128(renormalized), bits);
+
+		return _mm_castsi128_ps(_mm_or_si128(bits, _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x8000)), 16)));
+	}
+
+	// Packs the low 16 bits of every lane, the values are sign extended first so the saturation of packs leaves them untouched
+	__m128i PackLow16(const __m128i low, const __m128i high)
+	{
+		return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(low, 16), 16), _mm_srai_epi32(_mm_slli_epi32(high, 16), 16));
+	}
+
+	// Four packed Vec3 to one register per axis and back
+	void LoadVec3x4(const float* values, __m128& x, __m128& y, __m128& z)
+	{
+		const __m128 a = _mm_loadu_ps(values);	   // x0 y0 z0 x1
+		const __m128 b = _mm_loadu_ps(values + 4); // y1 z1 x2 y2
+		const __m128 c = _mm_loadu_ps(values + 8); // z2 x3 y3 z3
+
+		x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	void StoreVec3x4(float* values, const __m128 x, const __m128 y, const __m128 z)
+	{
+		_mm_storeu_ps(values, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+											 _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(values + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+												 _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(values + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+												 _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+
+	__m128 CopySign(const __m128 magnitude, const __m128 sign)
+	{
+		const __m128 signMask = _mm_set1_ps(-0.f);
+		return _mm_or_ps(_mm_andnot_ps(signMask, magnitude), _mm_and_ps(signMask, sign));
+	}
+#endif
+} // namespace
+
+// Half floats
+uint16_t FloatToHalf(const float value)
+{
+	uint32_t bits = std::bit_cast<uint32_t>(value);
+	const uint32_t sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	uint32_t half;
+	if (bits >= halfOverflow)
+	{
+		half = bits > floatInfinity ? 0x7e00u : 0x7c00u;
+	}
+	else if (bits < halfSubnormal)
+	{
+		// The addition aligns the mantissa at the bottom of the float, rounded to nearest even by the FPU
+		half = std::bit_cast<uint32_t>(std::bit_cast<float>(bits) + std::bit_cast<float>(subnormalMagic)) - subnormalMagic;
+	}
+	else
+	{
+		const uint32_t odd = (bits >> 13) & 1u;
+		half = (bits - exponentRebias + 0xfffu + odd) >> 13;
+	}
+
+	return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+float HalfToFloat(const uint16_t half)
+{
+	uint32_t bits = (half & 0x7fffu) << 13;
+	const uint32_t exponent = bits & halfExponentMask;
+	bits += exponentRebias;
+
+	if (exponent == halfExponentMask)
+	{
+		bits += exponentRebias;
+	}
+	else if (exponent == 0)
+	{
+		bits = std::bit_cast<uint32_t>(std::bit_cast<float>(bits + (1u << 23)) - std::bit_cast<float>(halfSubnormal));
+	}
+
+	return std::bit_cast<float>(bits | ((half & 0x8000u) << 16));
+}
+
+Half3::Half3(const Vec3& vector):
+	x(FloatToHalf(vector.x)),
+	y(FloatToHalf(vector.y)),
+	z(FloatToHalf(vector.z))
+{
+}
+
+Half3::operator Vec3() const
+{
+	return {HalfToFloat(x), HalfToFloat(y), HalfToFloat(z)};
+}
+
+// Quaternions
+PackedQuat32::PackedQuat32(const Quat& rotation)
+{
+	uint32_t largest;
+	uint32_t values[3];
+	EncodeSmallestThree(rotation, 1023u, largest, values);
+	bits = largest << 30 | values[0] << 20 | values[1] << 10 | values[2];
+}
+
+PackedQuat32::operator Quat() const
+{
+	const uint32_t values[3] = {bits >> 20 & 1023u, bits >> 10 & 1023u, bits & 1023u};
+	return DecodeSmallestThree(bits >> 30, values, 1023u);
+}
+
+PackedQuat48::PackedQuat48(const Quat& rotation)
+{
+	uint32_t largest;
+	uint32_t components[3];
+	EncodeSmallestThree(rotation, 32767u, largest, components);
+
+	const uint64_t bits = static_cast<uint64_t>(largest) << 45 | static_cast<uint64_t>(components[0]) << 30 |
+						  static_cast<uint64_t>(components[1]) << 15 | components[2];
+	values[0] = static_cast<uint16_t>(bits >> 32);
+	values[1] = static_cast<uint16_t>(bits >> 16);
+	values[2] = static_cast<uint16_t>(bits);
+}
+
+PackedQuat48::operator Quat() const
+{
+	const uint64_t bits = static_cast<uint64_t>(values[0]) << 32 | static_cast<uint64_t>(values[1]) << 16 | values[2];
+	const uint32_t components[3] = {static_cast<uint32_t>(bits >> 30 & 32767u), static_cast<uint32_t>(bits >> 15 & 32767u),
+									static_cast<uint32_t>(bits & 32767u)};
+	return DecodeSmallestThree(static_cast<uint32_t>(bits >> 45), components, 32767u);
+}
+
+// Normals
+OctNormal::OctNormal(const Vec3& normal)
+{
+	const float norm = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+	const float inverseNorm = norm > 0.f ? 1.f / norm : 0.f;
+
+	float u = normal.x * inverseNorm;
+	float v = normal.y * inverseNorm;
+
+	// The lower half folds over the diagonals
+	if (normal.z < 0.f)
+	{
+		const float foldedU = (1.f - std::fabs(v)) * std::copysign(1.f, u);
+		v = (1.f - std::fabs(u)) * std::copysign(1.f, v);
+		u = foldedU;
+	}
+
+	x = static_cast<int16_t>(Snorm16(u));
+	y = static_cast<int16_t>(Snorm16(v));
+}
+
+OctNormal::operator Vec3() const
+{
+	float u = std::max(static_cast<float>(x) * (1.f / snormMaximum), -1.f);
+	float v = std::max(static_cast<float>(y) * (1.f / snormMaximum), -1.f);
+	const float z = 1.f - std::fabs(u) - std::fabs(v);
+
+	const float fold = std::max(-z, 0.f);
+	u -= std::copysign(fold, u);
+	v -= std::copysign(fold, v);
+
+	// Same operations as the SSE path of DecodeNormals so both decoders agree to the bit
+	const float inverseLength = 1.f / std::sqrt(u * u + v * v + z * z);
+	return {u * inverseLength, v * inverseLength, z * inverseLength};
+}
+
+// Positions
+FixedPosition::FixedPosition(const int16_t x, const int16_t y, const int16_t z):
+	x(x),
+	y(y),
+	z(z)
+{
+}
+
+Vec3 FixedPosition::ToPosition(const Vec3& origin, const float precision) const
+{
+	return {origin.x + static_cast<float>(x) * precision, origin.y + static_cast<float>(y) * precision, origin.z + static_cast<float>(z) * precision};
+}
+
+FixedPosition FixedPosition::FromPosition(const Vec3& position, const Vec3& origin, const float precision)
+{
+	const float inversePrecision = 1.f / precision;
+	auto quantize = [inversePrecision](const float offset) {
+		return static_cast<int16_t>(std::nearbyint(std::clamp(offset * inversePrecision, -snormMaximum, snormMaximum)));
+	};
+
+	return {quantize(position.x - origin.x), quantize(position.y - origin.y), quantize(position.z - origin.z)};
+}
+
+// Colors
+ColorRGBA8::ColorRGBA8(const uint8_t r, const uint8_t g, const uint8_t b, const uint8_t a):
+	r(r),
+	g(g),
+	b(b),
+	a(a)
+{
+}
+
+ColorRGBA8::ColorRGBA8(const Color4& color)
+{
+	auto quantize = [](const float value) {
+		return static_cast<uint8_t>(std::nearbyint(std::clamp(value, 0.f, 1.f) * 255.f));
+	};
+
+	r = quantize(color.r);
+	g = quantize(color.g);
+	b = quantize(color.b);
+	a = quantize(color.a);
+}
+
+ColorRGBA8::ColorRGBA8(const Color& color):
+	r(color.r),
+	g(color.g),
+	b(color.b),
+	a(color.a)
+{
+}
+
+ColorRGBA8::operator Color4() const
+{
+	constexpr float scale = 1.f / 255.f;
+	return {static_cast<float>(r) * scale, static_cast<float>(g) * scale, static_cast<float>(b) * scale, static_cast<float>(a) * scale};
+}
+
+ColorRGBA8::operator Color() const
+{
+	return {r, g, b, a};
+}
+
+ColorRGB10A2::ColorRGB10A2(const Color4& color)
+{
+	auto quantize = [](const float value, const float maximum) {
+		return static_cast<uint32_t>(std::nearbyint(std::clamp(value, 0.f, 1.f) * maximum));
+	};
+
+	bits = quantize(color.r, 1023.f) | quantize(color.g, 1023.f) << 10 | quantize(color.b, 1023.f) << 20 | quantize(color.a, 3.f) << 30;
+}
+
+ColorRGB10A2::operator Color4() const
+{
+	return {static_cast<float>(bits & 1023u) / 1023.f, static_cast<float>(bits >> 10 & 1023u) / 1023.f,
+			static_cast<float>(bits >> 20 & 1023u) / 1023.f, static_cast<float>(bits >> 30) / 3.f};
+}
+
+// Bulk conversions
+void EncodeHalves(const std::span<const float> values, const std::span<uint16_t> halves)
+{
+	const size_t count = std::min(values.size(), halves.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_PACKED_F16C)
+	for (; index + 8 <= count; index += 8)
+	{
+		const __m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(values.data() + index), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(halves.data() + index), packed);
+	}
+#elif defined(MISTRAL_PACKED_SSE)
+	for (; index + 8 <= count; index += 8)
+	{
+		const __m128i low = FloatToHalf4(_mm_loadu_ps(values.data() + index));
+		const __m128i high = FloatToHalf4(_mm_loadu_ps(values.data() + index + 4));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(halves.data() + index), PackLow16(low, high));
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		halves[index] = FloatToHalf(values[index]);
+	}
+}
+
+void DecodeHalves(const std::span<const uint16_t> halves, const std::span<float> values)
+{
+	const size_t count = std::min(values.size(), halves.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_PACKED_F16C)
+	for (; index + 8 <= count; index += 8)
+	{
+		const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(halves.data() + index));
+		_mm256_storeu_ps(values.data() + index, _mm256_cvtph_ps(packed));
+	}
+#elif defined(MISTRAL_PACKED_SSE)
+	for (; index + 8 <= count; index += 8)
+	{
+		const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(halves.data() + index));
+		_mm_storeu_ps(values.data() + index, HalfToFloat4(_mm_unpacklo_epi16(packed, _mm_setzero_si128())));
+		_mm_storeu_ps(values.data() + index + 4, HalfToFloat4(_mm_unpackhi_epi16(packed, _mm_setzero_si128())));
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		values[index] = HalfToFloat(halves[index]);
+	}
+}
+
+void EncodeHalf3s(const std::span<const Vec3> vectors, const std::span<Half3> halves)
+{
+	const size_t count = std::min(vectors.size(), halves.size()) * 3;
+	EncodeHalves({reinterpret_cast<const float*>(vectors.data()), count}, {reinterpret_cast<uint16_t*>(halves.data()), count});
+}
+
+void DecodeHalf3s(const std::span<const Half3> halves, const std::span<Vec3> vectors)
+{
+	const size_t count = std::min(vectors.size(), halves.size()) * 3;
+	DecodeHalves({reinterpret_cast<const uint16_t*>(halves.data()), count}, {reinterpret_cast<float*>(vectors.data()), count});
+}
+
+void EncodeNormals(const std::span<const Vec3> normals, const std::span<OctNormal> packed)
+{
+	const size_t count = std::min(normals.size(), packed.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_PACKED_SSE)
+	const __m128 signMask = _mm_set1_ps(-0.f);
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 minusOne = _mm_set1_ps(-1.f);
+	const __m128 scale = _mm_set1_ps(snormMaximum);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		__m128 x;
+		__m128 y;
+		__m128 z;
+		LoadVec3x4(reinterpret_cast<const float*>(normals.data() + index), x, y, z);
+
+		const __m128 absX = _mm_andnot_ps(signMask, x);
+		const __m128 absY = _mm_andnot_ps(signMask, y);
+		const __m128 norm = _mm_add_ps(_mm_add_ps(absX, absY), _mm_andnot_ps(signMask, z));
+		const __m128 inverseNorm = _mm_and_ps(_mm_cmpgt_ps(norm, _mm_setzero_ps()), _mm_div_ps(one, norm));
+
+		__m128 u = _mm_mul_ps(x, inverseNorm);
+		__m128 v = _mm_mul_ps(y, inverseNorm);
+
+		const __m128 isLower = _mm_cmplt_ps(z, _mm_setzero_ps());
+		const __m128 foldedU = CopySign(_mm_sub_ps(one, _mm_andnot_ps(signMask, v)), u);
+		const __m128 foldedV = CopySign(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)), v);
+		u = Select(isLower, foldedU, u);
+		v = Select(isLower, foldedV, v);
+
+		const __m128i quantizedU = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(u, one), minusOne), scale));
+		const __m128i quantizedV = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(v, one), minusOne), scale));
+		const __m128i interleaved = _mm_packs_epi32(_mm_unpacklo_epi32(quantizedU, quantizedV), _mm_unpackhi_epi32(quantizedU, quantizedV));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(packed.data() + index), interleaved);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		packed[index] = OctNormal(normals[index]);
+	}
+}
+
+void DecodeNormals(const std::span<const OctNormal> packed, const std::span<Vec3> normals)
+{
+	const size_t count = std::min(normals.size(), packed.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_PACKED_SSE)
+	const __m128 signMask = _mm_set1_ps(-0.f);
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 minusOne = _mm_set1_ps(-1.f);
+	const __m128 scale = _mm_set1_ps(1.f / snormMaximum);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed.data() + index));
+		const __m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(values, values), 16)); // u0 v0 u1 v1
+		const __m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(values, values), 16));
+
+		__m128 u = _mm_max_ps(_mm_mul_ps(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)), scale), minusOne);
+		__m128 v = _mm_max_ps(_mm_mul_ps(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)), scale), minusOne);
+		const __m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)), _mm_andnot_ps(signMask, v));
+
+		const __m128 fold = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+		u = _mm_sub_ps(u, CopySign(fold, u));
+		v = _mm_sub_ps(v, CopySign(fold, v));
+
+		const __m128 inverseLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(v, v)), _mm_mul_ps(z, z))));
+		StoreVec3x4(reinterpret_cast<float*>(normals.data() + index), _mm_mul_ps(u, inverseLength), _mm_mul_ps(v, inverseLength),
+					_mm_mul_ps(z, inverseLength));
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		normals[index] = packed[index];
+	}
+}
+
+void EncodePositions(const std::span<const Vec3> positions, const Vec3& origin, const float precision, const std::span<FixedPosition> packed)
+{
+	const size_t count = std::min(positions.size(), packed.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_PACKED_SSE)
+	// Four positions are twelve floats, the origin repeats across the three registers with a shifting phase
+	const __m128 origins[3] = {_mm_setr_ps(origin.x, origin.y, origin.z, origin.x), _mm_setr_ps(origin.y, origin.z, origin.x, origin.y),
+							   _mm_setr_ps(origin.z, origin.x, origin.y, origin.z)};
+	const __m128 inversePrecision = _mm_set1_ps(1.f / precision);
+	const __m128 maximum = _mm_set1_ps(snormMaximum);
+	const __m128 minimum = _mm_set1_ps(-snormMaximum);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		const float* values = reinterpret_cast<const float*>(positions.data() + index);
+
+		__m128i quantized[3];
+		for (uint32_t part = 0; part < 3; part++)
+		{
+			const __m128 steps = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(values + part * 4), origins[part]), inversePrecision);
+			quantized[part] = _mm_cvtps_epi32(_mm_max_ps(_mm_min_ps(steps, maximum), minimum));
+		}
+
+		int16_t* destination = reinterpret_cast<int16_t*>(packed.data() + index);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_packs_epi32(quantized[0], quantized[1]));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(destination + 8), _mm_packs_epi32(quantized[2], quantized[2]));
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		packed[index] = FixedPosition::FromPosition(positions[index], origin, precision);
+	}
+}
+
+void DecodePositions(const std::span<const FixedPosition> packed, const Vec3& origin, const float precision, const std::span<Vec3> positions)
+{
+	const size_t count = std::min(positions.size(), packed.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_PACKED_SSE)
+	const __m128 origins[3] = {_mm_setr_ps(origin.x, origin.y, origin.z, origin.x), _mm_setr_ps(origin.y, origin.z, origin.x, origin.y),
+							   _mm_setr_ps(origin.z, origin.x, origin.y, origin.z)};
+	const __m128 scale = _mm_set1_ps(precision);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		const int16_t* source = reinterpret_cast<const int16_t*>(packed.data() + index);
+		const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+		const __m128i second = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + 8));
+
+		const __m128i steps[3] = {_mm_srai_epi32(_mm_unpacklo_epi16(first, first), 16), _mm_srai_epi32(_mm_unpackhi_epi16(first, first), 16),
+								  _mm_srai_epi32(_mm_unpacklo_epi16(second, second), 16)};
+
+		float* values = reinterpret_cast<float*>(positions.data() + index);
+		for (uint32_t part = 0; part < 3; part++)
+		{
+			_mm_storeu_ps(values + part * 4, _mm_add_ps(origins[part], _mm_mul_ps(_mm_cvtepi32_ps(steps[part]), scale)));
+		}
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		positions[index] = packed[index].ToPosition(origin, precision);
+	}
+}
+
+void EncodeRotations(const std::span<const Quat> rotations, const std::span<PackedQuat32> packed)
+{
+	const size_t count = std::min(rotations.size(), packed.size());
+	for (size_t index = 0; index < count; index++)
+	{
+		packed[index] = PackedQuat32(rotations[index]);
+	}
+}
+
+void EncodeRotations(const std::span<const Quat> rotations, const std::span<PackedQuat48> packed)
+{
+	const size_t count = std::min(rotations.size(), packed.size());
+	for (size_t index = 0; index < count; index++)
+	{
+		packed[index] = PackedQuat48(rotations[index]);
+	}
+}
+
+void DecodeRotations(const std::span<const PackedQuat32> packed, const std::span<Quat> rotations)
+{
+	const size_t count = std::min(rotations.size(), packed.size());
+	for (size_t index = 0; index < count; index++)
+	{
+		rotations[index] = packed[index];
+	}
+}
+
+void DecodeRotations(const std::span<const PackedQuat48> packed, const std::span<Quat> rotations)
+{
+	const size_t count = std::min(rotations.size(), packed.size());
+	for (size_t index = 0; index < count; index++)
+	{
+		rotations[index] = packed[index];
+	}
+}
+
+void EncodeColors(const std::span<const Color4> colors, const std::span<ColorRGBA8> packed)
+{
+	const size_t count = std::min(colors.size(), packed.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_PACKED_SSE)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 scale = _mm_set1_ps(255.f);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		const float* values = reinterpret_cast<const float*>(colors.data() + index);
+
+		__m128i quantized[4];
+		for (uint32_t color = 0; color < 4; color++)
+		{
+			quantized[color] = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(_mm_loadu_ps(values + color * 4), one), zero), scale));
+		}
+
+		const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(quantized[0], quantized[1]), _mm_packs_epi32(quantized[2], quantized[3]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(packed.data() + index), bytes);
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		packed[index] = ColorRGBA8(colors[index]);
+	}
+}
+
+void DecodeColors(const std::span<const ColorRGBA8> packed, const std::span<Color4> colors)
+{
+	const size_t count = std::min(colors.size(), packed.size());
+	size_t index = 0;
+
+#if defined(MISTRAL_PACKED_SSE)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 scale = _mm_set1_ps(1.f / 255.f);
+
+	for (; index + 4 <= count; index += 4)
+	{
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed.data() + index));
+		const __m128i words[2] = {_mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero)};
+
+		float* values = reinterpret_cast<float*>(colors.data() + index);
+		for (uint32_t color = 0; color < 4; color++)
+		{
+			const __m128i channels = color % 2 == 0 ? _mm_unpacklo_epi16(words[color / 2], zero) : _mm_unpackhi_epi16(words[color / 2], zero);
+			_mm_storeu_ps(values + color * 4, _mm_mul_ps(_mm_cvtepi32_ps(channels), scale));
+		}
+	}
+#endif
+
+	for (; index < count; index++)
+	{
+		colors[index] = packed[index];
+	}
+}
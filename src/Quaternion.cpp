@@ -1,43 +1,31 @@
 #include "Quaternion.h"
 
-#include <cassert>
 #include <cmath>
 
+#include "FastMath.h"
 #include "Vector.h"
 
 const Quat Quat::Identity = {0.0f, 0.0f, 0.0f, 1.0f};
 
 // Parametrized constructors
 Quat::Quat(const float x, const float y, const float z, const float w):
-	x(x),
-	y(y),
-	z(z),
-	w(w)
+	components{x, y, z, w}
 {
 }
 
 Quat::Quat(const float value):
-	x(value),
-	y(value),
-	z(value),
-	w(value)
+	components{value, value, value, value}
 {
 }
 
 // Copy constructors
 Quat::Quat(const Vec4& vector):
-	x(vector.x),
-	y(vector.y),
-	z(vector.z),
-	w(vector.w)
+	components{vector.x, vector.y, vector.z, vector.w}
 {
 }
 
 Quat::Quat(const Quaternion& quat):
-	x(quat.x),
-	y(quat.y),
-	z(quat.z),
-	w(quat.w)
+	components{quat.x, quat.y, quat.z, quat.w}
 {
 }
 
@@ -47,45 +35,6 @@ Quat::operator Quaternion() const
 	return {x, y, z, w};
 }
 
-// Access operators
-float& Quat::operator[](const std::size_t index)
-{
-	assert(index <= 3);
-	switch (index)
-	{
-		case 0:
-			return x;
-		case 1:
-			return y;
-		case 2:
-			return z;
-		case 3:
-			return w;
-		default:
-			break;
-	}
-	return x;
-}
-
-float Quat::operator[](const std::size_t index) const
-{
-	assert(index <= 3);
-	switch (index)
-	{
-		case 0:
-			return x;
-		case 1:
-			return y;
-		case 2:
-			return z;
-		case 3:
-			return w;
-		default:
-			break;
-	}
-	return x;
-}
-
 // Compound assignment operators
 Quat& Quat::operator+=(const Quat& quat) noexcept
 {
@@ -178,6 +127,15 @@ Quat Quat::Normalized() const
 	return Quat::Identity;
 }
 
+Quat Quat::NormalizedFast() const
+{
+	if (const float lenSq = x * x + y * y + z * z + w * w; lenSq > 1e-12f)
+	{
+		return *this * FastRsqrt(lenSq);
+	}
+	return Quat::Identity;
+}
+
 Quat Quat::Conjugate() const
 {
 	return {-x, -y, -z, w};
@@ -257,6 +215,23 @@ Quat Quat::Slerp(const Quat& target, const float amount) const
 	return (*this * ratioA + q2 * ratioB).Normalized();
 }
 
+Quat Quat::Nlerp(const Quat& target, const float amount) const
+{
+	const Quat q2 = this->Dot(target) < 0.f ? target * -1.f : target;
+	return (*this + (q2 - *this) * amount).NormalizedFast();
+}
+
+Quat Quat::SlerpFast(const Quat& target, const float amount) const
+{
+	// Cubic correction of the amount, its strength fitted against the cosine of the angle between the quaternions (Kapoulkine's onlerp)
+	const float d = std::abs(this->Dot(target));
+	const float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+	const float b = .848013f + d * (-1.06021f + d * .215638f);
+	const float k = a * (amount - .5f) * (amount - .5f) + b;
+
+	return Nlerp(target, amount + amount * (amount - .5f) * (amount - 1.f) * k);
+}
+
 // Static constructors
 Quat Quat::FromAxisAngle(const Vec3& axis, const float angle)
 {
@@ -0,0 +1,341 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+	constexpr Mistral::RenderGraphResource backbufferResource = 0;
+} // namespace
+
+Mistral::RenderGraphBuilder::RenderGraphBuilder(RenderGraph& graph, const uint32_t pass):
+	mGraph(graph),
+	mPass(pass)
+{
+}
+
+Mistral::RenderGraphResource Mistral::RenderGraphBuilder::CreateTarget(const std::string& name, const RenderTargetDesc& desc)
+{
+	mGraph.mResources.push_back({name, desc, false, -1});
+	return static_cast<RenderGraphResource>(mGraph.mResources.size() - 1);
+}
+
+void Mistral::RenderGraphBuilder::Read(const RenderGraphResource resource)
+{
+	if (resource >= mGraph.mResources.size())
+	{
+		std::cerr << "[Error] Render graph pass " << mGraph.mStats[mPass].name << " reads an unknown resource" << std::endl;
+		return;
+	}
+	mGraph.mPasses[mPass].reads.push_back(resource);
+}
+
+void Mistral::RenderGraphBuilder::Write(const RenderGraphResource resource)
+{
+	auto& writes = mGraph.mPasses[mPass].writes;
+	if (resource >= mGraph.mResources.size())
+	{
+		std::cerr << "[Error] Render graph pass " << mGraph.mStats[mPass].name << " writes an unknown resource" << std::endl;
+		return;
+	}
+
+	if (!writes.empty())
+	{
+		std::cerr << "[Error] Render graph pass " << mGraph.mStats[mPass].name << " writes more than one target" << std::endl;
+		return;
+	}
+	writes.push_back(resource);
+}
+
+void Mistral::RenderGraphBuilder::SetSideEffect()
+{
+	mGraph.mPasses[mPass].sideEffect = true;
+}
+
+Mistral::RenderGraph::RenderGraph()
+{
+	Clear();
+}
+
+Mistral::RenderGraph::~RenderGraph()
+{
+	ReleaseTargets();
+}
+
+void Mistral::RenderGraph::AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute)
+{
+	const auto pass = static_cast<uint32_t>(mPasses.size());
+
+	mPasses.emplace_back();
+	mPasses.back().execute = std::move(execute);
+	mPasses.back().timer = std::make_unique<GpuTimer>();
+	mStats.push_back({name});
+
+	RenderGraphBuilder builder(*this, pass);
+	setup(builder);
+
+	mDirty = true;
+}
+
+void Mistral::RenderGraph::Clear()
+{
+	ReleaseTargets();
+
+	mResources.clear();
+	mPasses.clear();
+	mStats.clear();
+	mOrder.clear();
+	mResources.push_back({"Backbuffer", {}, true, -1});
+	mDirty = true;
+}
+
+void Mistral::RenderGraph::Compile()
+{
+	const auto passCount = static_cast<uint32_t>(mPasses.size());
+
+	// Declaration order decides which version of a resource a pass sees: it depends on the last earlier writer of everything it uses,
+	// and a write also waits for the earlier reads of the previous version
+	std::vector<std::vector<uint32_t>> dependencies(passCount);
+	{
+		std::vector<int32_t> lastWriter(mResources.size(), -1);
+		std::vector<std::vector<uint32_t>> readers(mResources.size());
+
+		for (uint32_t pass = 0; pass < passCount; pass++)
+		{
+			for (const RenderGraphResource resource : mPasses[pass].reads)
+			{
+				if (lastWriter[resource] >= 0)
+				{
+					dependencies[pass].push_back(lastWriter[resource]);
+				}
+				readers[resource].push_back(pass);
+			}
+
+			for (const RenderGraphResource resource : mPasses[pass].writes)
+			{
+				if (lastWriter[resource] >= 0)
+				{
+					dependencies[pass].push_back(lastWriter[resource]);
+				}
+				for (const uint32_t reader : readers[resource])
+				{
+					if (reader != pass)
+					{
+						dependencies[pass].push_back(reader);
+					}
+				}
+				readers[resource].clear();
+				lastWriter[resource] = static_cast<int32_t>(pass);
+			}
+		}
+	}
+
+	// Culling walks back from the passes with visible results
+	std::vector<bool> alive(passCount, false);
+	std::vector<uint32_t> stack;
+	for (uint32_t pass = 0; pass < passCount; pass++)
+	{
+		const auto& writes = mPasses[pass].writes;
+		if (mPasses[pass].sideEffect || std::ranges::any_of(writes, [this](const auto resource) { return mResources[resource].imported; }))
+		{
+			alive[pass] = true;
+			stack.push_back(pass);
+		}
+	}
+
+	while (!stack.empty())
+	{
+		const uint32_t pass = stack.back();
+		stack.pop_back();
+		for (const uint32_t dependency : dependencies[pass])
+		{
+			if (!alive[dependency])
+			{
+				alive[dependency] = true;
+				stack.push_back(dependency);
+			}
+		}
+	}
+
+	// Dependencies always point to earlier passes, so a stable topological order is the declaration order of the surviving passes
+	mOrder.clear();
+	for (uint32_t pass = 0; pass < passCount; pass++)
+	{
+		mStats[pass].culled = !alive[pass];
+		if (alive[pass])
+		{
+			mOrder.push_back(pass);
+		}
+	}
+
+	// Lifetimes of transient targets as positions in the execution order
+	const auto unused = static_cast<uint32_t>(-1);
+	std::vector<uint32_t> firstUse(mResources.size(), unused);
+	std::vector<uint32_t> lastUse(mResources.size(), 0);
+	for (uint32_t position = 0; position < mOrder.size(); position++)
+	{
+		const Pass& pass = mPasses[mOrder[position]];
+		for (const auto* resources : {&pass.reads, &pass.writes})
+		{
+			for (const RenderGraphResource resource : *resources)
+			{
+				firstUse[resource] = std::min(firstUse[resource], position);
+				lastUse[resource] = std::max(lastUse[resource], position);
+			}
+		}
+	}
+
+	std::vector<RenderGraphResource> transients;
+	for (RenderGraphResource resource = 0; resource < mResources.size(); resource++)
+	{
+		mResources[resource].physical = -1;
+		if (!mResources[resource].imported && firstUse[resource] != unused)
+		{
+			transients.push_back(resource);
+		}
+	}
+	std::ranges::sort(transients, [&firstUse](const auto a, const auto b) { return firstUse[a] < firstUse[b]; });
+
+	// Greedy aliasing: reuse the first target of the same size that is free before the resource is first used. Targets of the previous
+	// compile are kept when they still match, so recompiling doesn't reallocate everything.
+	std::vector<PhysicalTarget> previous = std::move(mTargets);
+	mTargets.clear();
+
+	for (const RenderGraphResource resource : transients)
+	{
+		int width = 0;
+		int height = 0;
+		ResolveSize(mResources[resource].desc, width, height);
+
+		int32_t physical = -1;
+		for (size_t target = 0; target < mTargets.size(); target++)
+		{
+			if (mTargets[target].width == width && mTargets[target].height == height && mTargets[target].lastUse < firstUse[resource])
+			{
+				physical = static_cast<int32_t>(target);
+				break;
+			}
+		}
+
+		if (physical < 0)
+		{
+			const auto match = std::ranges::find_if(previous, [width, height](const PhysicalTarget& target) {
+				return target.width == width && target.height == height;
+			});
+
+			if (match != previous.end())
+			{
+				mTargets.push_back(*match);
+				previous.erase(match);
+			}
+			else
+			{
+				mTargets.push_back({LoadRenderTexture(width, height), width, height, 0});
+			}
+			physical = static_cast<int32_t>(mTargets.size() - 1);
+		}
+
+		mTargets[physical].lastUse = lastUse[resource];
+		mResources[resource].physical = physical;
+	}
+
+	for (const PhysicalTarget& target : previous)
+	{
+		UnloadRenderTexture(target.target);
+	}
+
+	mScreenWidth = GetScreenWidth();
+	mScreenHeight = GetScreenHeight();
+	mDirty = false;
+}
+
+void Mistral::RenderGraph::Execute()
+{
+	if (mDirty || mScreenWidth != GetScreenWidth() || mScreenHeight != GetScreenHeight())
+	{
+		Compile();
+	}
+
+	for (const uint32_t index : mOrder)
+	{
+		Pass& pass = mPasses[index];
+		PassStats& stats = mStats[index];
+
+		const double cpuStart = GetTime();
+
+		const Resource* target = pass.writes.empty() ? nullptr : &mResources[pass.writes.front()];
+		if (target && !target->imported)
+		{
+			BeginTextureMode(mTargets[target->physical].target);
+		}
+
+		pass.timer->Begin();
+
+		pass.execute(*this);
+
+		pass.timer->End();
+
+		if (target && !target->imported)
+		{
+			EndTextureMode();
+		}
+
+		stats.cpuTime = (GetTime() - cpuStart) * 1000.0;
+		stats.gpuTime = pass.timer->GetMilliseconds();
+	}
+}
+
+// Getters
+Mistral::RenderGraphResource Mistral::RenderGraph::GetBackbuffer() const
+{
+	return backbufferResource;
+}
+
+const Texture& Mistral::RenderGraph::GetTexture(const RenderGraphResource resource) const
+{
+	if (resource >= mResources.size() || mResources[resource].physical < 0)
+	{
+		throw std::runtime_error("Render graph texture not found");
+	}
+	return mTargets[mResources[resource].physical].target.texture;
+}
+
+std::span<const Mistral::RenderGraph::PassStats> Mistral::RenderGraph::GetPassStats() const
+{
+	return mStats;
+}
+
+uint32_t Mistral::RenderGraph::GetTransientTargetCount() const
+{
+	return static_cast<uint32_t>(std::ranges::count_if(mResources, [](const Resource& resource) { return resource.physical >= 0; }));
+}
+
+uint32_t Mistral::RenderGraph::GetPhysicalTargetCount() const
+{
+	return mTargets.size();
+}
+
+// Internal
+void Mistral::RenderGraph::ResolveSize(const RenderTargetDesc& desc, int& width, int& height) const
+{
+	width = desc.width > 0 ? desc.width : GetScreenWidth();
+	height = desc.height > 0 ? desc.height : GetScreenHeight();
+	width = std::max(1, static_cast<int>(std::lround(static_cast<float>(width) * desc.scale)));
+	height = std::max(1, static_cast<int>(std::lround(static_cast<float>(height) * desc.scale)));
+}
+
+void Mistral::RenderGraph::ReleaseTargets()
+{
+	for (const PhysicalTarget& target : mTargets)
+	{
+		UnloadRenderTexture(target.target);
+	}
+
+	mTargets.clear();
+	for (Resource& resource : mResources)
+	{
+		resource.physical = -1;
+	}
+}
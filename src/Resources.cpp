@@ -3,8 +3,11 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <vector>
 
+#include "MeshOptimizer.h"
+
 #if defined(_WIN32)
 	#define WIN32_LEAN_AND_MEAN
 	#define NOGDI
@@ -18,7 +21,33 @@
 
 namespace
 {
+	struct LoadedAtlas
+	{
+		std::unique_ptr<Mistral::TextureAtlas> atlas;
+		uint32_t regionCount = 0; // Regions still registered as resources, the atlas and its pages go with the last one
+	};
+
 	std::map<std::filesystem::path, Mistral::Resource, std::less<>> resources;
+	std::vector<LoadedAtlas> atlases;
+
+	void ReleaseAtlasRegion(const Mistral::TextureRegion& region)
+	{
+		const auto owner = std::ranges::find_if(atlases, [&region](const LoadedAtlas& loaded) {
+			for (uint32_t page = 0; page < loaded.atlas->GetPageCount(); page++)
+			{
+				if (loaded.atlas->GetPage(page).id == region.texture.id)
+				{
+					return true;
+				}
+			}
+			return false;
+		});
+
+		if (owner != atlases.end() && --owner->regionCount == 0)
+		{
+			atlases.erase(owner);
+		}
+	}
 } // namespace
 
 static bool FileIsSupported(const std::filesystem::path& path,
@@ -54,6 +83,11 @@ bool Mistral::ResourceLoad(const std::filesystem::path& path)
 	{
 		resource.type = ResourceType::Model;
 		resource.model = LoadModel(path.string().c_str());
+
+		if (IsMeshOptimizationEnabled())
+		{
+			OptimizeModel(resource.model);
+		}
 	}
 	else if (FileIsSupported(path, {".ttf", ".otf"}))
 	{
@@ -65,6 +99,64 @@ bool Mistral::ResourceLoad(const std::filesystem::path& path)
 	return true;
 }
 
+bool Mistral::ResourceLoadLod(const std::filesystem::path& path)
+{
+	if (!std::filesystem::exists(path))
+	{
+		std::cerr << "[Error] Resource not found: " << path << std::endl;
+		return false;
+	}
+
+	if (!FileIsSupported(path, {".obj", ".iqm", ".gltf", ".vox", ".m3d", ".glb"}))
+	{
+		std::cerr << "[Error] Resource is not a model: " << path << std::endl;
+		return false;
+	}
+
+	Resource resource;
+	resource.type = ResourceType::LodModel;
+	resource.lodModel = LoadLodModel(path);
+
+	resources.emplace(path, resource);
+	return true;
+}
+
+bool Mistral::ResourceLoadAtlas(const std::span<const std::filesystem::path> paths, const std::filesystem::path& cacheDirectory)
+{
+	auto atlas = std::make_unique<TextureAtlas>();
+	if (!atlas->Build(paths, cacheDirectory))
+	{
+		std::cerr << "[Error] Atlas could not be built" << std::endl;
+		return false;
+	}
+
+	bool loaded = true;
+	uint32_t regionCount = 0;
+	for (const auto& path : paths)
+	{
+		// Replacing a region of an older atlas releases it, freeing that atlas once none of its regions are left
+		ResourceUnload(path);
+
+		if (!atlas->Contains(path))
+		{
+			loaded &= ResourceLoad(path);
+			continue;
+		}
+
+		Resource resource;
+		resource.type = ResourceType::AtlasRegion;
+		resource.region = atlas->GetRegion(path);
+		resources.emplace(path, resource);
+		regionCount++;
+	}
+
+	if (regionCount > 0)
+	{
+		atlases.push_back({std::move(atlas), regionCount});
+	}
+	return loaded;
+}
+
 bool Mistral::ResourceUnload(const std::filesystem::path& path)
 {
 	if (resources.contains(path))
@@ -82,9 +174,15 @@ bool Mistral::ResourceUnload(const std::filesystem::path& path)
 			case ResourceType::Model:
 				UnloadModel(res.model);
 				break;
+			case ResourceType::LodModel:
+				UnloadLodModel(res.lodModel);
+				break;
 			case ResourceType::Font:
 				UnloadFont(res.font);
 				break;
+			case ResourceType::AtlasRegion:
+				ReleaseAtlasRegion(res.region);
+				break;
 			default:
 				break;
 		}
@@ -95,6 +193,16 @@ bool Mistral::ResourceUnload(const std::filesystem::path& path)
 	return false;
 }
 
+void Mistral::UnloadResources()
+{
+	while (!resources.empty())
+	{
+		const std::filesystem::path path = resources.begin()->first;
+		ResourceUnload(path);
+	}
+	atlases.clear();
+}
+
 Mistral::Resource& Mistral::ResourceGet(const std::filesystem::path& path)
 {
 	if (!resources.contains(path))
@@ -112,7 +220,26 @@ Mistral::Resource& Mistral::ResourceGet(const std::filesystem::path& path)
 
 Texture& Mistral::GetTexture(const std::filesystem::path& path)
 {
-	return ResourceGet(path).texture;
+	auto& resource = ResourceGet(path);
+	if (resource.type == ResourceType::AtlasRegion)
+	{
+		return resource.region.texture;
+	}
+	return resource.texture;
+}
+
+Mistral::TextureRegion Mistral::GetTextureRegion(const std::filesystem::path& path)
+{
+	const auto& resource = ResourceGet(path);
+	switch (resource.type)
+	{
+		case ResourceType::AtlasRegion:
+			return resource.region;
+		case ResourceType::Texture:
+			return {resource.texture, {0.f, 0.f, static_cast<float>(resource.texture.width), static_cast<float>(resource.texture.height)}};
+		default:
+			return {};
+	}
 }
 
 Sound& Mistral::GetSound(const std::filesystem::path& path)
@@ -125,6 +252,26 @@ Model& Mistral::GetModel(const std::filesystem::path& path)
 	return ResourceGet(path).model;
 }
 
+Mistral::LodModel& Mistral::GetLodModel(const std::filesystem::path& path)
+{
+	if (!resources.contains(path) && !ResourceLoadLod(path))
+	{
+		std::cout << "Could not get the resource: " << path.filename() << std::endl;
+		static LodModel dummy = {};
+		return dummy;
+	}
+
+	auto& resource = resources.at(path);
+	if (resource.type != ResourceType::LodModel)
+	{
+		std::cerr << "[Error] Resource was not loaded as a LOD model: " << path << std::endl;
+		static LodModel dummy = {};
+		return dummy;
+	}
+
+	return resource.lodModel;
+}
+
 Font& Mistral::GetFont(const std::filesystem::path& path)
 {
 	return ResourceGet(path).font;
@@ -1,8 +1,54 @@
 #include "Spatial.h"
 
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include "Color.h"
+#include "DebugDraw.h"
+#include "JobSystem.h"
+
+namespace
+{
+	// Roots of the subtrees changed since the last flush, a node is queued at most once
+	std::vector<Spatial*> dirtyRoots;
+
+	// Nodes to refresh in breadth-first order, levelOffsets[depth] being where each depth starts, kept around to reuse their storage
+	std::vector<const Spatial*> flushNodes;
+	std::vector<size_t> levelOffsets;
+
+	// Depth levels smaller than this are refreshed on the calling thread, handing them to the workers would cost more than the work
+	constexpr size_t parallelLevelCount = 2048;
+	constexpr uint32_t parallelChunkSize = 256;
+
+	Matrix4x4 InvertTransform(const Matrix4x4& matrix)
+	{
+		return matrix.AffineInverted();
+	}
+
+	Affine3x4 InvertTransform(const Affine3x4& affine)
+	{
+		return affine.Inverted();
+	}
+
+	// World matrix column scaled back to unit length. A zero scale flattens it, the axis is then rebuilt from the cross product of the
+	// two following ones, or left as the world axis when they are flattened too
+	Vec3 GetBasisVector(const Vec3& column, const float scale, const Vec3& next, const float nextScale, const Vec3& last, const float lastScale,
+						const Vec3& axis)
+	{
+		if (scale > 0.f)
+		{
+			return column / scale;
+		}
+
+		if (nextScale > 0.f && lastScale > 0.f)
+		{
+			return (next / nextScale).Cross(last / lastScale);
+		}
+
+		return axis;
+	}
+} // namespace
 
 Spatial::Spatial():
 	mPosition(Vec3::Zero),
@@ -14,13 +60,30 @@ Spatial::Spatial():
 Spatial::Spatial(const Vec3& position, const Quat& rotation, const Vec3& scale):
 	mPosition(position),
 	mRotation(rotation),
-	mScale(scale)
+	mScale(scale),
+	mLocalMatrix(SpatialTransform::FromPRS(position, rotation, scale))
 {
-	UpdateMatrices();
+	mWorldMatrix = mLocalMatrix;
+	DecomposeWorldMatrix();
 }
 
 Spatial::~Spatial()
 {
+	if (mIsQueued)
+	{
+		std::erase(dirtyRoots, this);
+	}
+
+	if (mParent)
+	{
+		mParent->RemoveChildInternal(this);
+	}
+
+	for (Spatial* child : mChildren)
+	{
+		child->SetParentInternal(nullptr);
+		child->MarkDirty();
+	}
 }
 
 // Setters
@@ -42,6 +105,18 @@ void Spatial::SetScale(const Vec3& scale)
 	MarkDirty();
 }
 
+void Spatial::SetWorldPosition(const Vec3& position)
+{
+	mPosition = mParent ? mParent->GetInverseWorldTransform().TransformPoint(position) : position;
+	MarkDirty();
+}
+
+void Spatial::SetWorldRotation(const Quat& rotation)
+{
+	mRotation = mParent ? mParent->GetRotation().Conjugate() * rotation : rotation;
+	MarkDirty();
+}
+
 void Spatial::SetParent(Spatial* parent)
 {
 	if (mParent == parent)
@@ -73,6 +148,7 @@ void Spatial::AddChild(Spatial* child)
 
 	AddChildInternal(child);
 	child->SetParentInternal(this);
+	child->MarkDirty();
 }
 
 void Spatial::RemoveChild(Spatial* child)
@@ -84,54 +160,50 @@ void Spatial::RemoveChild(Spatial* child)
 
 	RemoveChildInternal(child);
 	child->SetParentInternal(nullptr);
+	child->MarkDirty();
 }
 
 // Getters
 const Vec3& Spatial::GetLocalPosition() const
 {
-	UpdateMatrices();
 	return mPosition;
 }
 
 const Quat& Spatial::GetLocalRotation() const
 {
-	UpdateMatrices();
 	return mRotation;
 }
 
 const Vec3& Spatial::GetLocalScale() const
 {
-	UpdateMatrices();
 	return mScale;
 }
 
-Vec3 Spatial::GetPosition() const
+const Vec3& Spatial::GetPosition() const
 {
-	UpdateMatrices();
-	return mWorldMatrix.GetPosition();
+	FlushTransforms();
+	return mWorldPosition;
 }
 
-Quat Spatial::GetRotation() const
+const Quat& Spatial::GetRotation() const
 {
-	UpdateMatrices();
-	return mWorldMatrix.GetRotation();
+	FlushTransforms();
+	return mWorldRotation;
 }
 
-Vec3 Spatial::GetScale() const
+const Vec3& Spatial::GetScale() const
 {
-	UpdateMatrices();
-	return mWorldMatrix.GetScale();
+	FlushTransforms();
+	return mWorldScale;
 }
 
 Spatial* Spatial::GetParent()
 {
-	UpdateMatrices();
 	return mParent;
 }
 
 const Spatial* Spatial::GetParent() const
 {
-	UpdateMatrices();
 	return mParent;
 }
 
@@ -169,71 +241,168 @@ void Spatial::Scale(const Vec3& amount)
 	MarkDirty();
 }
 
+void Spatial::LookAt(const Vec3& target, const Vec3& up)
+{
+	const Vec3 direction = target - GetPosition();
+	if (direction.LengthSqr() <= 0.f)
+	{
+		return;
+	}
+
+	const Vec3 forward = direction.Normalized();
+	Vec3 right = up.Cross(forward);
+
+	// Looking along up leaves no plane to build the basis from, any world axis away from the direction stands in for it
+	if (right.LengthSqr() <= 1e-12f)
+	{
+		right = (std::fabs(forward.z) < .9f ? Vec3::Forward : Vec3::Right).Cross(forward);
+	}
+
+	right = right.Normalized();
+	const Vec3 trueUp = forward.Cross(right);
+
+	const Matrix4x4 basis = {right.x, right.y, right.z, 0.f, trueUp.x, trueUp.y, trueUp.z, 0.f, forward.x, forward.y, forward.z, 0.f, 0.f, 0.f, 0.f, 1.f};
+	SetWorldRotation(basis.GetRotation());
+}
+
 // Functionalities
-const Matrix4x4& Spatial::GetMatrix() const
+SpatialMatrix Spatial::GetMatrix() const
 {
-	UpdateMatrices();
+	FlushTransforms();
 	return mWorldMatrix;
 }
 
-const Matrix4x4& Spatial::GetLocalMatrix() const
+SpatialMatrix Spatial::GetLocalMatrix() const
 {
-	UpdateMatrices();
+	if (mIsDirty)
+	{
+		FlushTransforms();
+	}
+
 	return mLocalMatrix;
 }
 
+SpatialMatrix Spatial::GetInverseMatrix() const
+{
+	return GetInverseWorldTransform();
+}
+
+const SpatialTransform& Spatial::GetWorldTransform() const
+{
+	FlushTransforms();
+	return mWorldMatrix;
+}
+
+const SpatialTransform& Spatial::GetInverseWorldTransform() const
+{
+	FlushTransforms();
+
+	if (mIsInverseDirty)
+	{
+		mInverseWorldMatrix = InvertTransform(mWorldMatrix);
+		mIsInverseDirty = false;
+	}
+
+	return mInverseWorldMatrix;
+}
+
+Vec3 Spatial::TransformPoint(const Vec3& point) const
+{
+	return GetWorldTransform().TransformPoint(point);
+}
+
+Vec3 Spatial::TransformVector(const Vec3& vector) const
+{
+	return GetWorldTransform().TransformVector(vector);
+}
+
+Vec3 Spatial::TransformDirection(const Vec3& direction) const
+{
+	return GetRotation() * direction;
+}
+
+Vec3 Spatial::InverseTransformPoint(const Vec3& point) const
+{
+	return GetInverseWorldTransform().TransformPoint(point);
+}
+
+Vec3 Spatial::InverseTransformVector(const Vec3& vector) const
+{
+	return GetInverseWorldTransform().TransformVector(vector);
+}
+
+Vec3 Spatial::InverseTransformDirection(const Vec3& direction) const
+{
+	return GetRotation().Conjugate() * direction;
+}
+
 Vec3 Spatial::Forward() const
 {
-	return GetRotation() * Vec3::Forward;
+	FlushTransforms();
+	return GetBasisVector({mWorldMatrix.m8, mWorldMatrix.m9, mWorldMatrix.m10}, mWorldScale.z, {mWorldMatrix.m0, mWorldMatrix.m1, mWorldMatrix.m2},
+						  mWorldScale.x, {mWorldMatrix.m4, mWorldMatrix.m5, mWorldMatrix.m6}, mWorldScale.y, Vec3::Forward);
 }
 
 Vec3 Spatial::Right() const
 {
-	return GetRotation() * Vec3::Right;
+	FlushTransforms();
+	return GetBasisVector({mWorldMatrix.m0, mWorldMatrix.m1, mWorldMatrix.m2}, mWorldScale.x, {mWorldMatrix.m4, mWorldMatrix.m5, mWorldMatrix.m6},
+						  mWorldScale.y, {mWorldMatrix.m8, mWorldMatrix.m9, mWorldMatrix.m10}, mWorldScale.z, Vec3::Right);
 }
 
 Vec3 Spatial::Up() const
 {
-	return GetRotation() * Vec3::Up;
+	FlushTransforms();
+	return GetBasisVector({mWorldMatrix.m4, mWorldMatrix.m5, mWorldMatrix.m6}, mWorldScale.y, {mWorldMatrix.m8, mWorldMatrix.m9, mWorldMatrix.m10},
+						  mWorldScale.z, {mWorldMatrix.m0, mWorldMatrix.m1, mWorldMatrix.m2}, mWorldScale.x, Vec3::Up);
 }
 
 Vec3 Spatial::Back() const
 {
-	return GetRotation() * Vec3::Back;
+	return Forward() * -1.f;
 }
 
 Vec3 Spatial::Left() const
 {
-	return GetRotation() * Vec3::Left;
+	return Right() * -1.f;
 }
 
 Vec3 Spatial::Down() const
 {
-	return GetRotation() * Vec3::Down;
+	return Up() * -1.f;
 }
 
 // Internal
-void Spatial::MarkDirty() const
+void Spatial::MarkDirty()
 {
-	if (mIsDirty)
+	mIsDirty = true;
+
+	if (!mIsQueued)
 	{
-		return;
+		mIsQueued = true;
+		dirtyRoots.push_back(this);
 	}
-
-	mIsDirty = true;
-	std::ranges::for_each(mChildren, [](const auto& child) { child->MarkDirty(); });
 }
 
-void Spatial::UpdateMatrices() const
+void Spatial::UpdateWorldMatrix() const
 {
-	if (!mIsDirty)
+	if (mIsDirty)
 	{
-		return;
+		mLocalMatrix = SpatialTransform::FromPRS(mPosition, mRotation, mScale);
+		mIsDirty = false;
 	}
 
-	mLocalMatrix = Matrix4x4::FromPRS(mPosition, mRotation, mScale);
-	mWorldMatrix = mParent ? mParent->GetMatrix() * mLocalMatrix : mLocalMatrix;
-	mIsDirty = false;
+	mWorldMatrix = mParent ? mParent->mWorldMatrix * mLocalMatrix : mLocalMatrix;
+	DecomposeWorldMatrix();
+}
+
+void Spatial::DecomposeWorldMatrix() const
+{
+	mIsInverseDirty = true;
+
+	mWorldPosition = mWorldMatrix.GetPosition();
+	mWorldScale = mWorldMatrix.GetScale();
+	mWorldRotation = mWorldMatrix.GetRotation();
 }
 
 void Spatial::SetParentInternal(Spatial* parent)
@@ -255,25 +424,83 @@ void Spatial::RemoveChildInternal(Spatial* child)
 	std::erase(mChildren, child);
 }
 
+void FlushTransforms()
+{
+	if (dirtyRoots.empty())
+	{
+		return;
+	}
+
+	// A queued node below another queued node is refreshed with it, only the topmost ones are walked
+	flushNodes.clear();
+	levelOffsets.clear();
+	for (Spatial* spatial : dirtyRoots)
+	{
+		const Spatial* ancestor = spatial->mParent;
+		while (ancestor && !ancestor->mIsQueued)
+		{
+			ancestor = ancestor->mParent;
+		}
+
+		if (!ancestor)
+		{
+			flushNodes.push_back(spatial);
+		}
+	}
+
+	for (Spatial* spatial : dirtyRoots)
+	{
+		spatial->mIsQueued = false;
+	}
+	dirtyRoots.clear();
+
+	// Roots are never ancestors of each other, so gathering the subtrees level by level visits every node once, after its parent
+
+	size_t levelBegin = 0;
+	while (levelBegin < flushNodes.size())
+	{
+		const size_t levelEnd = flushNodes.size();
+		levelOffsets.push_back(levelBegin);
+
+		for (size_t index = levelBegin; index < levelEnd; index++)
+		{
+			const std::vector<Spatial*>& children = flushNodes[index]->mChildren;
+			flushNodes.insert(flushNodes.end(), children.cbegin(), children.cend());
+		}
+
+		levelBegin = levelEnd;
+	}
+	levelOffsets.push_back(flushNodes.size());
+
+	// Nodes of a level only read the world matrices of the level above, each level is split across the workers once it's wide enough
+	const bool isParallel = Mistral::GetWorkerCount() > 1;
+	for (size_t level = 0; level + 1 < levelOffsets.size(); level++)
+	{
+		const size_t begin = levelOffsets[level];
+		const size_t end = levelOffsets[level + 1];
+
+		if (!isParallel || end - begin < parallelLevelCount)
+		{
+			for (size_t index = begin; index < end; index++)
+			{
+				flushNodes[index]->UpdateWorldMatrix();
+			}
+			continue;
+		}
+
+		const Spatial* const* nodes = flushNodes.data() + begin;
+		Mistral::ParallelFor(static_cast<uint32_t>(end - begin), parallelChunkSize, [nodes](const uint32_t chunkBegin, const uint32_t chunkEnd) {
+			for (uint32_t index = chunkBegin; index < chunkEnd; index++)
+			{
+				nodes[index]->UpdateWorldMatrix();
+			}
+		});
+	}
+}
+
 void DrawSpatial(const Spatial& spatial, const float size)
 {
-	static constexpr int sides = 12;
-	const float lineSize = .05f * size;
-	const float coneSize = .1f * size;
-	const float lineLength = 1.f * size;
-	const float coneLength = .2f * size;
-	const auto& pos = spatial.GetPosition();
-	const auto& scale = spatial.GetLocalScale();
-	DrawSphere(pos, .1f, Color4::Black);
-
-	DrawCylinderEx(pos, pos + spatial.Right() * lineLength * scale.x, lineSize, lineSize, sides, Color4::Red);
-	DrawCylinderEx(pos, pos + spatial.Up() * lineLength * scale.y, lineSize, lineSize, sides, Color4::Green);
-	DrawCylinderEx(pos, pos + spatial.Forward() * lineLength * scale.z, lineSize, lineSize, sides, Color4::Blue);
-
-	DrawCylinderEx(pos + spatial.Right() * lineLength * scale.x, pos + spatial.Right() * (lineLength * scale.x + coneLength), coneSize, 0.f, sides,
-				   Color4::Red);
-	DrawCylinderEx(pos + spatial.Up() * lineLength * scale.y, pos + spatial.Up() * (lineLength * scale.y + coneLength), coneSize, 0.f, sides,
-				   Color4::Green);
-	DrawCylinderEx(pos + spatial.Forward() * lineLength * scale.z, pos + spatial.Forward() * (lineLength * scale.z + coneLength), coneSize, 0.f,
-				   sides, Color4::Blue);
+	const Matrix4x4& matrix = spatial.GetMatrix();
+	Mistral::DebugDrawSphere({matrix.m12, matrix.m13, matrix.m14}, .1f, Color4::Black);
+	Mistral::DebugDrawAxes(matrix, size * 1.2f);
 }
\ No newline at end of file
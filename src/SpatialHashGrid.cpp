@@ -0,0 +1,229 @@
+#include "SpatialHashGrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "JobSystem.h"
+#include "Spatial.h"
+
+namespace
+{
+	constexpr uint32_t minTableSize = 64;
+	constexpr uint32_t pointsPerBlock = 4096;
+	constexpr uint32_t gatherChunkSize = 1024;
+
+	// Clamped so unbounded query radii don't overflow the conversion
+	int32_t ToCell(const float coordinate, const float inverseCellSize)
+	{
+		return static_cast<int32_t>(std::clamp(std::floor(coordinate * inverseCellSize), -1e9f, 1e9f));
+	}
+} // namespace
+
+Mistral::SpatialHashGrid::SpatialHashGrid(const float cellSize)
+{
+	SetCellSize(cellSize);
+}
+
+// Setters
+void Mistral::SpatialHashGrid::SetCellSize(const float cellSize)
+{
+	mCellSize = std::max(cellSize, 1e-4f);
+	mInverseCellSize = 1.f / mCellSize;
+}
+
+// Functionalities
+void Mistral::SpatialHashGrid::Build(const std::span<const Vec3> positions)
+{
+	const auto count = static_cast<uint32_t>(positions.size());
+	const uint32_t tableSize = std::bit_ceil(std::max(count * 2, minTableSize));
+	mTableMask = tableSize - 1;
+
+	mBuckets.resize(count);
+	mEntries.resize(count);
+	mCellStart.assign(tableSize + 1, 0);
+
+	// Every block counts and later scatters its own range, so the sort stays stable without any atomics
+	const uint32_t blockCount = std::clamp(count / pointsPerBlock, 1u, GetWorkerCount());
+	const uint32_t blockSize = (count + blockCount - 1) / blockCount;
+	mHistograms.assign(static_cast<size_t>(blockCount) * tableSize, 0);
+
+	ParallelFor(blockCount, 1, [&](const uint32_t blockBegin, const uint32_t blockEnd) {
+		for (uint32_t block = blockBegin; block < blockEnd; block++)
+		{
+			uint32_t* histogram = mHistograms.data() + static_cast<size_t>(block) * tableSize;
+			for (uint32_t index = block * blockSize; index < std::min(count, (block + 1) * blockSize); index++)
+			{
+				const Vec3& position = positions[index];
+				mBuckets[index] = GetBucket(ToCell(position.x, mInverseCellSize), ToCell(position.y, mInverseCellSize),
+											ToCell(position.z, mInverseCellSize));
+				histogram[mBuckets[index]]++;
+			}
+		}
+	});
+
+	uint32_t offset = 0;
+	for (uint32_t bucket = 0; bucket < tableSize; bucket++)
+	{
+		mCellStart[bucket] = offset;
+		for (uint32_t block = 0; block < blockCount; block++)
+		{
+			uint32_t& slot = mHistograms[static_cast<size_t>(block) * tableSize + bucket];
+			const uint32_t blockCountInBucket = slot;
+			slot = offset;
+			offset += blockCountInBucket;
+		}
+	}
+	mCellStart[tableSize] = offset;
+
+	ParallelFor(blockCount, 1, [&](const uint32_t blockBegin, const uint32_t blockEnd) {
+		for (uint32_t block = blockBegin; block < blockEnd; block++)
+		{
+			uint32_t* histogram = mHistograms.data() + static_cast<size_t>(block) * tableSize;
+			for (uint32_t index = block * blockSize; index < std::min(count, (block + 1) * blockSize); index++)
+			{
+				mEntries[histogram[mBuckets[index]]++] = {positions[index], index};
+			}
+		}
+	});
+}
+
+void Mistral::SpatialHashGrid::Build(const std::span<const Spatial* const> spatials)
+{
+	FlushTransforms();
+
+	mPositions.resize(spatials.size());
+
+	ParallelFor(static_cast<uint32_t>(spatials.size()), gatherChunkSize, [&](const uint32_t begin, const uint32_t end) {
+		for (uint32_t index = begin; index < end; index++)
+		{
+			mPositions[index] = spatials[index]->GetPosition();
+		}
+	});
+
+	Build(mPositions);
+}
+
+void Mistral::SpatialHashGrid::Clear()
+{
+	mEntries.clear();
+	mCellStart.clear();
+	mTableMask = 0;
+}
+
+void Mistral::SpatialHashGrid::QueryRadius(const Vec3& center, const float radius, std::vector<uint32_t>& results) const
+{
+	ForEachInRadius(center, radius, [&results](const Entry& entry, float) { results.push_back(entry.index); });
+}
+
+void Mistral::SpatialHashGrid::FindNearest(const Vec3& point, const uint32_t count, std::vector<uint32_t>& results,
+										   const float maxDistance) const
+{
+	results.clear();
+	if (count == 0 || mEntries.empty())
+	{
+		return;
+	}
+
+	// Grows the search radius until it holds enough points, any point outside it is then farther than all of them
+	thread_local std::vector<std::pair<float, uint32_t>> candidates;
+	for (float radius = std::min(mCellSize, maxDistance);; radius = std::min(radius * 2.f, maxDistance))
+	{
+		candidates.clear();
+		ForEachInRadius(point, radius, [](const Entry& entry, const float distanceSqr) { candidates.emplace_back(distanceSqr, entry.index); });
+
+		if (candidates.size() >= count || candidates.size() == mEntries.size() || radius >= maxDistance)
+		{
+			break;
+		}
+	}
+
+	const size_t found = std::min<size_t>(count, candidates.size());
+	std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(found), candidates.end());
+	for (size_t index = 0; index < found; index++)
+	{
+		results.push_back(candidates[index].second);
+	}
+}
+
+// Getters
+float Mistral::SpatialHashGrid::GetCellSize() const
+{
+	return mCellSize;
+}
+
+uint32_t Mistral::SpatialHashGrid::GetCount() const
+{
+	return static_cast<uint32_t>(mEntries.size());
+}
+
+uint32_t Mistral::SpatialHashGrid::GetTableSize() const
+{
+	return mCellStart.empty() ? 0 : mTableMask + 1;
+}
+
+// Internal
+uint32_t Mistral::SpatialHashGrid::GetBucket(const int32_t x, const int32_t y, const int32_t z) const
+{
+	const uint32_t hash = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u ^ static_cast<uint32_t>(z) * 83492791u;
+	return hash & mTableMask;
+}
+
+template <typename Function>
+void Mistral::SpatialHashGrid::ForEachInRadius(const Vec3& center, const float radius, Function&& function) const
+{
+	if (mEntries.empty())
+	{
+		return;
+	}
+
+	const float radiusSqr = radius * radius;
+	const auto visit = [&](const uint32_t begin, const uint32_t end) {
+		for (uint32_t index = begin; index < end; index++)
+		{
+			const Entry& entry = mEntries[index];
+			if (const float distanceSqr = (entry.position - center).LengthSqr(); distanceSqr <= radiusSqr)
+			{
+				function(entry, distanceSqr);
+			}
+		}
+	};
+
+	const int32_t minX = ToCell(center.x - radius, mInverseCellSize);
+	const int32_t minY = ToCell(center.y - radius, mInverseCellSize);
+	const int32_t minZ = ToCell(center.z - radius, mInverseCellSize);
+	const int32_t maxX = ToCell(center.x + radius, mInverseCellSize);
+	const int32_t maxY = ToCell(center.y + radius, mInverseCellSize);
+	const int32_t maxZ = ToCell(center.z + radius, mInverseCellSize);
+
+	// Covering more cells than there are buckets, a linear scan is cheaper
+	const double cellCount = (static_cast<double>(maxX) - minX + 1) * (static_cast<double>(maxY) - minY + 1) * (static_cast<double>(maxZ) - minZ + 1);
+	if (cellCount > static_cast<double>(mTableMask + 1))
+	{
+		visit(0, static_cast<uint32_t>(mEntries.size()));
+		return;
+	}
+
+	thread_local std::vector<uint32_t> buckets;
+	buckets.clear();
+	for (int32_t z = minZ; z <= maxZ; z++)
+	{
+		for (int32_t y = minY; y <= maxY; y++)
+		{
+			for (int32_t x = minX; x <= maxX; x++)
+			{
+				buckets.push_back(GetBucket(x, y, z));
+			}
+		}
+	}
+
+	// Distinct cells may hash to the same bucket, which must only be scanned once
+	std::ranges::sort(buckets);
+	const auto duplicates = std::ranges::unique(buckets);
+	buckets.erase(duplicates.begin(), duplicates.end());
+
+	for (const uint32_t bucket : buckets)
+	{
+		visit(mCellStart[bucket], mCellStart[bucket + 1]);
+	}
+}
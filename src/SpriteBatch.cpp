@@ -0,0 +1,204 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Matrix.h"
+#include "rlgl.h"
+
+namespace
+{
+	// Larger than the default rlgl batch so big sprite counts need fewer uploads, the buffers are cycled to avoid waiting on the GPU
+	constexpr int batchBufferCount = 4;
+	constexpr int batchQuadCount = 16384;
+
+	struct Sprite
+	{
+		float x[4];
+		float y[4];
+		float u[2];
+		float v[2];
+		Color tint;
+		unsigned int textureId;
+		int32_t layer;
+	};
+
+	std::vector<Sprite> sprites;
+	std::vector<uint32_t> order;
+	rlRenderBatch batch = {};
+	bool batchLoaded = false;
+	Mistral::SpriteBatchStats stats;
+} // namespace
+
+void Mistral::SubmitSprite(const Texture& texture, const Rectangle& source, const Rectangle& destination, const Vector2 origin,
+						   const float rotation, const Color tint, const int32_t layer)
+{
+	if (texture.id == 0)
+	{
+		return;
+	}
+
+	Sprite& sprite = sprites.emplace_back();
+	sprite.tint = tint;
+	sprite.textureId = texture.id;
+	sprite.layer = layer;
+
+	// Texture coordinates follow DrawTexturePro, negative source sizes flip the sprite
+	const float width = static_cast<float>(texture.width);
+	const float height = static_cast<float>(texture.height);
+	const float left = source.x / width;
+	const float right = (source.x + std::abs(source.width)) / width;
+	const float top = source.y / height;
+	const float bottom = (source.y + std::abs(source.height)) / height;
+	sprite.u[0] = source.width < 0.f ? right : left;
+	sprite.u[1] = source.width < 0.f ? left : right;
+	sprite.v[0] = source.height < 0.f ? bottom : top;
+	sprite.v[1] = source.height < 0.f ? top : bottom;
+
+	// Corners in counter-clockwise order starting at the top left, rotated around the destination position
+	const float offsetsX[4] = {-origin.x, -origin.x, destination.width - origin.x, destination.width - origin.x};
+	const float offsetsY[4] = {-origin.y, destination.height - origin.y, destination.height - origin.y, -origin.y};
+	const float sin = rotation == 0.f ? 0.f : std::sin(rotation * DEG2RAD);
+	const float cos = rotation == 0.f ? 1.f : std::cos(rotation * DEG2RAD);
+
+	// Sprites are drawn after BeginMode2D ended, so the modelview it set is baked into the corners now
+	const Matrix modelview = rlGetMatrixModelview();
+
+	for (int corner = 0; corner < 4; corner++)
+	{
+		const float x = destination.x + offsetsX[corner] * cos - offsetsY[corner] * sin;
+		const float y = destination.y + offsetsX[corner] * sin + offsetsY[corner] * cos;
+		sprite.x[corner] = modelview.m0 * x + modelview.m4 * y + modelview.m12;
+		sprite.y[corner] = modelview.m1 * x + modelview.m5 * y + modelview.m13;
+	}
+}
+
+void Mistral::SubmitSprite(const Texture& texture, const Vector2 position, const Color tint, const int32_t layer)
+{
+	const float width = static_cast<float>(texture.width);
+	const float height = static_cast<float>(texture.height);
+	SubmitSprite(texture, {0.f, 0.f, width, height}, {position.x, position.y, width, height}, {0.f, 0.f}, 0.f, tint, layer);
+}
+
+void Mistral::SubmitSprite(const TextureRegion& region, const Rectangle& destination, const Vector2 origin, const float rotation,
+						   const Color tint, const int32_t layer)
+{
+	SubmitSprite(region.texture, region.source, destination, origin, rotation, tint, layer);
+}
+
+void Mistral::SubmitSprite(const TextureRegion& region, const Vector2 position, const Color tint, const int32_t layer)
+{
+	const Rectangle destination = {position.x, position.y, std::abs(region.source.width), std::abs(region.source.height)};
+	SubmitSprite(region.texture, region.source, destination, {0.f, 0.f}, 0.f, tint, layer);
+}
+
+void Mistral::FlushSprites()
+{
+	if (sprites.empty())
+	{
+		return;
+	}
+
+	if (!batchLoaded)
+	{
+		batch = rlLoadRenderBatch(batchBufferCount, batchQuadCount);
+		batchLoaded = true;
+	}
+
+	// Stable so sprites sharing a layer and a texture keep their submission order
+	order.resize(sprites.size());
+	for (uint32_t index = 0; index < order.size(); index++)
+	{
+		order[index] = index;
+	}
+	std::ranges::stable_sort(order, [](const uint32_t a, const uint32_t b) {
+		const Sprite& spriteA = sprites[a];
+		const Sprite& spriteB = sprites[b];
+		return spriteA.layer != spriteB.layer ? spriteA.layer < spriteB.layer : spriteA.textureId < spriteB.textureId;
+	});
+
+	// Switching batches draws whatever was pending in the default one first, so immediate draws stay underneath
+	rlSetRenderBatchActive(&batch);
+
+	// Corners already carry the modelview of their submission
+	const Matrix modelview = rlGetMatrixModelview();
+	rlSetMatrixModelview(Matrix4x4::Identity);
+
+	uint32_t quadsInBuffer = 0;
+	size_t run = 0;
+	while (run < order.size())
+	{
+		const unsigned int textureId = sprites[order[run]].textureId;
+		const int32_t layer = sprites[order[run]].layer;
+
+		rlSetTexture(textureId);
+		rlBegin(RL_QUADS);
+
+		for (; run < order.size(); run++)
+		{
+			const Sprite& sprite = sprites[order[run]];
+			if (sprite.textureId != textureId || sprite.layer != layer)
+			{
+				break;
+			}
+
+			// rlgl flushes by itself when the buffer is full, counted here only to report the extra draw
+			if (++quadsInBuffer > static_cast<uint32_t>(batchQuadCount))
+			{
+				quadsInBuffer = 1;
+				stats.drawCalls++;
+			}
+
+			rlColor4ub(sprite.tint.r, sprite.tint.g, sprite.tint.b, sprite.tint.a);
+			rlNormal3f(0.f, 0.f, 1.f);
+
+			rlTexCoord2f(sprite.u[0], sprite.v[0]);
+			rlVertex2f(sprite.x[0], sprite.y[0]);
+
+			rlTexCoord2f(sprite.u[0], sprite.v[1]);
+			rlVertex2f(sprite.x[1], sprite.y[1]);
+
+			rlTexCoord2f(sprite.u[1], sprite.v[1]);
+			rlVertex2f(sprite.x[2], sprite.y[2]);
+
+			rlTexCoord2f(sprite.u[1], sprite.v[0]);
+			rlVertex2f(sprite.x[3], sprite.y[3]);
+		}
+
+		rlEnd();
+		stats.drawCalls++;
+	}
+
+	rlSetTexture(0);
+
+	// Draws the sprite batch and restores the default one
+	rlSetRenderBatchActive(nullptr);
+
+	rlSetMatrixModelview(modelview);
+
+	stats.sprites += static_cast<uint32_t>(sprites.size());
+	sprites.clear();
+}
+
+Mistral::SpriteBatchStats Mistral::GetSpriteBatchStats()
+{
+	return stats;
+}
+
+void Mistral::ResetSpriteBatchStats()
+{
+	stats = {};
+}
+
+void Mistral::UnloadSpriteBatch()
+{
+	sprites.clear();
+
+	if (batchLoaded)
+	{
+		rlUnloadRenderBatch(batch);
+		batch = {};
+		batchLoaded = false;
+	}
+}
@@ -0,0 +1,414 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+	constexpr const char* cacheLayoutFile = "atlas.txt";
+	constexpr const char* cacheHeader = "MistralAtlas";
+	constexpr int cacheVersion = 1;
+
+	// Bottom-left skyline packer, every node is a horizontal segment of the top edge of the packed area
+	class Skyline
+	{
+	  public:
+
+		explicit Skyline(const int size):
+			mSize(size),
+			mNodes({{0, 0, size}})
+		{
+		}
+
+		bool Insert(const int width, const int height, int& x, int& y)
+		{
+			int bestIndex = -1;
+			int bestTop = mSize + 1;
+			int bestWidth = mSize + 1;
+
+			for (size_t index = 0; index < mNodes.size(); index++)
+			{
+				int top = 0;
+				if (!Fits(index, width, height, top))
+				{
+					continue;
+				}
+
+				if (top + height < bestTop || (top + height == bestTop && mNodes[index].width < bestWidth))
+				{
+					bestIndex = static_cast<int>(index);
+					bestTop = top + height;
+					bestWidth = mNodes[index].width;
+					y = top;
+				}
+			}
+
+			if (bestIndex < 0)
+			{
+				return false;
+			}
+
+			x = mNodes[bestIndex].x;
+			Place(bestIndex, x, y + height, width);
+			return true;
+		}
+
+	  private:
+
+		struct Node
+		{
+			int x;
+			int y;
+			int width;
+		};
+
+		// The rectangle rests on the highest node it spans
+		bool Fits(const size_t index, const int width, const int height, int& top) const
+		{
+			if (mNodes[index].x + width > mSize)
+			{
+				return false;
+			}
+
+			top = 0;
+			int remaining = width;
+			for (size_t node = index; remaining > 0; node++)
+			{
+				if (node == mNodes.size())
+				{
+					return false;
+				}
+
+				top = std::max(top, mNodes[node].y);
+				if (top + height > mSize)
+				{
+					return false;
+				}
+				remaining -= mNodes[node].width;
+			}
+			return true;
+		}
+
+		void Place(const int index, const int x, const int y, const int width)
+		{
+			mNodes.insert(mNodes.begin() + index, {x, y, width});
+
+			// Shrink or remove the nodes now covered by the new one
+			for (size_t node = index + 1; node < mNodes.size();)
+			{
+				const int shrink = mNodes[node - 1].x + mNodes[node - 1].width - mNodes[node].x;
+				if (shrink <= 0)
+				{
+					break;
+				}
+
+				mNodes[node].x += shrink;
+				mNodes[node].width -= shrink;
+				if (mNodes[node].width > 0)
+				{
+					break;
+				}
+				mNodes.erase(mNodes.begin() + static_cast<std::ptrdiff_t>(node));
+			}
+
+			for (size_t node = 0; node + 1 < mNodes.size();)
+			{
+				if (mNodes[node].y == mNodes[node + 1].y)
+				{
+					mNodes[node].width += mNodes[node + 1].width;
+					mNodes.erase(mNodes.begin() + static_cast<std::ptrdiff_t>(node + 1));
+				}
+				else
+				{
+					node++;
+				}
+			}
+		}
+
+		int mSize;
+		std::vector<Node> mNodes;
+	};
+
+	int64_t GetWriteTime(const std::filesystem::path& path)
+	{
+		std::error_code error;
+		const auto time = std::filesystem::last_write_time(path, error);
+		return error ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+	}
+
+	std::filesystem::path GetPagePath(const std::filesystem::path& cacheDirectory, const size_t page)
+	{
+		return cacheDirectory / ("page" + std::to_string(page) + ".png");
+	}
+
+	// Copies the image into the page and repeats its border pixels over the padding around it
+	void Blit(const Image& page, const Image& image, const int x, const int y, const int padding)
+	{
+		auto* pagePixels = static_cast<uint32_t*>(page.data);
+		const auto* imagePixels = static_cast<const uint32_t*>(image.data);
+
+		for (int row = -padding; row < image.height + padding; row++)
+		{
+			const uint32_t* source = imagePixels + static_cast<size_t>(std::clamp(row, 0, image.height - 1)) * image.width;
+			uint32_t* destination = pagePixels + static_cast<size_t>(y + row) * page.width + x;
+
+			std::memcpy(destination, source, static_cast<size_t>(image.width) * sizeof(uint32_t));
+			for (int column = 1; column <= padding; column++)
+			{
+				destination[-column] = source[0];
+				destination[image.width - 1 + column] = source[image.width - 1];
+			}
+		}
+	}
+} // namespace
+
+Mistral::TextureAtlas::TextureAtlas(const int pageSize, const int padding):
+	mPageSize(pageSize),
+	mPadding(padding)
+{
+}
+
+Mistral::TextureAtlas::~TextureAtlas()
+{
+	Unload();
+}
+
+bool Mistral::TextureAtlas::Build(const std::span<const std::filesystem::path> paths, const std::filesystem::path& cacheDirectory)
+{
+	Unload();
+
+	if (!cacheDirectory.empty() && LoadCache(paths, cacheDirectory))
+	{
+		mLoadedFromCache = true;
+		CreateRegions();
+		return true;
+	}
+
+	std::vector<Image> images(paths.size());
+	std::vector<size_t> order;
+	mEntries.resize(paths.size());
+
+	for (size_t index = 0; index < paths.size(); index++)
+	{
+		mEntries[index] = {paths[index], GetWriteTime(paths[index]), -1, {}};
+
+		Image& image = images[index];
+		image = LoadImage(paths[index].string().c_str());
+		if (!image.data)
+		{
+			std::cerr << "[Error] Atlas image could not be loaded: " << paths[index] << std::endl;
+			continue;
+		}
+
+		if (image.width + mPadding * 2 > mPageSize || image.height + mPadding * 2 > mPageSize)
+		{
+			std::cerr << "[Warning] Image is too large for an atlas page: " << paths[index] << std::endl;
+			continue;
+		}
+
+		ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+		order.push_back(index);
+	}
+
+	// Tallest first packs noticeably tighter with a skyline
+	std::ranges::sort(order, [&images](const size_t a, const size_t b) {
+		return images[a].height != images[b].height ? images[a].height > images[b].height : images[a].width > images[b].width;
+	});
+
+	std::vector<Skyline> packers;
+	std::vector<Image> pages;
+	for (const size_t index : order)
+	{
+		const Image& image = images[index];
+		const int width = image.width + mPadding * 2;
+		const int height = image.height + mPadding * 2;
+
+		int x = 0;
+		int y = 0;
+		size_t page = 0;
+		while (page < packers.size() && !packers[page].Insert(width, height, x, y))
+		{
+			page++;
+		}
+
+		if (page == packers.size())
+		{
+			packers.emplace_back(mPageSize);
+			pages.push_back(GenImageColor(mPageSize, mPageSize, BLANK));
+			packers.back().Insert(width, height, x, y);
+		}
+
+		Blit(pages[page], image, x + mPadding, y + mPadding, mPadding);
+
+		Entry& entry = mEntries[index];
+		entry.page = static_cast<int32_t>(page);
+		entry.source = {static_cast<float>(x + mPadding), static_cast<float>(y + mPadding), static_cast<float>(image.width),
+						static_cast<float>(image.height)};
+	}
+
+	for (const Image& image : images)
+	{
+		if (image.data)
+		{
+			UnloadImage(image);
+		}
+	}
+
+	for (const Image& page : pages)
+	{
+		mPages.push_back(LoadTextureFromImage(page));
+	}
+
+	if (!cacheDirectory.empty())
+	{
+		SaveCache(cacheDirectory, pages);
+	}
+
+	for (const Image& page : pages)
+	{
+		UnloadImage(page);
+	}
+
+	CreateRegions();
+	return true;
+}
+
+void Mistral::TextureAtlas::Unload()
+{
+	for (const Texture& page : mPages)
+	{
+		UnloadTexture(page);
+	}
+
+	mPages.clear();
+	mEntries.clear();
+	mRegions.clear();
+	mLoadedFromCache = false;
+}
+
+// Getters
+bool Mistral::TextureAtlas::Contains(const std::filesystem::path& path) const
+{
+	return mRegions.contains(path);
+}
+
+const Mistral::TextureRegion& Mistral::TextureAtlas::GetRegion(const std::filesystem::path& path) const
+{
+	const auto region = mRegions.find(path);
+	if (region == mRegions.cend())
+	{
+		throw std::runtime_error("Atlas region not found");
+	}
+	return region->second;
+}
+
+uint32_t Mistral::TextureAtlas::GetPageCount() const
+{
+	return mPages.size();
+}
+
+const Texture& Mistral::TextureAtlas::GetPage(const uint32_t page) const
+{
+	return mPages.at(page);
+}
+
+bool Mistral::TextureAtlas::IsLoadedFromCache() const
+{
+	return mLoadedFromCache;
+}
+
+// Internal
+bool Mistral::TextureAtlas::LoadCache(const std::span<const std::filesystem::path> paths, const std::filesystem::path& cacheDirectory)
+{
+	std::ifstream file(cacheDirectory / cacheLayoutFile);
+	if (!file)
+	{
+		return false;
+	}
+
+	std::string header;
+	int version = 0;
+	int pageSize = 0;
+	int padding = 0;
+	size_t pageCount = 0;
+	size_t entryCount = 0;
+	file >> header >> version >> pageSize >> padding >> pageCount >> entryCount;
+	if (!file || header != cacheHeader || version != cacheVersion || pageSize != mPageSize || padding != mPadding || entryCount != paths.size())
+	{
+		return false;
+	}
+
+	// Any added, removed, reordered or modified image invalidates the whole layout
+	mEntries.resize(entryCount);
+	for (size_t index = 0; index < entryCount; index++)
+	{
+		Entry& entry = mEntries[index];
+		std::string path;
+		file >> entry.writeTime >> entry.page >> entry.source.x >> entry.source.y >> entry.source.width >> entry.source.height;
+		file.ignore(1);
+		std::getline(file, path);
+		entry.path = path;
+
+		if (!file || entry.path != paths[index].generic_string() || entry.writeTime != GetWriteTime(paths[index]) ||
+			entry.page >= static_cast<int32_t>(pageCount))
+		{
+			mEntries.clear();
+			return false;
+		}
+		entry.path = paths[index];
+	}
+
+	for (size_t page = 0; page < pageCount; page++)
+	{
+		const auto pagePath = GetPagePath(cacheDirectory, page);
+		const Texture texture = std::filesystem::exists(pagePath) ? LoadTexture(pagePath.string().c_str()) : Texture{};
+		if (texture.id == 0)
+		{
+			Unload();
+			return false;
+		}
+		mPages.push_back(texture);
+	}
+
+	return true;
+}
+
+void Mistral::TextureAtlas::SaveCache(const std::filesystem::path& cacheDirectory, const std::span<const Image> pages) const
+{
+	std::error_code error;
+	std::filesystem::create_directories(cacheDirectory, error);
+	std::filesystem::remove(cacheDirectory / cacheLayoutFile, error);
+
+	for (size_t page = 0; page < pages.size(); page++)
+	{
+		if (!ExportImage(pages[page], GetPagePath(cacheDirectory, page).string().c_str()))
+		{
+			std::cerr << "[Error] Atlas page could not be cached: " << GetPagePath(cacheDirectory, page) << std::endl;
+			return;
+		}
+	}
+
+	// Written last so an interrupted save never leaves a layout pointing at missing pages
+	std::ofstream file(cacheDirectory / cacheLayoutFile);
+	file << cacheHeader << ' ' << cacheVersion << '\n' << mPageSize << ' ' << mPadding << ' ' << pages.size() << ' ' << mEntries.size() << '\n';
+	for (const Entry& entry : mEntries)
+	{
+		file << entry.writeTime << ' ' << entry.page << ' ' << entry.source.x << ' ' << entry.source.y << ' ' << entry.source.width << ' '
+			 << entry.source.height << ' ' << entry.path.generic_string() << '\n';
+	}
+}
+
+void Mistral::TextureAtlas::CreateRegions()
+{
+	for (const Entry& entry : mEntries)
+	{
+		if (entry.page >= 0)
+		{
+			mRegions[entry.path] = {mPages[entry.page], entry.source};
+		}
+	}
+}
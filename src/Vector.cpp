@@ -1,10 +1,10 @@
 #include "Vector.h"
 
 #include <algorithm>
-#include <cassert>
 #include <cmath>
 
 #include "Color.h"
+#include "FastMath.h"
 #include "imgui.h"
 
 const Vec2 Vec2::Zero = {0.f, 0.f};
@@ -28,39 +28,33 @@ const Vec4 Vec4::One = {1.f, 1.f, 1.f, 1.f};
 
 // Parametrized constructors
 Vec2::Vec2(const float x, const float y):
-	x(x),
-	y(y)
+	components{x, y}
 {
 }
 
 Vec2::Vec2(const float value):
-	x(value),
-	y(value)
+	components{value, value}
 {
 }
 
 // Copy constructors
 Vec2::Vec2(const Vec3& vector):
-	x(vector.x),
-	y(vector.y)
+	components{vector.x, vector.y}
 {
 }
 
 Vec2::Vec2(const Vec4& vector):
-	x(vector.x),
-	y(vector.y)
+	components{vector.x, vector.y}
 {
 }
 
 Vec2::Vec2(const Vector2& vector):
-	x(vector.x),
-	y(vector.y)
+	components{vector.x, vector.y}
 {
 }
 
 Vec2::Vec2(const ImVec2& vector):
-	x(vector.x),
-	y(vector.y)
+	components{vector.x, vector.y}
 {
 }
 
@@ -75,37 +69,6 @@ Vec2::operator ImVec2() const
 	return {x, y};
 }
 
-// Access operators
-float& Vec2::operator[](const std::size_t index)
-{
-	assert(index <= 1);
-	switch (index)
-	{
-		case 0:
-			return x;
-		case 1:
-			return y;
-		default:
-			break;
-	}
-	return x;
-}
-
-float Vec2::operator[](const std::size_t index) const
-{
-	assert(index <= 1);
-	switch (index)
-	{
-		case 0:
-			return x;
-		case 1:
-			return y;
-		default:
-			break;
-	}
-	return x;
-}
-
 // Compound assignment operators
 Vec2& Vec2::operator+=(const Vec2& vector) noexcept
 {
@@ -286,45 +249,33 @@ Vec2 Vec2::Lerp(const Vec2 target, const float amount) const
 
 // Parametrized constructors
 Vec3::Vec3(const float x, const float y, const float z):
-	x(x),
-	y(y),
-	z(z)
+	components{x, y, z}
 {
 }
 
 Vec3::Vec3(const float value):
-	x(value),
-	y(value),
-	z(value)
+	components{value, value, value}
 {
 }
 
 // Copy constructors
 Vec3::Vec3(const Vec2& vector, const float z):
-	x(vector.x),
-	y(vector.y),
-	z(z)
+	components{vector.x, vector.y, z}
 {
 }
 
 Vec3::Vec3(const Vec4& vector):
-	x(vector.x),
-	y(vector.y),
-	z(vector.z)
+	components{vector.x, vector.y, vector.z}
 {
 }
 
 Vec3::Vec3(const Color3& color):
-	x(color.r),
-	y(color.g),
-	z(color.b)
+	components{color.r, color.g, color.b}
 {
 }
 
 Vec3::Vec3(const Vector3& vector):
-	x(vector.x),
-	y(vector.y),
-	z(vector.z)
+	components{vector.x, vector.y, vector.z}
 {
 }
 
@@ -334,41 +285,6 @@ Vec3::operator Vector3() const
 	return {x, y, z};
 }
 
-// Access operators
-float& Vec3::operator[](const std::size_t index)
-{
-	assert(index <= 2);
-	switch (index)
-	{
-		case 0:
-			return x;
-		case 1:
-			return y;
-		case 2:
-			return z;
-		default:
-			break;
-	}
-	return x;
-}
-
-float Vec3::operator[](const std::size_t index) const
-{
-	assert(index <= 2);
-	switch (index)
-	{
-		case 0:
-			return x;
-		case 1:
-			return y;
-		case 2:
-			return z;
-		default:
-			break;
-	}
-	return x;
-}
-
 // Compound assignment operators
 Vec3& Vec3::operator+=(const Vec3& vector) noexcept
 {
@@ -546,6 +462,15 @@ Vec3 Vec3::Normalized() const
 	return {};
 }
 
+Vec3 Vec3::NormalizedFast() const
+{
+	if (const float lenSq = LengthSqr(); lenSq > 1e-12f)
+	{
+		return *this * FastRsqrt(lenSq);
+	}
+	return {};
+}
+
 Vec3 Vec3::Lerp(const Vec3& target, const float amount) const
 {
 	return *this + (target - *this) * amount;
@@ -599,51 +524,33 @@ Vec3 Vec3::Reflect(const Vec3& normal) const
 
 // Parametrized constructors
 Vec4::Vec4(const float x, const float y, const float z, const float w):
-	x(x),
-	y(y),
-	z(z),
-	w(w)
+	components{x, y, z, w}
 {
 }
 
 Vec4::Vec4(const float value):
-	x(value),
-	y(value),
-	z(value),
-	w(value)
+	components{value, value, value, value}
 {
 }
 
 // Copy constructors
 Vec4::Vec4(const Vec2& vector, const float z, const float w):
-	x(vector.x),
-	y(vector.y),
-	z(z),
-	w(w)
+	components{vector.x, vector.y, z, w}
 {
 }
 
 Vec4::Vec4(const Vec3& vector, const float w):
-	x(vector.x),
-	y(vector.y),
-	z(vector.z),
-	w(w)
+	components{vector.x, vector.y, vector.z, w}
 {
 }
 
 Vec4::Vec4(const Color4& color):
-	x(color.r),
-	y(color.g),
-	z(color.b),
-	w(color.a)
+	components{color.r, color.g, color.b, color.a}
 {
 }
 
 Vec4::Vec4(const Vector4& vector):
-	x(vector.x),
-	y(vector.y),
-	z(vector.z),
-	w(vector.w)
+	components{vector.x, vector.y, vector.z, vector.w}
 {
 }
 
@@ -658,45 +565,6 @@ Vec4::operator ImVec4() const
 	return {x, y, z, w};
 }
 
-// Access operators
-float& Vec4::operator[](const std::size_t index)
-{
-	assert(index <= 3);
-	switch (index)
-	{
-		case 0:
-			return x;
-		case 1:
-			return y;
-		case 2:
-			return z;
-		case 3:
-			return w;
-		default:
-			break;
-	}
-	return x;
-}
-
-float Vec4::operator[](const std::size_t index) const
-{
-	assert(index <= 3);
-	switch (index)
-	{
-		case 0:
-			return x;
-		case 1:
-			return y;
-		case 2:
-			return z;
-		case 3:
-			return w;
-		default:
-			break;
-	}
-	return x;
-}
-
 // Compound assignment operators
 Vec4& Vec4::operator+=(const Vec4& vector) noexcept
 {